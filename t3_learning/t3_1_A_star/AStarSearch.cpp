@@ -7,6 +7,12 @@
 
 #include "AStarSearch.h"
 
+#include "PathEncoder.h"
+#include "SearchTrace.h"
+
+// Nodes allocated at a time
+static const int NODE_BLOCK = 1024;
+
 AStarSearch::Node::Node() :
 		parent(0), child(0), g(0.0f), h(0.0f), f(0.0f) {
 }
@@ -17,17 +23,52 @@ bool AStarSearch::HeapCompare_f::operator ()(const Node* x,
 }
 
 AStarSearch::AStarSearch() :
-		m_State(SEARCH_STATE_NOT_INITIALISED), m_Steps(0), m_Start(0), m_Goal(
-		NULL), m_CurrentSolutionNode( NULL) {
+		m_PoolUsed(0), m_State(SEARCH_STATE_NOT_INITIALISED), m_Steps(0),
+		m_AllocatedNodes(0), m_NodeBudget(0), m_Recorder(NULL), m_Start(0),
+		m_Goal(NULL), m_CurrentSolutionNode( NULL) {
+}
+
+AStarSearch::~AStarSearch() {
+	for (unsigned int i = 0; i < m_NodeBlocks.size(); i++) {
+		delete[] m_NodeBlocks[i];
+	}
+}
+
+void AStarSearch::SetNodeBudget(int nodes) {
+	m_NodeBudget = nodes;
+}
+
+void AStarSearch::SetTraceRecorder(SearchTraceRecorder *recorder) {
+	m_Recorder = recorder;
 }
 
 void AStarSearch::SetStartAndGoalStates(MapSearchNode &Start,
-		MapSearchNode &Goal) {
+		MapSearchNode &Goal, const MapSearchNode::Rules &rules) {
+	m_Rules = rules;
+
+	if (m_Recorder) {
+		m_Recorder->BeginSearch(Start, Goal);
+	}
+
+	if (m_AllocatedNodes == 0) {
+		RewindPool();
+	}
 
 	m_Start = AllocateNode();
 	m_Goal = AllocateNode();
 
-	assert((m_Start != NULL && m_Goal != NULL));
+	// Only possible with a node budget below two
+	if (m_Start == NULL || m_Goal == NULL) {
+		FreeNode(m_Start);
+		FreeNode(m_Goal);
+		m_Start = m_Goal = NULL;
+		m_State = SEARCH_STATE_OUT_OF_MEMORY;
+
+		if (m_Recorder) {
+			m_Recorder->EndSearch(m_State, FLT_MAX, 0);
+		}
+		return;
+	}
 
 	m_Start->m_StateNode = Start;
 	m_Goal->m_StateNode = Goal;
@@ -38,7 +79,8 @@ void AStarSearch::SetStartAndGoalStates(MapSearchNode &Start,
 	// The user only needs fill out the state information
 
 	m_Start->g = 0;
-	m_Start->h = m_Start->m_StateNode.GoalDistanceEstimate(m_Goal->m_StateNode);
+	m_Start->h = m_Start->m_StateNode.GoalDistanceEstimate(m_Goal->m_StateNode,
+			m_Rules);
 	m_Start->f = m_Start->g + m_Start->h;
 	m_Start->parent = 0;
 
@@ -61,7 +103,8 @@ unsigned int AStarSearch::SearchStep() {
 
 	// Next I want it to be safe to do a searchstep once the search has succeeded...
 	if ((m_State == SEARCH_STATE_SUCCEEDED)
-			|| (m_State == SEARCH_STATE_FAILED)) {
+			|| (m_State == SEARCH_STATE_FAILED)
+			|| (m_State == SEARCH_STATE_OUT_OF_MEMORY)) {
 		return m_State;
 	}
 
@@ -70,6 +113,10 @@ unsigned int AStarSearch::SearchStep() {
 	if (m_OpenList.empty()) {
 		FreeAllNodes();
 		m_State = SEARCH_STATE_FAILED;
+
+		if (m_Recorder) {
+			m_Recorder->EndSearch(m_State, FLT_MAX, m_Steps);
+		}
 		return m_State;
 	}
 
@@ -83,6 +130,12 @@ unsigned int AStarSearch::SearchStep() {
 
 	// Check for the goal, once we pop that we're done
 	if (n->m_StateNode.IsGoal(m_Goal->m_StateNode)) {
+		if (m_Recorder) {
+			m_Recorder->RecordStep(n->m_StateNode, n->g, n->h,
+					std::vector<int>(), std::vector<int>(), m_OpenList.size());
+			m_Recorder->EndSearch(SEARCH_STATE_SUCCEEDED, n->g, m_Steps);
+		}
+
 		// The user is going to use the Goal Node he passed in
 		// so copy the parent pointer of n
 		m_Goal->parent = n->parent;
@@ -124,16 +177,23 @@ unsigned int AStarSearch::SearchStep() {
 
 		// User provides this functions and uses AddSuccessor to add each successor of
 		// node 'n' to m_Successors
-		std::vector<int> x, y;
 		bool ret = n->m_StateNode.GetSuccessors(
-				n->parent ? &n->parent->m_StateNode : NULL, x, y);
+				n->parent ? &n->parent->m_StateNode : NULL, m_SuccessorX,
+				m_SuccessorY, m_Rules);
 
-		for (unsigned int i = 0; i < x.size(); i++) {
-			MapSearchNode newNode(x[i], y[i]);
-			AddSuccessor(newNode);
+		// AddSuccessor fails once the node budget is used up
+		for (unsigned int i = 0; ret && i < m_SuccessorX.size(); i++) {
+			MapSearchNode newNode(m_SuccessorX[i], m_SuccessorY[i]);
+			ret = AddSuccessor(newNode);
 		}
 
 		if (!ret) {
+			if (m_Recorder) {
+				m_Recorder->RecordStep(n->m_StateNode, n->g, n->h,
+						m_SuccessorX, m_SuccessorY, m_OpenList.size());
+				m_Recorder->EndSearch(SEARCH_STATE_OUT_OF_MEMORY, FLT_MAX,
+						m_Steps);
+			}
 
 			NodeIt successor;
 
@@ -145,6 +205,9 @@ unsigned int AStarSearch::SearchStep() {
 
 			m_Successors.clear(); // empty vector of successor nodes to n
 
+			// n is on neither list any more
+			FreeNode(n);
+
 			// free up everything else we allocated
 			FreeAllNodes();
 
@@ -158,7 +221,8 @@ unsigned int AStarSearch::SearchStep() {
 
 			// 	The g value for this successor ...
 			float newg = n->g
-					+ n->m_StateNode.GetCost((*successor)->m_StateNode);
+					+ n->m_StateNode.GetCost((*successor)->m_StateNode,
+							m_Rules);
 
 			// Now we need to find whether the node is on the open or closed lists
 			// If it is but the node that is already on them is better (lower g)
@@ -211,34 +275,33 @@ unsigned int AStarSearch::SearchStep() {
 				}
 			}
 
-			// This node is the best node so far with this particular state
-			// so lets keep it and set up its AStar specific data ...
-
-			(*successor)->parent = n;
-			(*successor)->g = newg;
-			(*successor)->h = (*successor)->m_StateNode.GoalDistanceEstimate(
-					m_Goal->m_StateNode);
-			(*successor)->f = (*successor)->g + (*successor)->h;
-
-			// Remove successor from closed if it was on it
+			// If this state is already on a list, reuse that node rather than
+			// the new one: nodes expanded from it have it as their parent
 
 			if (closedlist_result != m_ClosedList.end()) {
 				// remove it from Closed
-				FreeNode((*closedlist_result));
+				FreeNode((*successor));
+				(*successor) = (*closedlist_result);
 				m_ClosedList.erase(closedlist_result);
-			}
-
-			// Update old version of this node
-			if (openlist_result != m_OpenList.end()) {
-
-				FreeNode((*openlist_result));
+			} else if (openlist_result != m_OpenList.end()) {
+				// Update old version of this node
+				FreeNode((*successor));
+				(*successor) = (*openlist_result);
 				m_OpenList.erase(openlist_result);
 
 				make_heap(m_OpenList.begin(), m_OpenList.end(),
 						HeapCompare_f());
-
 			}
 
+			// This node is the best node so far with this particular state
+			// so lets keep it and set up its AStar specific data ...
+
+			(*successor)->parent = n;
+			(*successor)->g = newg;
+			(*successor)->h = (*successor)->m_StateNode.GoalDistanceEstimate(
+					m_Goal->m_StateNode, m_Rules);
+			(*successor)->f = (*successor)->g + (*successor)->h;
+
 			// heap now unsorted
 			m_OpenList.push_back((*successor));
 
@@ -251,6 +314,11 @@ unsigned int AStarSearch::SearchStep() {
 
 		m_ClosedList.push_back(n);
 
+		if (m_Recorder) {
+			m_Recorder->RecordStep(n->m_StateNode, n->g, n->h, m_SuccessorX,
+					m_SuccessorY, m_OpenList.size());
+		}
+
 	}
 
 	return m_State; // Succeeded bool is false at this point.
@@ -295,6 +363,24 @@ void AStarSearch::FreeSolutionNodes() {
 
 }
 
+int AStarSearch::WriteSolution(unsigned char *buffer, int size) {
+	assert(m_State == SEARCH_STATE_SUCCEEDED && m_Start);
+
+	PathEncoder encoder(buffer, size);
+	for (Node *n = m_Start; n; n = n->child) {
+		encoder.Add(n->m_StateNode);
+	}
+
+	int length = encoder.Finish();
+	if (length > size) {
+		return length;
+	}
+
+	FreeSolutionNodes();
+	m_Start = m_Goal = m_CurrentSolutionNode = NULL;
+	return length;
+}
+
 MapSearchNode *AStarSearch::GetSolutionStart() {
 	m_CurrentSolutionNode = m_Start;
 	if (m_Start) {
@@ -351,32 +437,49 @@ float AStarSearch::GetSolutionCost() {
 	}
 }
 
+void AStarSearch::GetBestPartialPath(std::vector<MapSearchNode> &path) {
+	path.clear();
+
+	if (m_State == SEARCH_STATE_SUCCEEDED) {
+		// A start that is the goal has no child and is the whole path
+		for (Node *n = m_Start; n; n = n->child) {
+			path.push_back(n->m_StateNode);
+		}
+	} else if (m_State == SEARCH_STATE_SEARCHING && !m_OpenList.empty()) {
+		for (Node *n = m_OpenList.front(); n; n = n->parent) {
+			path.push_back(n->m_StateNode);
+		}
+		reverse(path.begin(), path.end());
+	}
+}
+
 int AStarSearch::GetStepCount() {
 	return m_Steps;
 }
 
-void AStarSearch::FreeAllNodes() {
-	// iterate open list and delete all nodes
-	NodeIt iterOpen = m_OpenList.begin();
-
-	while (iterOpen != m_OpenList.end()) {
-		Node *n = (*iterOpen);
-		FreeNode(n);
-
-		iterOpen++;
-	}
+int AStarSearch::GetNodeCount() {
+	return m_AllocatedNodes;
+}
 
+void AStarSearch::Reset() {
 	m_OpenList.clear();
+	m_ClosedList.clear();
+	m_Successors.clear();
 
-	// iterate closed list and delete unused nodes
-	NodeIt iterClosed;
+	m_AllocatedNodes = 0;
+	RewindPool();
 
-	for (iterClosed = m_ClosedList.begin(); iterClosed != m_ClosedList.end();
-			iterClosed++) {
-		Node *n = (*iterClosed);
-		FreeNode(n);
-	}
+	m_Start = m_Goal = m_CurrentSolutionNode = NULL;
+	m_State = SEARCH_STATE_NOT_INITIALISED;
+	m_Steps = 0;
+}
+
+// The nodes on the lists are not handed back one by one: they stay in the
+// pool, unused, until it is rewound
 
+void AStarSearch::FreeAllNodes() {
+	m_AllocatedNodes -= m_OpenList.size() + m_ClosedList.size();
+	m_OpenList.clear();
 	m_ClosedList.clear();
 
 	// delete the goal
@@ -385,45 +488,50 @@ void AStarSearch::FreeAllNodes() {
 }
 
 void AStarSearch::FreeUnusedNodes() {
-	// iterate open list and delete unused nodes
-	NodeIt iterOpen = m_OpenList.begin();
-
-	while (iterOpen != m_OpenList.end()) {
-		Node *n = (*iterOpen);
-
-		if (!n->child) {
-			FreeNode(n);
-
-			n = NULL;
+	// The solution's nodes but the goal are on the closed list, unless the
+	// start was the goal
+	int kept = 0;
+	if (m_Start->child) {
+		for (Node *n = m_Start; n != m_Goal; n = n->child) {
+			kept++;
 		}
-
-		iterOpen++;
 	}
 
+	m_AllocatedNodes -= m_OpenList.size() + m_ClosedList.size() - kept;
 	m_OpenList.clear();
+	m_ClosedList.clear();
+}
 
-	// iterate closed list and delete unused nodes
-	NodeIt iterClosed;
-
-	for (iterClosed = m_ClosedList.begin(); iterClosed != m_ClosedList.end();
-			iterClosed++) {
-		Node *n = (*iterClosed);
-
-		if (!n->child) {
-			FreeNode(n);
-			n = NULL;
+AStarSearch::Node *AStarSearch::AllocateNode() {
+	if (m_NodeBudget > 0 && m_AllocatedNodes >= m_NodeBudget) {
+		return NULL;
+	}
 
+	Node *p;
+	if (!m_FreeNodes.empty()) {
+		p = m_FreeNodes.back();
+		m_FreeNodes.pop_back();
+	} else {
+		if (m_PoolUsed == (int) m_NodeBlocks.size() * NODE_BLOCK) {
+			m_NodeBlocks.push_back(new Node[NODE_BLOCK]);
 		}
+		p = &m_NodeBlocks[m_PoolUsed / NODE_BLOCK][m_PoolUsed % NODE_BLOCK];
+		m_PoolUsed++;
 	}
 
-	m_ClosedList.clear();
-}
-
-AStarSearch::Node *AStarSearch::AllocateNode() {
-	Node *p = new Node;
+	*p = Node();
+	m_AllocatedNodes++;
 	return p;
 }
 
 void AStarSearch::FreeNode(Node *node) {
-	delete node;
+	if (node) {
+		m_AllocatedNodes--;
+		m_FreeNodes.push_back(node);
+	}
+}
+
+void AStarSearch::RewindPool() {
+	m_PoolUsed = 0;
+	m_FreeNodes.clear();
 }
@@ -21,6 +21,8 @@ using namespace std;
 
 #include "MapSearchNode.h"
 
+class SearchTraceRecorder;
+
 class AStarSearch {
 
 public:
@@ -67,9 +69,29 @@ public:
 public:
 
 	AStarSearch();
+	~AStarSearch();
+
+	// The search owns its node pool, so it cannot be copied
+	AStarSearch(const AStarSearch &) = delete;
+	AStarSearch &operator=(const AStarSearch &) = delete;
+
+	// Limits the number of nodes alive at once. The search reports
+	// SEARCH_STATE_OUT_OF_MEMORY once it needs more. 0 means no limit
+	void SetNodeBudget(int nodes);
+
+	// Records every step of the following searches, NULL to stop
+	void SetTraceRecorder(SearchTraceRecorder *recorder);
 
-	// Set Start and goal states
-	void SetStartAndGoalStates(MapSearchNode &Start, MapSearchNode &Goal);
+	// Set Start and goal states, and the rules to move by, the defaults as
+	// they are now unless given. Once every node of the last search has
+	// been freed the node pool is rewound, so a search object kept for many
+	// queries reuses the nodes and list capacity of the earlier ones
+	void SetStartAndGoalStates(MapSearchNode &Start, MapSearchNode &Goal,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Drops the last search and its solution at once, in place of
+	// FreeSolutionNodes, keeping the nodes and list capacity for the next
+	void Reset();
 
 	// Advances search one step
 	unsigned int SearchStep();
@@ -83,6 +105,12 @@ public:
 	// search
 	void FreeSolutionNodes();
 
+	// Writes the solution into a buffer owned by the caller, in the
+	// PathEncoder format, and frees the solution nodes, so read the cost
+	// first. Returns the bytes written, or if they do not fit the size
+	// needed, in which case nothing is freed and it can be called again
+	int WriteSolution(unsigned char *buffer, int size);
+
 	// Functions for traversing the solution
 
 	// Get start node
@@ -101,9 +129,16 @@ public:
 	// Returns FLT_MAX if goal is not defined or there is no solution
 	float GetSolutionCost();
 
+	// Path to the open node with the lowest f, start first. Once the search
+	// has succeeded it is the solution, if it failed it is empty
+	void GetBestPartialPath(std::vector<MapSearchNode> &path);
+
 	// Get the number of steps
 	int GetStepCount();
 
+	// Get the number of nodes currently allocated
+	int GetNodeCount();
+
 private:
 	// methods
 
@@ -116,11 +151,15 @@ private:
 	// routine once the search ends
 	void FreeUnusedNodes();
 
-	// Node memory management
+	// Node memory management. Nodes come from blocks kept for the life of
+	// the search object, freed nodes go on a free list for reuse
 	Node *AllocateNode();
 
 	void FreeNode(Node *node);
 
+	// Hands out the blocks from the start again, dropping the free list
+	void RewindPool();
+
 private:
 
 	vector<Node *> m_OpenList;
@@ -132,12 +171,29 @@ private:
 	// are generated
 	vector<Node *> m_Successors;
 
+	// Coordinates of the successors of the node being expanded
+	vector<int> m_SuccessorX;
+	vector<int> m_SuccessorY;
+
+	// Node blocks, the nodes handed out of them and the free ones
+	vector<Node *> m_NodeBlocks;
+	int m_PoolUsed;
+	vector<Node *> m_FreeNodes;
+
 	// State
 	unsigned int m_State;
 
 	// Counts steps
 	int m_Steps;
 
+	// Nodes currently allocated and the most allowed, 0 for no limit
+	int m_AllocatedNodes;
+	int m_NodeBudget;
+
+	SearchTraceRecorder *m_Recorder;
+
+	MapSearchNode::Rules m_Rules;
+
 	// Start and goal state pointers
 	Node *m_Start;
 	Node *m_Goal;
@@ -0,0 +1,158 @@
+/*
+ * BatchHeuristic.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "BatchHeuristic.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "MapSearchNode.h"
+
+using namespace std;
+
+// As in MapSearchNode.cpp, and computed in the same order, so the results
+// match to the bit
+static const float SQRT2 = 1.41421356f;
+
+// The whole batch, for one goal (gx[0], gy[0]) or a goal per cell
+template<bool OCTILE, bool PER_CELL>
+static void EstimateBatch(const int *x, const int *y, const int *gx,
+		const int *gy, int count, float *h) {
+	int i = 0;
+
+#if defined(__AVX2__)
+	const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+	const __m256 diagonal = _mm256_set1_ps(SQRT2 - 1.0f);
+	__m256i goalX = _mm256_set1_epi32(gx[0]);
+	__m256i goalY = _mm256_set1_epi32(gy[0]);
+
+	for (; i + 8 <= count; i += 8) {
+		if (PER_CELL) {
+			goalX = _mm256_loadu_si256((const __m256i*) (gx + i));
+			goalY = _mm256_loadu_si256((const __m256i*) (gy + i));
+		}
+
+		__m256 dx = _mm256_and_ps(absMask,
+				_mm256_cvtepi32_ps(
+						_mm256_sub_epi32(
+								_mm256_loadu_si256((const __m256i*) (x + i)),
+								goalX)));
+		__m256 dy = _mm256_and_ps(absMask,
+				_mm256_cvtepi32_ps(
+						_mm256_sub_epi32(
+								_mm256_loadu_si256((const __m256i*) (y + i)),
+								goalY)));
+
+		__m256 r;
+		if (OCTILE) {
+			r = _mm256_add_ps(_mm256_max_ps(dx, dy),
+					_mm256_mul_ps(diagonal, _mm256_min_ps(dx, dy)));
+		} else {
+			r = _mm256_add_ps(dx, dy);
+		}
+		_mm256_storeu_ps(h + i, r);
+	}
+#elif defined(__SSE2__)
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	const __m128 diagonal = _mm_set1_ps(SQRT2 - 1.0f);
+	__m128i goalX = _mm_set1_epi32(gx[0]);
+	__m128i goalY = _mm_set1_epi32(gy[0]);
+
+	for (; i + 4 <= count; i += 4) {
+		if (PER_CELL) {
+			goalX = _mm_loadu_si128((const __m128i*) (gx + i));
+			goalY = _mm_loadu_si128((const __m128i*) (gy + i));
+		}
+
+		__m128 dx = _mm_and_ps(absMask,
+				_mm_cvtepi32_ps(
+						_mm_sub_epi32(_mm_loadu_si128((const __m128i*) (x + i)),
+								goalX)));
+		__m128 dy = _mm_and_ps(absMask,
+				_mm_cvtepi32_ps(
+						_mm_sub_epi32(_mm_loadu_si128((const __m128i*) (y + i)),
+								goalY)));
+
+		__m128 r;
+		if (OCTILE) {
+			r = _mm_add_ps(_mm_max_ps(dx, dy),
+					_mm_mul_ps(diagonal, _mm_min_ps(dx, dy)));
+		} else {
+			r = _mm_add_ps(dx, dy);
+		}
+		_mm_storeu_ps(h + i, r);
+	}
+#endif
+
+	// What is left over, exactly as GoalDistanceEstimate does it
+	for (; i < count; i++) {
+		float dx = fabsf(x[i] - gx[PER_CELL ? i : 0]);
+		float dy = fabsf(y[i] - gy[PER_CELL ? i : 0]);
+
+		if (OCTILE) {
+			h[i] = max(dx, dy) + (SQRT2 - 1.0f) * min(dx, dy);
+		} else {
+			h[i] = dx + dy;
+		}
+	}
+}
+
+void BatchHeuristic::Estimate(const int *x, const int *y, int count,
+		int goalX, int goalY, float *h, const MapSearchNode::Rules &rules) {
+	if (rules.connectivity == MapSearchNode::CONNECT_8) {
+		Octile(x, y, count, goalX, goalY, h);
+	} else {
+		Manhattan(x, y, count, goalX, goalY, h);
+	}
+}
+
+void BatchHeuristic::Estimate(const int *x, const int *y, const int *goalX,
+		const int *goalY, int count, float *h,
+		const MapSearchNode::Rules &rules) {
+	if (rules.connectivity == MapSearchNode::CONNECT_8) {
+		Octile(x, y, goalX, goalY, count, h);
+	} else {
+		Manhattan(x, y, goalX, goalY, count, h);
+	}
+}
+
+void BatchHeuristic::Manhattan(const int *x, const int *y, int count,
+		int goalX, int goalY, float *h) {
+	EstimateBatch<false, false>(x, y, &goalX, &goalY, count, h);
+}
+
+void BatchHeuristic::Octile(const int *x, const int *y, int count, int goalX,
+		int goalY, float *h) {
+	EstimateBatch<true, false>(x, y, &goalX, &goalY, count, h);
+}
+
+void BatchHeuristic::Manhattan(const int *x, const int *y, const int *goalX,
+		const int *goalY, int count, float *h) {
+	EstimateBatch<false, true>(x, y, goalX, goalY, count, h);
+}
+
+void BatchHeuristic::Octile(const int *x, const int *y, const int *goalX,
+		const int *goalY, int count, float *h) {
+	EstimateBatch<true, true>(x, y, goalX, goalY, count, h);
+}
+
+const char *BatchHeuristic::GetInstructionSet() {
+#if defined(__AVX2__)
+	return "avx2";
+#elif defined(__SSE2__)
+	return "sse2";
+#else
+	return "scalar";
+#endif
+}
@@ -0,0 +1,260 @@
+/*
+ * CompactAStarSearch.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "CompactAStarSearch.h"
+
+#include "AStarSearch.h"
+#include "BatchHeuristic.h"
+#include "GoalBounds.h"
+#include "LandmarkTable.h"
+#include "Map.h"
+#include "RegionPruning.h"
+#include "SearchTrace.h"
+
+const unsigned int CompactAStarSearch::NO_NODE;
+
+bool CompactAStarSearch::HeapCompare_f::operator ()(const OpenEntry &x,
+		const OpenEntry &y) const {
+	return x.f > y.f;
+}
+
+CompactAStarSearch::CompactAStarSearch() :
+		m_Width(0), m_Pruning(NULL), m_GoalBounds(NULL), m_Landmarks(NULL),
+		m_Recorder(NULL),
+		m_State(AStarSearch::SEARCH_STATE_NOT_INITIALISED), m_Steps(0),
+		m_CurrentSolutionNode(0), m_SolutionCost(FLT_MAX) {
+}
+
+CompactAStarSearch::~CompactAStarSearch() {
+}
+
+void CompactAStarSearch::SetPruning(RegionPruning *pruning) {
+	m_Pruning = pruning;
+}
+
+void CompactAStarSearch::SetGoalBounds(GoalBounds *bounds) {
+	m_GoalBounds = bounds;
+}
+
+void CompactAStarSearch::SetLandmarks(LandmarkTable *landmarks) {
+	m_Landmarks = landmarks;
+}
+
+void CompactAStarSearch::SetTraceRecorder(SearchTraceRecorder *recorder) {
+	m_Recorder = recorder;
+}
+
+void CompactAStarSearch::SetStartAndGoalStates(MapSearchNode &Start,
+		MapSearchNode &Goal, const MapSearchNode::Rules &rules) {
+	assert(Map::GetWidth() <= 0x10000 && Map::GetHeight() <= 0x10000);
+
+	// The cell table is only cleared where the last search wrote to it, so
+	// a short search pays for the cells it reaches, not the whole map
+	unsigned int cells = Map::GetWidth() * Map::GetHeight();
+	if (m_Width != Map::GetWidth() || m_CellNode.size() != cells) {
+		m_Width = Map::GetWidth();
+		m_CellNode.assign(cells, NO_NODE);
+	} else {
+		for (unsigned int i = 0; i < m_Nodes.size(); i++) {
+			unsigned int coords = m_Nodes[i].coords;
+			m_CellNode[(coords >> 16) * m_Width + (coords & 0xffff)] = NO_NODE;
+		}
+	}
+	m_Nodes.clear();
+	m_OpenList.clear();
+	m_Solution.clear();
+	m_SolutionCost = FLT_MAX;
+	m_Rules = rules;
+	m_Goal = Goal;
+	m_Steps = 0;
+
+	// Off the map there is no cell to hold the start, nor any way to the goal
+	if (!Start.IsOnMap() || !Goal.IsOnMap()) {
+		m_State = AStarSearch::SEARCH_STATE_FAILED;
+		return;
+	}
+
+	if (m_Pruning) {
+		m_Pruning->Prepare(Start, Goal);
+	}
+	if (m_Recorder) {
+		m_Recorder->BeginSearch(Start, Goal);
+	}
+
+	float h;
+	Estimate(&Start.x, &Start.y, 1, &h);
+	unsigned int start = AllocateNode(Start.x, Start.y, NO_NODE, 0.0f, h);
+	m_CellNode[Start.y * m_Width + Start.x] = start;
+	PushOpen(start);
+
+	m_State = AStarSearch::SEARCH_STATE_SEARCHING;
+}
+
+unsigned int CompactAStarSearch::SearchStep() {
+	assert(
+			(m_State > AStarSearch::SEARCH_STATE_NOT_INITIALISED)
+					&& (m_State < AStarSearch::SEARCH_STATE_INVALID));
+
+	if (m_State != AStarSearch::SEARCH_STATE_SEARCHING) {
+		return m_State;
+	}
+
+	// Skip entries for nodes that have been reached more cheaply since
+	OpenEntry best;
+	do {
+		if (m_OpenList.empty()) {
+			m_State = AStarSearch::SEARCH_STATE_FAILED;
+
+			if (m_Recorder) {
+				m_Recorder->EndSearch(m_State, FLT_MAX, m_Steps);
+			}
+			return m_State;
+		}
+
+		best = m_OpenList.front();
+		pop_heap(m_OpenList.begin(), m_OpenList.end(), HeapCompare_f());
+		m_OpenList.pop_back();
+	} while (best.f > m_Nodes[best.node].g + m_Nodes[best.node].h);
+
+	m_Steps++;
+
+	// Copy, the pool may grow while we expand
+	Node n = m_Nodes[best.node];
+	MapSearchNode state(n.coords & 0xffff, n.coords >> 16);
+
+	if (state.IsGoal(m_Goal)) {
+		for (unsigned int i = best.node; i != NO_NODE;
+				i = m_Nodes[i].parent) {
+			unsigned int coords = m_Nodes[i].coords;
+			m_Solution.push_back(
+					MapSearchNode(coords & 0xffff, coords >> 16));
+		}
+		reverse(m_Solution.begin(), m_Solution.end());
+		m_SolutionCost = n.g;
+
+		m_State = AStarSearch::SEARCH_STATE_SUCCEEDED;
+
+		if (m_Recorder) {
+			m_Recorder->RecordStep(state, n.g, n.h, std::vector<int>(),
+					std::vector<int>(), m_OpenList.size());
+			m_Recorder->EndSearch(m_State, n.g, m_Steps);
+		}
+		return m_State;
+	}
+
+	MapSearchNode parent;
+	if (n.parent != NO_NODE) {
+		unsigned int coords = m_Nodes[n.parent].coords;
+		parent = MapSearchNode(coords & 0xffff, coords >> 16);
+	}
+
+	state.GetSuccessors(n.parent != NO_NODE ? &parent : NULL, m_SuccessorX,
+			m_SuccessorY, m_Rules);
+
+	// Every successor's heuristic in one batch, used for the new nodes
+	m_SuccessorH.resize(m_SuccessorX.size());
+	Estimate(m_SuccessorX.data(), m_SuccessorY.data(), m_SuccessorX.size(),
+			m_SuccessorH.data());
+
+	for (unsigned int i = 0; i < m_SuccessorX.size(); i++) {
+		MapSearchNode successor(m_SuccessorX[i], m_SuccessorY[i]);
+		if (m_Pruning && !m_Pruning->IsAllowed(successor.x, successor.y)) {
+			continue;
+		}
+		if (m_GoalBounds
+				&& !m_GoalBounds->IsAllowed(state.x, state.y, successor.x,
+						successor.y, m_Goal)) {
+			continue;
+		}
+
+		float newg = n.g + state.GetCost(successor, m_Rules);
+		unsigned int &cellNode = m_CellNode[successor.y * m_Width
+				+ successor.x];
+
+		if (cellNode == NO_NODE) {
+			cellNode = AllocateNode(successor.x, successor.y, best.node, newg,
+					m_SuccessorH[i]);
+			PushOpen(cellNode);
+			continue;
+		}
+
+		// Open or closed, the one we have is cheaper
+		if (m_Nodes[cellNode].g <= newg) {
+			continue;
+		}
+
+		// Reached more cheaply: update in place and (re)open it, the old
+		// open entry if any goes stale
+		m_Nodes[cellNode].g = newg;
+		m_Nodes[cellNode].parent = best.node;
+		PushOpen(cellNode);
+	}
+
+	if (m_Recorder) {
+		m_Recorder->RecordStep(state, n.g, n.h, m_SuccessorX, m_SuccessorY,
+				m_OpenList.size());
+	}
+
+	return m_State;
+}
+
+unsigned int CompactAStarSearch::AllocateNode(int x, int y,
+		unsigned int parent, float g, float h) {
+	Node node;
+	node.parent = parent;
+	node.coords = (unsigned int) x | ((unsigned int) y << 16);
+	node.g = g;
+	node.h = h;
+
+	m_Nodes.push_back(node);
+	return m_Nodes.size() - 1;
+}
+
+void CompactAStarSearch::Estimate(const int *x, const int *y, int count,
+		float *h) {
+	BatchHeuristic::Estimate(x, y, count, m_Goal.x, m_Goal.y, h, m_Rules);
+
+	if (m_Landmarks) {
+		m_Landmarks->Raise(x, y, count, m_Goal, h);
+	}
+}
+
+void CompactAStarSearch::PushOpen(unsigned int node) {
+	OpenEntry entry;
+	entry.f = m_Nodes[node].g + m_Nodes[node].h;
+	entry.node = node;
+
+	m_OpenList.push_back(entry);
+	push_heap(m_OpenList.begin(), m_OpenList.end(), HeapCompare_f());
+}
+
+MapSearchNode *CompactAStarSearch::GetSolutionStart() {
+	m_CurrentSolutionNode = 0;
+	if (m_Solution.empty()) {
+		return NULL;
+	}
+	return &m_Solution[0];
+}
+
+MapSearchNode *CompactAStarSearch::GetSolutionNext() {
+	if (m_CurrentSolutionNode + 1 >= m_Solution.size()) {
+		return NULL;
+	}
+	return &m_Solution[++m_CurrentSolutionNode];
+}
+
+float CompactAStarSearch::GetSolutionCost() {
+	return m_SolutionCost;
+}
+
+int CompactAStarSearch::GetStepCount() {
+	return m_Steps;
+}
+
+int CompactAStarSearch::GetNodeCount() {
+	return m_Nodes.size();
+}
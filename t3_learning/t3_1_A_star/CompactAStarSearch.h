@@ -0,0 +1,128 @@
+/*
+ * CompactAStarSearch.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef COMPACTASTARSEARCH_H_
+#define COMPACTASTARSEARCH_H_
+
+#include <vector>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+class GoalBounds;
+class LandmarkTable;
+class RegionPruning;
+class SearchTraceRecorder;
+
+// A* over the same MapSearchNode callbacks as AStarSearch, with a 16 byte
+// node instead of 40. Nodes live in one pool and refer to each other by 32
+// bit index, the coordinates are packed into one word, f is recomputed from
+// g + h and there is no child link: the solution is copied out once found.
+// A dense cell -> node table replaces the open and closed list scans.
+//
+// Uses the AStarSearch::SEARCH_STATE_* values. Maps up to 65536 cells wide.
+
+class CompactAStarSearch {
+public:
+	static const unsigned int NO_NODE = 0xffffffffu;
+
+	class Node {
+	public:
+		unsigned int parent; // pool index of the parent, NO_NODE for the start
+		unsigned int coords; // x in the low 16 bits, y in the high 16 bits
+		float g; // cost of this node + it's predecessors
+		float h; // heuristic estimate of distance to goal
+	};
+
+	CompactAStarSearch();
+	virtual ~CompactAStarSearch();
+
+	// Skip the cells the pruning rules out for each search, NULL for none.
+	// The pruning must have been built for the search's map and rules
+	void SetPruning(RegionPruning *pruning);
+
+	// Skip the moves the goal bounds rule out, NULL for none. The bounds
+	// must have been built for the search's map and rules
+	void SetGoalBounds(GoalBounds *bounds);
+
+	// Raise the heuristic to the landmark bound, NULL for none. The table
+	// must have been built for the search's map and rules
+	void SetLandmarks(LandmarkTable *landmarks);
+
+	// Records every step of the following searches, NULL to stop
+	void SetTraceRecorder(SearchTraceRecorder *recorder);
+
+	// Set Start and goal states, and the rules to move by, the defaults as
+	// they are now unless given
+	void SetStartAndGoalStates(MapSearchNode &Start, MapSearchNode &Goal,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Advances search one step
+	unsigned int SearchStep();
+
+	// Functions for traversing the solution
+	MapSearchNode *GetSolutionStart();
+	MapSearchNode *GetSolutionNext();
+
+	// Get final cost of solution
+	// Returns FLT_MAX if there is no solution
+	float GetSolutionCost();
+
+	// Get the number of steps
+	int GetStepCount();
+
+	// Nodes allocated from the pool by this search
+	int GetNodeCount();
+
+private:
+	// Open list entries carry f so the heap never touches the pool. An entry
+	// whose f no longer matches its node has been superseded
+	struct OpenEntry {
+		float f;
+		unsigned int node;
+	};
+
+	class HeapCompare_f {
+	public:
+		bool operator()(const OpenEntry &x, const OpenEntry &y) const;
+	};
+
+	unsigned int AllocateNode(int x, int y, unsigned int parent, float g,
+			float h);
+
+	// Heuristics of a batch of cells, landmark bound included
+	void Estimate(const int *x, const int *y, int count, float *h);
+	void PushOpen(unsigned int node);
+
+private:
+	std::vector<Node> m_Nodes;
+	std::vector<OpenEntry> m_OpenList;
+
+	// Pool index of the node for each cell, NO_NODE if not reached yet
+	std::vector<unsigned int> m_CellNode;
+	int m_Width;
+
+	RegionPruning *m_Pruning;
+	GoalBounds *m_GoalBounds;
+	LandmarkTable *m_Landmarks;
+	SearchTraceRecorder *m_Recorder;
+
+	MapSearchNode::Rules m_Rules;
+	MapSearchNode m_Goal;
+	unsigned int m_State;
+	int m_Steps;
+
+	std::vector<MapSearchNode> m_Solution;
+	unsigned int m_CurrentSolutionNode;
+	float m_SolutionCost;
+
+	std::vector<int> m_SuccessorX;
+	std::vector<int> m_SuccessorY;
+	std::vector<float> m_SuccessorH;
+};
+
+#endif /* COMPACTASTARSEARCH_H_ */
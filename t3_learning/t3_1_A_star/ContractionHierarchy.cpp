@@ -0,0 +1,702 @@
+/*
+ * ContractionHierarchy.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "ContractionHierarchy.h"
+
+#include "Map.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+typedef ContractionHierarchy::QueueEntry QueueEntry;
+typedef priority_queue<QueueEntry, vector<QueueEntry>,
+		greater<QueueEntry> > MinQueue;
+
+// Settled nodes allowed in a witness search, smaller while only estimating
+// the priority of a node
+const int WITNESS_SETTLE_LIMIT = 500;
+const int SIMULATE_SETTLE_LIMIT = 50;
+
+const int CH_FILE_VERSION = 1;
+
+ContractionHierarchy::ContractionHierarchy() :
+		m_Width(0), m_Height(0), m_Shortcuts(0), m_CurrentStamp(0), m_Settled(
+				0) {
+}
+
+ContractionHierarchy::~ContractionHierarchy() {
+}
+
+void ContractionHierarchy::Build(const MapSearchNode::Rules &rules) {
+	m_Width = Map::GetWidth();
+	m_Height = Map::GetHeight();
+	m_Shortcuts = 0;
+
+	// Shortcuts outlast the units on the map
+	MapSearchNode::Rules own = rules;
+	own.overlay = NULL;
+
+	// Number the cells the agent fits in
+	m_Cells.clear();
+	m_CellNode.assign(m_Width * m_Height, -1);
+	for (int y = 0; y < m_Height; y++) {
+		for (int x = 0; x < m_Width; x++) {
+			if (Map::GetClearance(x, y) >= rules.agentSize) {
+				m_CellNode[y * m_Width + x] = m_Cells.size();
+				m_Cells.push_back(y * m_Width + x);
+			}
+		}
+	}
+
+	int nodes = m_Cells.size();
+
+	m_Out.assign(nodes, vector<Edge>());
+	m_In.assign(nodes, vector<Edge>());
+	m_DeletedNeighbours.assign(nodes, 0);
+	m_WitnessDist.assign(nodes, FLT_MAX);
+	m_WitnessTouched.clear();
+
+	vector<int> x, y;
+
+	for (int v = 0; v < nodes; v++) {
+		MapSearchNode state(m_Cells[v] % m_Width, m_Cells[v] / m_Width);
+		state.GetSuccessors(NULL, x, y, own);
+
+		for (unsigned int i = 0; i < x.size(); i++) {
+			MapSearchNode successor(x[i], y[i]);
+			int w = m_CellNode[y[i] * m_Width + x[i]];
+			float cost = state.GetCost(successor, own);
+
+			AddEdge(m_Out[v], w, -1, cost);
+			AddEdge(m_In[w], v, -1, cost);
+		}
+	}
+
+	// Order the nodes by edge difference and deleted neighbours, updating the
+	// priorities lazily as they come off the queue
+	MinQueue order;
+	for (int v = 0; v < nodes; v++) {
+		order.push(QueueEntry((float) GetPriority(v), v));
+	}
+
+	vector<vector<Edge> > up(nodes);
+	vector<vector<Edge> > down(nodes);
+	vector<int> newId(nodes);
+	int rank = 0;
+
+	while (!order.empty()) {
+		int v = order.top().second;
+		order.pop();
+
+		int priority = GetPriority(v);
+
+		if (!order.empty() && priority > order.top().first) {
+			order.push(QueueEntry((float) priority, v));
+			continue;
+		}
+
+		ContractNode(v, false);
+
+		// Whatever v is still connected to is contracted later, so these
+		// become its upward edges
+		up[v].swap(m_Out[v]);
+		down[v].swap(m_In[v]);
+		newId[v] = nodes - 1 - rank++;
+	}
+
+	// Flatten into CSR, renumbering the nodes from the top of the hierarchy
+	// down so the few nodes every query reaches share the same cache lines
+	vector<int> cells(nodes);
+	vector<int> byOrder(nodes);
+	for (int v = 0; v < nodes; v++) {
+		cells[newId[v]] = m_Cells[v];
+		byOrder[newId[v]] = v;
+	}
+	m_Cells.swap(cells);
+
+	m_UpOffsets.assign(nodes + 1, 0);
+	m_DownOffsets.assign(nodes + 1, 0);
+	m_Up.clear();
+	m_Down.clear();
+
+	for (int i = 0; i < nodes; i++) {
+		int v = byOrder[i];
+
+		m_UpOffsets[i] = m_Up.size();
+		for (unsigned int j = 0; j < up[v].size(); j++) {
+			Edge e = up[v][j];
+			e.target = newId[e.target];
+			e.middle = e.middle < 0 ? -1 : newId[e.middle];
+			m_Up.push_back(e);
+		}
+
+		m_DownOffsets[i] = m_Down.size();
+		for (unsigned int j = 0; j < down[v].size(); j++) {
+			Edge e = down[v][j];
+			e.target = newId[e.target];
+			e.middle = e.middle < 0 ? -1 : newId[e.middle];
+			m_Down.push_back(e);
+		}
+	}
+	m_UpOffsets[nodes] = m_Up.size();
+	m_DownOffsets[nodes] = m_Down.size();
+
+	for (int i = 0; i < nodes; i++) {
+		m_CellNode[m_Cells[i]] = i;
+	}
+
+	m_Out.clear();
+	m_In.clear();
+	m_DeletedNeighbours.clear();
+	m_WitnessDist.clear();
+	m_WitnessTouched.clear();
+}
+
+int ContractionHierarchy::GetPriority(int v) {
+	int edgeDifference = ContractNode(v, true) - (int) m_In[v].size()
+			- (int) m_Out[v].size();
+
+	return 2 * edgeDifference + m_DeletedNeighbours[v];
+}
+
+int ContractionHierarchy::ContractNode(int v, bool simulate) {
+	int shortcuts = 0;
+
+	float maxOut = 0.0f;
+	for (unsigned int j = 0; j < m_Out[v].size(); j++) {
+		maxOut = max(maxOut, m_Out[v][j].cost);
+	}
+
+	// Copies, since adding shortcuts may touch the lists of v's neighbours
+	vector<Edge> in(m_In[v]);
+	vector<Edge> out(m_Out[v]);
+
+	for (unsigned int i = 0; i < in.size(); i++) {
+		int u = in[i].target;
+
+		WitnessSearch(u, v, in[i].cost + maxOut,
+				simulate ? SIMULATE_SETTLE_LIMIT : WITNESS_SETTLE_LIMIT);
+
+		for (unsigned int j = 0; j < out.size(); j++) {
+			int w = out[j].target;
+			float viaCost = in[i].cost + out[j].cost;
+
+			if (w == u || m_WitnessDist[w] <= viaCost) {
+				continue;
+			}
+
+			shortcuts++;
+
+			if (!simulate) {
+				AddEdge(m_Out[u], w, v, viaCost);
+				AddEdge(m_In[w], u, v, viaCost);
+			}
+		}
+	}
+
+	if (!simulate) {
+		for (unsigned int i = 0; i < in.size(); i++) {
+			RemoveEdge(m_Out[in[i].target], v);
+			m_DeletedNeighbours[in[i].target]++;
+		}
+
+		for (unsigned int j = 0; j < out.size(); j++) {
+			RemoveEdge(m_In[out[j].target], v);
+			m_DeletedNeighbours[out[j].target]++;
+		}
+
+		m_Shortcuts += shortcuts;
+	}
+
+	return shortcuts;
+}
+
+void ContractionHierarchy::WitnessSearch(int source, int skip, float maxCost,
+		int settleLimit) {
+	for (unsigned int i = 0; i < m_WitnessTouched.size(); i++) {
+		m_WitnessDist[m_WitnessTouched[i]] = FLT_MAX;
+	}
+	m_WitnessTouched.clear();
+
+	MinQueue open;
+	m_WitnessDist[source] = 0.0f;
+	m_WitnessTouched.push_back(source);
+	open.push(QueueEntry(0.0f, source));
+
+	int settled = 0;
+
+	while (!open.empty() && settled < settleLimit) {
+		float d = open.top().first;
+		int u = open.top().second;
+		open.pop();
+
+		if (d > m_WitnessDist[u]) {
+			continue;
+		}
+
+		if (d > maxCost) {
+			break;
+		}
+
+		settled++;
+
+		for (unsigned int i = 0; i < m_Out[u].size(); i++) {
+			const Edge &e = m_Out[u][i];
+			float newd = d + e.cost;
+
+			if (e.target == skip || newd >= m_WitnessDist[e.target]) {
+				continue;
+			}
+
+			if (m_WitnessDist[e.target] == FLT_MAX) {
+				m_WitnessTouched.push_back(e.target);
+			}
+
+			m_WitnessDist[e.target] = newd;
+			open.push(QueueEntry(newd, e.target));
+		}
+	}
+}
+
+void ContractionHierarchy::AddEdge(vector<Edge> &edges, int target, int middle,
+		float cost) {
+	for (unsigned int i = 0; i < edges.size(); i++) {
+		if (edges[i].target == target) {
+			if (cost < edges[i].cost) {
+				edges[i].cost = cost;
+				edges[i].middle = middle;
+			}
+			return;
+		}
+	}
+
+	Edge e;
+	e.target = target;
+	e.middle = middle;
+	e.cost = cost;
+	edges.push_back(e);
+}
+
+void ContractionHierarchy::RemoveEdge(vector<Edge> &edges, int target) {
+	for (unsigned int i = 0; i < edges.size(); i++) {
+		if (edges[i].target == target) {
+			edges[i] = edges.back();
+			edges.pop_back();
+			return;
+		}
+	}
+}
+
+// Writes and reads an int vector without its length, which the format
+// already knows from the header
+static bool WriteInts(FILE *file, const vector<int> &v) {
+	return v.empty() || fwrite(&v[0], sizeof(int), v.size(), file) == v.size();
+}
+
+// Whether count items of size bytes are left in the file, checked before
+// making room for them so a bad count cannot ask for any amount of memory
+static bool FitsInFile(FILE *file, int count, size_t size) {
+	long position = ftell(file);
+	if (position < 0 || fseek(file, 0, SEEK_END) != 0) {
+		return false;
+	}
+
+	long end = ftell(file);
+	return fseek(file, position, SEEK_SET) == 0
+			&& (unsigned long) count <= (unsigned long) (end - position) / size;
+}
+
+static bool ReadInts(FILE *file, vector<int> &v, int count) {
+	if (!FitsInFile(file, count, sizeof(int))) {
+		return false;
+	}
+
+	v.resize(count);
+	return count == 0
+			|| fread(&v[0], sizeof(int), count, file) == (size_t) count;
+}
+
+// CSR offsets must start at 0, never decrease and end at the edge count
+static bool ValidOffsets(const vector<int> &offsets, int edges) {
+	if (offsets.front() != 0 || offsets.back() != edges) {
+		return false;
+	}
+
+	for (unsigned int i = 1; i < offsets.size(); i++) {
+		if (offsets[i] < offsets[i - 1]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ContractionHierarchy::Save(const char *fileName) const {
+	FILE *file = fopen(fileName, "wb");
+
+	if (!file) {
+		return false;
+	}
+
+	int header[4] = { CH_FILE_VERSION, m_Width, m_Height,
+			(int) m_Cells.size() };
+	int upCount = m_Up.size();
+	int downCount = m_Down.size();
+
+	bool ok = fwrite("CHG1", 1, 4, file) == 4
+			&& fwrite(header, sizeof(int), 4, file) == 4
+			&& WriteInts(file, m_Cells)
+			&& WriteInts(file, m_UpOffsets)
+			&& fwrite(&upCount, sizeof(int), 1, file) == 1
+			&& (upCount == 0
+					|| fwrite(&m_Up[0], sizeof(Edge), upCount, file)
+							== (size_t) upCount)
+			&& WriteInts(file, m_DownOffsets)
+			&& fwrite(&downCount, sizeof(int), 1, file) == 1
+			&& (downCount == 0
+					|| fwrite(&m_Down[0], sizeof(Edge), downCount, file)
+							== (size_t) downCount);
+
+	return (fclose(file) == 0) && ok;
+}
+
+bool ContractionHierarchy::Load(const char *fileName) {
+	FILE *file = fopen(fileName, "rb");
+
+	if (!file) {
+		return false;
+	}
+
+	char magic[4];
+	int header[4];
+	int upCount = 0;
+	int downCount = 0;
+
+	// The hierarchy only fits the map it was built for
+	bool ok = fread(magic, 1, 4, file) == 4 && memcmp(magic, "CHG1", 4) == 0
+			&& fread(header, sizeof(int), 4, file) == 4
+			&& header[0] == CH_FILE_VERSION && header[1] == Map::GetWidth()
+			&& header[2] == Map::GetHeight() && header[3] >= 0
+			&& header[3] <= header[1] * header[2];
+
+	if (ok) {
+		int nodes = header[3];
+
+		ok = ReadInts(file, m_Cells, nodes)
+				&& ReadInts(file, m_UpOffsets, nodes + 1)
+				&& fread(&upCount, sizeof(int), 1, file) == 1 && upCount >= 0
+				&& FitsInFile(file, upCount, sizeof(Edge));
+
+		if (ok) {
+			m_Up.resize(upCount);
+			ok = (upCount == 0
+					|| fread(&m_Up[0], sizeof(Edge), upCount, file)
+							== (size_t) upCount)
+					&& ReadInts(file, m_DownOffsets, nodes + 1)
+					&& fread(&downCount, sizeof(int), 1, file) == 1
+					&& downCount >= 0
+					&& FitsInFile(file, downCount, sizeof(Edge));
+		}
+
+		if (ok) {
+			m_Down.resize(downCount);
+			ok = downCount == 0
+					|| fread(&m_Down[0], sizeof(Edge), downCount, file)
+							== (size_t) downCount;
+		}
+	}
+
+	fclose(file);
+
+	// Every cell on the map and numbered once, so the node ids can be
+	// trusted by the edge checks
+	if (ok) {
+		m_Width = header[1];
+		m_Height = header[2];
+		m_CellNode.assign(m_Width * m_Height, -1);
+		for (unsigned int v = 0; ok && v < m_Cells.size(); v++) {
+			int cell = m_Cells[v];
+			ok = cell >= 0 && cell < m_Width * m_Height
+					&& m_CellNode[cell] < 0;
+			if (ok) {
+				m_CellNode[cell] = v;
+			}
+		}
+	}
+
+	ok = ok && ValidOffsets(m_UpOffsets, upCount)
+			&& ValidOffsets(m_DownOffsets, downCount) && CheckEdges(0)
+			&& CheckEdges(1);
+
+	if (!ok) {
+		m_Cells.clear();
+		m_CellNode.clear();
+		m_Up.clear();
+		m_Down.clear();
+		m_UpOffsets.clear();
+		m_DownOffsets.clear();
+		return false;
+	}
+
+	m_Shortcuts = 0;
+	for (unsigned int i = 0; i < m_Up.size(); i++) {
+		m_Shortcuts += (m_Up[i].middle >= 0);
+	}
+	for (unsigned int i = 0; i < m_Down.size(); i++) {
+		m_Shortcuts += (m_Down[i].middle >= 0);
+	}
+
+	return true;
+}
+
+float ContractionHierarchy::Query(MapSearchNode &start, MapSearchNode &goal,
+		vector<MapSearchNode> *path) {
+	int s = GetNode(start);
+	int t = GetNode(goal);
+
+	m_Settled = 0;
+
+	if (path) {
+		path->clear();
+	}
+
+	if (s < 0 || t < 0) {
+		return FLT_MAX;
+	}
+
+	int nodes = m_Cells.size();
+
+	for (int dir = 0; dir < 2; dir++) {
+		if ((int) m_Labels[dir].size() != nodes) {
+			Label empty = { FLT_MAX, -1, -1, 0 };
+			m_Labels[dir].assign(nodes, empty);
+		}
+	}
+
+	// A new stamp invalidates the scratch space of the last query
+	m_CurrentStamp++;
+	if (m_CurrentStamp == 0) {
+		for (int dir = 0; dir < 2; dir++) {
+			for (int v = 0; v < nodes; v++) {
+				m_Labels[dir][v].stamp = 0;
+			}
+		}
+		m_CurrentStamp = 1;
+	}
+
+	int source[2] = { s, t };
+
+	for (int dir = 0; dir < 2; dir++) {
+		Label &label = m_Labels[dir][source[dir]];
+		label.dist = 0.0f;
+		label.parent = -1;
+		label.stamp = m_CurrentStamp;
+		m_Open[dir].clear();
+		m_Open[dir].push_back(QueueEntry(0.0f, source[dir]));
+	}
+
+	float best = FLT_MAX;
+	int meet = -1;
+
+	for (;;) {
+		// Advance the direction with the smaller key; both are done once
+		// neither can improve on the best meeting point
+		float key[2];
+		for (int dir = 0; dir < 2; dir++) {
+			key[dir] =
+					m_Open[dir].empty() ? FLT_MAX : m_Open[dir].front().first;
+		}
+
+		if (min(key[0], key[1]) >= best) {
+			break;
+		}
+
+		int dir = (key[0] <= key[1]) ? 0 : 1;
+		float d = m_Open[dir].front().first;
+		int u = m_Open[dir].front().second;
+		pop_heap(m_Open[dir].begin(), m_Open[dir].end(), greater<QueueEntry>());
+		m_Open[dir].pop_back();
+
+		if (d > m_Labels[dir][u].dist) {
+			continue;
+		}
+
+		m_Settled++;
+
+		const Label &other = m_Labels[1 - dir][u];
+		if (other.stamp == m_CurrentStamp && d + other.dist < best) {
+			best = d + other.dist;
+			meet = u;
+		}
+
+		const vector<int> &offsets = dir == 0 ? m_UpOffsets : m_DownOffsets;
+		const vector<Edge> &edges = dir == 0 ? m_Up : m_Down;
+
+		// Stall on demand: if a higher node already reached by this search
+		// has a cheaper edge down to u, u is not on a shortest up-down path
+		const vector<int> &stallOffsets =
+				dir == 0 ? m_DownOffsets : m_UpOffsets;
+		const vector<Edge> &stallEdges = dir == 0 ? m_Down : m_Up;
+		bool stalled = false;
+
+		for (int i = stallOffsets[u]; i < stallOffsets[u + 1]; i++) {
+			int v = stallEdges[i].target;
+
+			const Label &label = m_Labels[dir][v];
+			if (label.stamp == m_CurrentStamp
+					&& label.dist + stallEdges[i].cost < d) {
+				stalled = true;
+				break;
+			}
+		}
+
+		if (stalled) {
+			continue;
+		}
+
+		for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+			int v = edges[i].target;
+			float newd = d + edges[i].cost;
+
+			Label &label = m_Labels[dir][v];
+			if (label.stamp == m_CurrentStamp && label.dist <= newd) {
+				continue;
+			}
+
+			label.stamp = m_CurrentStamp;
+			label.dist = newd;
+			label.parent = u;
+			label.parentEdge = i;
+			m_Open[dir].push_back(QueueEntry(newd, v));
+			push_heap(m_Open[dir].begin(), m_Open[dir].end(),
+					greater<QueueEntry>());
+		}
+	}
+
+	if (meet < 0) {
+		return FLT_MAX;
+	}
+
+	if (path) {
+		path->push_back(start);
+
+		// Forward half, collected from the meeting node back to the start
+		vector<int> forward;
+		for (int v = meet; v != s; v = m_Labels[0][v].parent) {
+			forward.push_back(v);
+		}
+
+		for (int i = forward.size() - 1; i >= 0; i--) {
+			int v = forward[i];
+			const Label &label = m_Labels[0][v];
+			UnpackEdge(label.parent, v, m_Up[label.parentEdge].middle, *path);
+		}
+
+		// Backward half, which already runs towards the goal
+		for (int v = meet; v != t; v = m_Labels[1][v].parent) {
+			const Label &label = m_Labels[1][v];
+			UnpackEdge(v, label.parent, m_Down[label.parentEdge].middle, *path);
+		}
+	}
+
+	return best;
+}
+
+void ContractionHierarchy::UnpackEdge(int from, int to, int middle,
+		vector<MapSearchNode> &path) {
+	if (middle < 0) {
+		path.push_back(
+				MapSearchNode(m_Cells[to] % m_Width, m_Cells[to] / m_Width));
+		return;
+	}
+
+	// The middle node was contracted before both ends, so from->middle is a
+	// downward edge stored under middle and middle->to an upward one
+	const Edge *first = FindEdge(1, middle, from);
+	const Edge *second = FindEdge(0, middle, to);
+
+	assert(first != NULL && second != NULL);
+
+	UnpackEdge(from, middle, first->middle, path);
+	UnpackEdge(middle, to, second->middle, path);
+}
+
+const ContractionHierarchy::Edge *ContractionHierarchy::FindEdge(int direction,
+		int node, int target) const {
+	const vector<int> &offsets = direction == 0 ? m_UpOffsets : m_DownOffsets;
+	const vector<Edge> &edges = direction == 0 ? m_Up : m_Down;
+
+	for (int i = offsets[node]; i < offsets[node + 1]; i++) {
+		if (edges[i].target == target) {
+			return &edges[i];
+		}
+	}
+
+	return NULL;
+}
+
+bool ContractionHierarchy::CheckEdges(int direction) const {
+	const vector<int> &offsets = direction == 0 ? m_UpOffsets : m_DownOffsets;
+	const vector<Edge> &edges = direction == 0 ? m_Up : m_Down;
+	int nodes = m_Cells.size();
+
+	for (int u = 0; u < nodes; u++) {
+		for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+			const Edge &edge = edges[i];
+
+			// Both kinds of edge lead up the hierarchy, to a lower id
+			if (edge.target < 0 || edge.target >= u) {
+				return false;
+			}
+			if (edge.middle == -1) {
+				continue;
+			}
+
+			// A shortcut's middle was contracted before both its ends, and
+			// the two edges it stands for must be there to unpack it. An up
+			// edge runs from u to its target, a down edge the other way
+			int from = direction == 0 ? u : edge.target;
+			int to = direction == 0 ? edge.target : u;
+			if (edge.middle <= u || edge.middle >= nodes
+					|| !FindEdge(1, edge.middle, from)
+					|| !FindEdge(0, edge.middle, to)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+int ContractionHierarchy::GetNode(const MapSearchNode &state) const {
+	if (state.x < 0 || state.x >= m_Width || state.y < 0
+			|| state.y >= m_Height) {
+		return -1;
+	}
+
+	return m_CellNode[state.y * m_Width + state.x];
+}
+
+int ContractionHierarchy::GetNodeCount() const {
+	return m_Cells.size();
+}
+
+int ContractionHierarchy::GetShortcutCount() const {
+	return m_Shortcuts;
+}
+
+int ContractionHierarchy::GetSettledCount() const {
+	return m_Settled;
+}
@@ -0,0 +1,132 @@
+/*
+ * ContractionHierarchy.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef CONTRACTIONHIERARCHY_H_
+#define CONTRACTIONHIERARCHY_H_
+
+#include <vector>
+#include <utility>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+// Contraction hierarchy over the grid graph of the world map. Every cell the
+// agent fits in is a graph node with an edge to each of its MapSearchNode
+// successors, weighted by MapSearchNode::GetCost, so the hierarchy follows the
+// rules it is built for.
+// Build() contracts the nodes one by one adding shortcuts, after which a query
+// is a bidirectional Dijkstra that only ever moves up the hierarchy.
+//
+// Known limitation: queries fall well short of the 10us aimed for on
+// 1024x1024 maps. On bench/ch_bench's random maps (20% walls over terrain
+// 1 to 4, 8-connected) a query takes about 90us at 256x256, 180us at
+// 512x512 and 900us at 1024x1024, 100 to 200 times faster than
+// CompactAStarSearch but settling a few hundred nodes each way. Grids have
+// many equally cheap paths, so the top of the hierarchy ends up densely
+// connected, and every query scans thousands of its edges, most of them
+// cache misses. Closing the gap needs a better contraction order or a
+// coarser graph than one node per cell, not a faster query loop.
+
+class ContractionHierarchy {
+public:
+	// An edge of the hierarchy. middle is the contracted node a shortcut
+	// bypasses, or -1 for an edge of the original grid
+	struct Edge {
+		int target;
+		int middle;
+		float cost;
+	};
+
+	// Distance and node, kept in a min heap by the searches
+	typedef std::pair<float, int> QueueEntry;
+
+	ContractionHierarchy();
+	virtual ~ContractionHierarchy();
+
+	// Contracts the grid graph of the current world map under the given
+	// rules, the defaults as they are now unless given
+	void Build(const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Hierarchy file format, all values in host byte order:
+	//   char[4] "CHG1", int version, int width, int height, int nodes,
+	//   int cells[nodes],
+	//   int up offsets[nodes + 1], int up edge count, Edge up[],
+	//   int down offsets[nodes + 1], int down edge count, Edge down[]
+	// Load() refuses a file for a map of another size than the world map,
+	// or one whose cells, offsets or edges do not make a hierarchy
+	bool Save(const char *fileName) const;
+	bool Load(const char *fileName);
+
+	// Returns the cost of the cheapest path from start to goal, or FLT_MAX if
+	// there is none. If path is not NULL it receives every cell of the path,
+	// start and goal included
+	float Query(MapSearchNode &start, MapSearchNode &goal,
+			std::vector<MapSearchNode> *path);
+
+	int GetNodeCount() const;
+	int GetShortcutCount() const;
+
+	// Nodes settled by the last query, both directions together
+	int GetSettledCount() const;
+
+private:
+	// Search state of one node in one direction of a query, valid only while
+	// stamp matches the current query
+	struct Label {
+		float dist;
+		int parent;
+		int parentEdge;
+		unsigned int stamp;
+	};
+
+	int GetPriority(int v);
+	int ContractNode(int v, bool simulate);
+	void WitnessSearch(int source, int skip, float maxCost, int settleLimit);
+	void AddEdge(std::vector<Edge> &edges, int target, int middle,
+			float cost);
+	void RemoveEdge(std::vector<Edge> &edges, int target);
+
+	void UnpackEdge(int from, int to, int middle,
+			std::vector<MapSearchNode> &path);
+	const Edge *FindEdge(int direction, int node, int target) const;
+	bool CheckEdges(int direction) const;
+	int GetNode(const MapSearchNode &state) const;
+
+private:
+	int m_Width;
+	int m_Height;
+	int m_Shortcuts;
+
+	// Node ids <-> cell index (y * width + x). Nodes are numbered in reverse
+	// contraction order, so a lower id is higher up the hierarchy
+	std::vector<int> m_Cells;
+	std::vector<int> m_CellNode;
+
+	// Upward graphs in CSR form. m_Up holds u->v with v < u under u, m_Down
+	// holds u->v with u < v under v with target u
+	std::vector<int> m_UpOffsets;
+	std::vector<Edge> m_Up;
+	std::vector<int> m_DownOffsets;
+	std::vector<Edge> m_Down;
+
+	// Adjacency used while contracting, dropped once the hierarchy is built
+	std::vector<std::vector<Edge> > m_Out;
+	std::vector<std::vector<Edge> > m_In;
+	std::vector<int> m_DeletedNeighbours;
+
+	// Per search scratch space, reset through the stamps so a query never
+	// touches more than the nodes it settles
+	std::vector<Label> m_Labels[2];
+	std::vector<QueueEntry> m_Open[2];
+	unsigned int m_CurrentStamp;
+	int m_Settled;
+
+	std::vector<float> m_WitnessDist;
+	std::vector<int> m_WitnessTouched;
+};
+
+#endif /* CONTRACTIONHIERARCHY_H_ */
@@ -0,0 +1,124 @@
+/*
+ * EdgeCostTable.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "EdgeCostTable.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+#include "Map.h"
+#include "MapSearchNode.h"
+
+const float EdgeCostTable::NO_MOVE = FLT_MAX;
+const int EdgeCostTable::TERRAIN_TYPES;
+
+// Direction of a move (dx, dy) as an index into (dy + 1) * 3 + dx + 1, in
+// the order of the moves in MapSearchNode.cpp
+static const int MOVE_DIRECTION[9] = { 4, 1, 5, 0, -1, 2, 7, 3, 6 };
+
+// The row of a cell off the table
+static const float NO_MOVES[8] = { EdgeCostTable::NO_MOVE,
+		EdgeCostTable::NO_MOVE, EdgeCostTable::NO_MOVE, EdgeCostTable::NO_MOVE,
+		EdgeCostTable::NO_MOVE, EdgeCostTable::NO_MOVE, EdgeCostTable::NO_MOVE,
+		EdgeCostTable::NO_MOVE };
+
+EdgeCostTable::EdgeCostTable() :
+		m_Width(0), m_Height(0), m_Directions(0), m_CornerRule(0),
+		m_AgentSize(0) {
+	for (int from = 0; from < TERRAIN_TYPES; from++) {
+		for (int to = 0; to < TERRAIN_TYPES; to++) {
+			m_Penalties[from][to] = 0.0f;
+		}
+	}
+}
+
+EdgeCostTable::~EdgeCostTable() {
+}
+
+void EdgeCostTable::SetTransitionPenalty(int from, int to, float penalty) {
+	assert(from >= 0 && from < TERRAIN_TYPES && to >= 0 && to < TERRAIN_TYPES);
+	assert(penalty >= 0.0f);
+	m_Penalties[from][to] = penalty;
+}
+
+float EdgeCostTable::GetTransitionPenalty(int from, int to) const {
+	return m_Penalties[from][to];
+}
+
+void EdgeCostTable::Build(const MapSearchNode::Rules &rules) {
+	// Read one map throughout, even if the world map is replaced meanwhile
+	m_Map = Map::GetSnapshot();
+	Map::SnapshotScope scope(m_Map);
+
+	m_Width = Map::GetWidth();
+	m_Height = Map::GetHeight();
+	m_Directions = rules.connectivity == MapSearchNode::CONNECT_8 ? 8 : 4;
+	m_CornerRule = rules.cornerRule;
+	m_AgentSize = rules.agentSize;
+	m_Costs.assign((long) m_Width * m_Height * m_Directions, NO_MOVE);
+
+	// The moves and costs come from MapSearchNode itself, so it must not
+	// read them from a table while this one is built, nor leave out the
+	// cells units stand on now
+	MapSearchNode::Rules own = rules;
+	own.edgeCosts = NULL;
+	own.overlay = NULL;
+
+	std::vector<int> x, y;
+	for (int cy = 0; cy < m_Height; cy++) {
+		for (int cx = 0; cx < m_Width; cx++) {
+			int from = Map::GetMap(cx, cy);
+			MapSearchNode state(cx, cy);
+			state.GetSuccessors(NULL, x, y, own);
+			float *costs = &m_Costs[((long) cy * m_Width + cx) * m_Directions];
+
+			for (unsigned int i = 0; i < x.size(); i++) {
+				MapSearchNode successor(x[i], y[i]);
+				int to = Map::GetMap(x[i], y[i]);
+				int d = MOVE_DIRECTION[(y[i] - cy + 1) * 3 + x[i] - cx + 1];
+
+				// Moves off a blocked cell, as from a start on one, carry no
+				// penalty
+				costs[d] = state.GetCost(successor, own);
+				if (from < TERRAIN_TYPES) {
+					costs[d] += m_Penalties[from][to];
+				}
+			}
+		}
+	}
+}
+
+int EdgeCostTable::GetDirectionCount() const {
+	return m_Directions;
+}
+
+long EdgeCostTable::GetTableSize() const {
+	return m_Costs.size() * sizeof(float);
+}
+
+bool EdgeCostTable::IsFor(const MapSearchNode::Rules &rules) const {
+	int directions = rules.connectivity == MapSearchNode::CONNECT_8 ? 8 : 4;
+	return m_Map && directions == m_Directions
+			&& rules.cornerRule == m_CornerRule
+			&& rules.agentSize == m_AgentSize && Map::IsCurrent(m_Map.get());
+}
+
+const float *EdgeCostTable::GetCosts(int x, int y) const {
+	if (x < 0 || x >= m_Width || y < 0 || y >= m_Height) {
+		return NO_MOVES;
+	}
+	return &m_Costs[((long) y * m_Width + x) * m_Directions];
+}
+
+float EdgeCostTable::GetCost(int x, int y, int dx, int dy) const {
+	int d = MOVE_DIRECTION[(dy + 1) * 3 + dx + 1];
+	if (d < 0 || d >= m_Directions || x < 0 || x >= m_Width || y < 0
+			|| y >= m_Height) {
+		return NO_MOVE;
+	}
+	return m_Costs[((long) y * m_Width + x) * m_Directions + d];
+}
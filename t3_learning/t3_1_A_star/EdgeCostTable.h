@@ -0,0 +1,79 @@
+/*
+ * EdgeCostTable.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef EDGECOSTTABLE_H_
+#define EDGECOSTTABLE_H_
+
+#include <memory>
+#include <vector>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+class MapSnapshot;
+
+// The cost of every move out of every cell, worked out once. Each cell has
+// a row of 4 or 8 costs, one per direction in MapSearchNode's move order,
+// NO_MOVE where the move is not allowed, so expanding a cell reads one row
+// of contiguous memory in place of the map, clearance and corner checks.
+//
+// A move costs what MapSearchNode::GetCost says plus the transition
+// penalty from the terrain it leaves to the terrain it enters, so moving
+// between kinds of ground can cost extra. Penalties must not be negative,
+// which keeps the heuristics admissible.
+//
+// A search reads its moves and costs from the table given in its rules, see
+// MapSearchNode::Rules. Built for the map in force at the time and the rules
+// it is given, the defaults as they are then unless given. Searches of any
+// other map, or moving by other connectivity, corner rule or agent size,
+// pass the table over and work the moves out from the map, so it must be
+// built again for them to be of use.
+
+class EdgeCostTable {
+public:
+	static const float NO_MOVE;
+
+	// Terrain costs 0 to 8 are passable
+	static const int TERRAIN_TYPES = 9;
+
+	EdgeCostTable();
+	virtual ~EdgeCostTable();
+
+	// Extra cost of a move from terrain from onto terrain to, 0 by default.
+	// Takes effect when the table is next built
+	void SetTransitionPenalty(int from, int to, float penalty);
+	float GetTransitionPenalty(int from, int to) const;
+
+	void Build(const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	int GetDirectionCount() const;
+	long GetTableSize() const;
+
+	// Whether the table was built for the map this thread's Map calls read
+	// and for the movement in these rules
+	bool IsFor(const MapSearchNode::Rules &rules) const;
+
+	// The costs of the moves out of (x, y), in MapSearchNode's move order.
+	// All NO_MOVE off the table
+	const float *GetCosts(int x, int y) const;
+
+	// Cost of the move from (x, y) by (dx, dy), NO_MOVE if not allowed
+	float GetCost(int x, int y, int dx, int dy) const;
+
+private:
+	std::shared_ptr<const MapSnapshot> m_Map;
+	int m_Width;
+	int m_Height;
+	int m_Directions;
+	int m_CornerRule;
+	int m_AgentSize;
+
+	float m_Penalties[TERRAIN_TYPES][TERRAIN_TYPES];
+	std::vector<float> m_Costs;
+};
+
+#endif /* EDGECOSTTABLE_H_ */
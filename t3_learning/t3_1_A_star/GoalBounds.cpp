@@ -0,0 +1,287 @@
+/*
+ * GoalBounds.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "GoalBounds.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <functional>
+#include <thread>
+#include <utility>
+
+#include "Map.h"
+
+using namespace std;
+
+static const int GB_FILE_VERSION = 1;
+
+// Magic and seven ints, which keeps the boxes 8 byte aligned
+static const int GB_HEADER_SIZE = 32;
+
+// Same order as the moves in MapSearchNode.cpp
+const int BOUNDS_MOVE_X[8] = { -1, 0, 1, 0, -1, 1, 1, -1 };
+const int BOUNDS_MOVE_Y[8] = { 0, -1, 0, 1, -1, -1, 1, 1 };
+
+GoalBounds::GoalBounds() :
+		m_Width(0), m_Height(0), m_Directions(0), m_Boxes(NULL),
+		m_Mapping(NULL), m_MappingSize(0) {
+}
+
+GoalBounds::~GoalBounds() {
+	Unmap();
+}
+
+void GoalBounds::Build(int threads, const MapSearchNode::Rules &rules) {
+	Unmap();
+
+	m_Width = Map::GetWidth();
+	m_Height = Map::GetHeight();
+	m_Rules = rules;
+	m_Rules.overlay = NULL;
+	m_Directions = rules.connectivity == MapSearchNode::CONNECT_8 ? 8 : 4;
+
+	int cells = m_Width * m_Height;
+	m_Moves.assign(cells, 0);
+	m_Costs.assign(cells * m_Directions, 0.0f);
+
+	vector<int> x, y;
+	for (int cell = 0; cell < cells; cell++) {
+		MapSearchNode state(cell % m_Width, cell / m_Width);
+		if (Map::GetClearance(state.x, state.y) < m_Rules.agentSize) {
+			continue;
+		}
+
+		state.GetSuccessors(NULL, x, y, m_Rules);
+		for (unsigned int i = 0; i < x.size(); i++) {
+			for (int d = 0; d < m_Directions; d++) {
+				if (x[i] - state.x == BOUNDS_MOVE_X[d]
+						&& y[i] - state.y == BOUNDS_MOVE_Y[d]) {
+					MapSearchNode successor(x[i], y[i]);
+					m_Moves[cell] |= 1 << d;
+					m_Costs[cell * m_Directions + d] = state.GetCost(successor,
+							m_Rules);
+				}
+			}
+		}
+	}
+
+	Box empty = { 0xffff, 0xffff, 0, 0 };
+	m_Table.assign(cells * m_Directions, empty);
+	m_Boxes = m_Table.empty() ? NULL : &m_Table[0];
+
+	// Sources are dealt out round robin, each thread filling in only the
+	// boxes of its own sources
+	threads = max(1, threads);
+	shared_ptr<const MapSnapshot> map = Map::GetSnapshot();
+	vector<thread> workers;
+	for (int i = 1; i < threads; i++) {
+		workers.push_back(thread([this, i, threads, map]() {
+			Map::SnapshotScope scope(map);
+			BuildSources(i, threads);
+		}));
+	}
+	BuildSources(0, threads);
+	for (unsigned int i = 0; i < workers.size(); i++) {
+		workers[i].join();
+	}
+
+	m_Moves.clear();
+	m_Costs.clear();
+}
+
+// Dijkstra from each source, carrying along every optimal first move to each
+// cell as a bit set: the source's own moves start their sets, and a cell
+// reached as cheaply through several parents takes all their sets
+void GoalBounds::BuildSources(int first, int step) {
+	typedef pair<float, int> QueueEntry;
+
+	int cells = m_Width * m_Height;
+	vector<float> distance(cells, FLT_MAX);
+	vector<unsigned char> firstMoves(cells, 0);
+	vector<int> touched;
+	vector<QueueEntry> open;
+
+	for (int source = first; source < cells; source += step) {
+		if (!m_Moves[source]) {
+			continue;
+		}
+
+		for (unsigned int i = 0; i < touched.size(); i++) {
+			distance[touched[i]] = FLT_MAX;
+			firstMoves[touched[i]] = 0;
+		}
+		touched.assign(1, source);
+		distance[source] = 0.0f;
+		open.assign(1, QueueEntry(0.0f, source));
+
+		Box *boxes = &m_Table[source * m_Directions];
+
+		while (!open.empty()) {
+			QueueEntry e = open.front();
+			pop_heap(open.begin(), open.end(), greater<QueueEntry>());
+			open.pop_back();
+
+			int cell = e.second;
+			if (e.first > distance[cell]) {
+				continue;
+			}
+
+			int cx = cell % m_Width;
+			int cy = cell / m_Width;
+			for (int d = 0; d < m_Directions; d++) {
+				if (firstMoves[cell] & (1 << d)) {
+					Box &box = boxes[d];
+					box.minX = min<int>(box.minX, cx);
+					box.minY = min<int>(box.minY, cy);
+					box.maxX = max<int>(box.maxX, cx);
+					box.maxY = max<int>(box.maxY, cy);
+				}
+			}
+
+			for (int d = 0; d < m_Directions; d++) {
+				if (!(m_Moves[cell] & (1 << d))) {
+					continue;
+				}
+
+				int next = cell + BOUNDS_MOVE_Y[d] * m_Width + BOUNDS_MOVE_X[d];
+				float g = e.first + m_Costs[cell * m_Directions + d];
+				unsigned char moves =
+						cell == source ? 1 << d : firstMoves[cell];
+
+				if (g < distance[next]) {
+					if (distance[next] == FLT_MAX) {
+						touched.push_back(next);
+					}
+					distance[next] = g;
+					firstMoves[next] = moves;
+					open.push_back(QueueEntry(g, next));
+					push_heap(open.begin(), open.end(), greater<QueueEntry>());
+				} else if (g == distance[next]) {
+					firstMoves[next] |= moves;
+				}
+			}
+		}
+	}
+}
+
+bool GoalBounds::Save(const char *fileName) const {
+	FILE *file = fopen(fileName, "wb");
+
+	if (!file) {
+		return false;
+	}
+
+	int header[7] = { GB_FILE_VERSION, m_Width, m_Height, m_Directions,
+			m_Rules.connectivity, m_Rules.cornerRule, m_Rules.agentSize };
+	size_t boxes = (size_t) m_Width * m_Height * m_Directions;
+
+	bool ok = fwrite("GBT1", 1, 4, file) == 4
+			&& fwrite(header, sizeof(int), 7, file) == 7
+			&& (boxes == 0 || fwrite(m_Boxes, sizeof(Box), boxes, file) == boxes);
+
+	return (fclose(file) == 0) && ok;
+}
+
+bool GoalBounds::Load(const char *fileName,
+		const MapSearchNode::Rules &rules) {
+	// The table in use stays until the file is known to be good
+	int fd = open(fileName, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat status;
+	void *mapping = MAP_FAILED;
+	if (fstat(fd, &status) == 0 && status.st_size >= GB_HEADER_SIZE) {
+		mapping = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	}
+	close(fd);
+
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+
+	const char *data = (const char *) mapping;
+	int header[7];
+	memcpy(header, data + 4, sizeof(header));
+
+	bool ok = memcmp(data, "GBT1", 4) == 0 && header[0] == GB_FILE_VERSION
+			&& header[1] == Map::GetWidth() && header[2] == Map::GetHeight()
+			&& (header[3] == 4 || header[3] == 8)
+			&& header[4] == rules.connectivity && header[5] == rules.cornerRule
+			&& header[6] == rules.agentSize
+			&& status.st_size
+					== GB_HEADER_SIZE
+							+ (long) header[1] * header[2] * header[3]
+									* (long) sizeof(Box);
+
+	if (!ok) {
+		munmap(mapping, status.st_size);
+		return false;
+	}
+
+	m_Table.clear();
+	Unmap();
+
+	m_Mapping = mapping;
+	m_MappingSize = status.st_size;
+	m_Width = header[1];
+	m_Height = header[2];
+	m_Directions = header[3];
+	m_Rules = rules;
+	m_Rules.overlay = NULL;
+	m_Boxes = (const Box *) (data + GB_HEADER_SIZE);
+
+	return true;
+}
+
+bool GoalBounds::IsAllowed(int x, int y, int nx, int ny,
+		const MapSearchNode &goal) const {
+	int dx = nx - x;
+	int dy = ny - y;
+
+	// Straight moves come first, then diagonals, as in MapSearchNode
+	int d;
+	if (dx == 0 || dy == 0) {
+		d = dx == -1 ? 0 : (dy == -1 ? 1 : (dx == 1 ? 2 : 3));
+	} else {
+		d = dy == -1 ? (dx == -1 ? 4 : 5) : (dx == 1 ? 6 : 7);
+	}
+
+	if (d >= m_Directions || x < 0 || x >= m_Width || y < 0
+			|| y >= m_Height) {
+		return true;
+	}
+
+	const Box &box = m_Boxes[(y * m_Width + x) * m_Directions + d];
+	return goal.x >= box.minX && goal.x <= box.maxX && goal.y >= box.minY
+			&& goal.y <= box.maxY;
+}
+
+int GoalBounds::GetDirectionCount() const {
+	return m_Directions;
+}
+
+long GoalBounds::GetTableSize() const {
+	return (long) m_Width * m_Height * m_Directions * sizeof(Box);
+}
+
+void GoalBounds::Unmap() {
+	if (m_Mapping) {
+		munmap(m_Mapping, m_MappingSize);
+		m_Mapping = NULL;
+		m_MappingSize = 0;
+	}
+	m_Boxes = m_Table.empty() ? NULL : &m_Table[0];
+}
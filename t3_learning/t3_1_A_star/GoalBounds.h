@@ -0,0 +1,91 @@
+/*
+ * GoalBounds.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef GOALBOUNDS_H_
+#define GOALBOUNDS_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "MapSearchNode.h"
+
+// Goal bounding tables. For every cell and every move out of it, the
+// bounding box of all the goals some optimal path from the cell starts with
+// that move. A search may skip a move whose box does not hold its goal, and
+// still finds an optimal path.
+//
+// Build() runs a Dijkstra search from every cell, so it takes time
+// quadratic in the map size; it can share the work out over threads. The
+// table is 8 bytes per box, 4 or 8 boxes a cell depending on connectivity.
+// Save() writes it as a header followed by the boxes as they are in memory,
+// and Load() maps the file rather than reading it, so only the pages
+// searches touch are ever read in.
+//
+// Built for the map in force at the time and the rules it is given, the
+// defaults as they are then unless given.
+
+class GoalBounds {
+public:
+	// Inclusive, empty when minX > maxX
+	struct Box {
+		uint16_t minX;
+		uint16_t minY;
+		uint16_t maxX;
+		uint16_t maxY;
+	};
+
+	GoalBounds();
+	virtual ~GoalBounds();
+
+	void Build(int threads,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Table file format, all values in host byte order:
+	//   char[4] "GBT1", int version, int width, int height,
+	//   int directions, int connectivity, int corner rule, int agent size,
+	//   Box boxes[width * height * directions], in cell then direction order
+	bool Save(const char *fileName) const;
+
+	// Maps the table file. Fails if it was built for a map of another size,
+	// or for other movement rules or agent size than the ones given, the
+	// defaults as they are now unless given, keeping the table it had
+	bool Load(const char *fileName,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Whether an optimal path to goal may continue from (x, y) to the
+	// neighbouring (nx, ny)
+	bool IsAllowed(int x, int y, int nx, int ny,
+			const MapSearchNode &goal) const;
+
+	int GetDirectionCount() const;
+	long GetTableSize() const;
+
+private:
+	void BuildSources(int first, int step);
+	void Unmap();
+
+private:
+	int m_Width;
+	int m_Height;
+	int m_Directions;
+	MapSearchNode::Rules m_Rules;
+
+	// Either m_Table's data or the mapped file
+	const Box *m_Boxes;
+	std::vector<Box> m_Table;
+
+	void *m_Mapping;
+	long m_MappingSize;
+
+	// Moves and their costs out of each cell while building, bit i set for
+	// direction i in MapSearchNode order
+	std::vector<unsigned char> m_Moves;
+	std::vector<float> m_Costs;
+};
+
+#endif /* GOALBOUNDS_H_ */
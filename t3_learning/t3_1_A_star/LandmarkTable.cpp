@@ -0,0 +1,254 @@
+/*
+ * LandmarkTable.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "LandmarkTable.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cfloat>
+#include <functional>
+#include <utility>
+
+#include "Map.h"
+
+using namespace std;
+
+// Row padding, the widest vector Raise() uses
+static const int LANDMARK_ALIGN = 8;
+
+LandmarkTable::LandmarkTable() :
+		m_Width(0), m_Height(0), m_Stride(0) {
+}
+
+LandmarkTable::~LandmarkTable() {
+}
+
+void LandmarkTable::Build(int landmarks, const MapSearchNode::Rules &rules) {
+	m_Width = Map::GetWidth();
+	m_Height = Map::GetHeight();
+	m_Rules = rules;
+	m_Rules.overlay = NULL;
+	m_Landmarks.clear();
+
+	// Landmarks go in the largest region, the first the cell costliest to
+	// reach from its open cell nearest the centre
+	int cells = m_Width * m_Height;
+	int first = FindSeed();
+
+	// The least cost from the landmarks so far to each cell
+	vector<float> nearest(cells, FLT_MAX);
+	vector<float> distance;
+	vector<vector<float> > rows;
+
+	if (first >= 0) {
+		BuildDistances(first, nearest);
+	}
+
+	for (int i = 0; i < landmarks && first >= 0; i++) {
+		int best = -1;
+		for (int cell = 0; cell < cells; cell++) {
+			if (nearest[cell] > 0.0f && nearest[cell] < FLT_MAX
+					&& (best < 0 || nearest[cell] > nearest[best])) {
+				best = cell;
+			}
+		}
+		if (best < 0) {
+			break;
+		}
+
+		m_Landmarks.push_back(best);
+		BuildDistances(best, distance);
+		for (int cell = 0; cell < cells; cell++) {
+			nearest[cell] = i == 0 ? distance[cell] :
+					min(nearest[cell], distance[cell]);
+		}
+		rows.push_back(distance);
+	}
+
+	m_Stride = (m_Landmarks.size() + LANDMARK_ALIGN - 1) / LANDMARK_ALIGN
+			* LANDMARK_ALIGN;
+	m_Distances.assign((long) cells * m_Stride, 0.0f);
+
+	for (unsigned int i = 0; i < rows.size(); i++) {
+		for (int cell = 0; cell < cells; cell++) {
+			m_Distances[(long) cell * m_Stride + i] = rows[i][cell];
+		}
+	}
+}
+
+// Labels the regions of cells the agent fits in by flood fill, moves being
+// symmetric, and returns the cell nearest the centre of the largest, -1 if
+// there are none
+int LandmarkTable::FindSeed() const {
+	int cells = m_Width * m_Height;
+	vector<int> region(cells, -1);
+	vector<int> sizes;
+	vector<int> stack, x, y;
+
+	for (int cell = 0; cell < cells; cell++) {
+		if (region[cell] >= 0
+				|| Map::GetClearance(cell % m_Width, cell / m_Width)
+						< m_Rules.agentSize) {
+			continue;
+		}
+
+		int r = sizes.size();
+		sizes.push_back(0);
+		region[cell] = r;
+		stack.push_back(cell);
+
+		while (!stack.empty()) {
+			int c = stack.back();
+			stack.pop_back();
+			sizes[r]++;
+
+			MapSearchNode state(c % m_Width, c / m_Width);
+			state.GetSuccessors(NULL, x, y, m_Rules);
+			for (unsigned int i = 0; i < x.size(); i++) {
+				int next = y[i] * m_Width + x[i];
+				if (region[next] < 0) {
+					region[next] = r;
+					stack.push_back(next);
+				}
+			}
+		}
+	}
+
+	if (sizes.empty()) {
+		return -1;
+	}
+	int largest = max_element(sizes.begin(), sizes.end()) - sizes.begin();
+
+	int seed = -1;
+	long seedDistance = 0;
+	for (int cell = 0; cell < cells; cell++) {
+		long dx = cell % m_Width - m_Width / 2;
+		long dy = cell / m_Width - m_Height / 2;
+		if (region[cell] == largest
+				&& (seed < 0 || dx * dx + dy * dy < seedDistance)) {
+			seed = cell;
+			seedDistance = dx * dx + dy * dy;
+		}
+	}
+	return seed;
+}
+
+// Dijkstra from the landmark over the moves MapSearchNode allows
+void LandmarkTable::BuildDistances(int landmark,
+		vector<float> &distance) const {
+	typedef pair<float, int> QueueEntry;
+
+	distance.assign(m_Width * m_Height, FLT_MAX);
+	distance[landmark] = 0.0f;
+
+	vector<QueueEntry> open(1, QueueEntry(0.0f, landmark));
+	vector<int> x, y;
+
+	while (!open.empty()) {
+		QueueEntry e = open.front();
+		pop_heap(open.begin(), open.end(), greater<QueueEntry>());
+		open.pop_back();
+
+		if (e.first > distance[e.second]) {
+			continue;
+		}
+
+		MapSearchNode state(e.second % m_Width, e.second / m_Width);
+		state.GetSuccessors(NULL, x, y, m_Rules);
+
+		for (unsigned int i = 0; i < x.size(); i++) {
+			MapSearchNode successor(x[i], y[i]);
+			int next = y[i] * m_Width + x[i];
+			float d = e.first + state.GetCost(successor, m_Rules);
+
+			if (d < distance[next]) {
+				distance[next] = d;
+				open.push_back(QueueEntry(d, next));
+				push_heap(open.begin(), open.end(), greater<QueueEntry>());
+			}
+		}
+	}
+}
+
+int LandmarkTable::GetLandmarkCount() const {
+	return m_Landmarks.size();
+}
+
+void LandmarkTable::GetLandmark(int landmark, int &x, int &y) const {
+	x = m_Landmarks[landmark] % m_Width;
+	y = m_Landmarks[landmark] / m_Width;
+}
+
+long LandmarkTable::GetTableSize() const {
+	return m_Distances.size() * sizeof(float);
+}
+
+float LandmarkTable::GetDistance(int landmark, int x, int y) const {
+	return m_Distances[(long) (y * m_Width + x) * m_Stride + landmark];
+}
+
+void LandmarkTable::Raise(const int *x, const int *y, int count,
+		const MapSearchNode &goal, float *h) const {
+	if (m_Landmarks.empty()) {
+		return;
+	}
+
+	// A landmark that cannot reach the goal gives no bound: its goal cost
+	// becomes -FLT_MAX, so every difference from it is at most that
+	float goalRow[LANDMARK_ALIGN * 4];
+	vector<float> wideRow;
+	float *g = goalRow;
+	if (m_Stride > LANDMARK_ALIGN * 4) {
+		wideRow.resize(m_Stride);
+		g = &wideRow[0];
+	}
+
+	const float *row = &m_Distances[(long) (goal.y * m_Width + goal.x)
+			* m_Stride];
+	for (int k = 0; k < m_Stride; k++) {
+		g[k] = row[k] == FLT_MAX ? -FLT_MAX : row[k];
+	}
+
+	for (int i = 0; i < count; i++) {
+		row = &m_Distances[(long) (y[i] * m_Width + x[i]) * m_Stride];
+		float bound = 0.0f;
+		int k = 0;
+
+#if defined(__AVX2__)
+		__m256 best = _mm256_setzero_ps();
+		for (; k < m_Stride; k += 8) {
+			best = _mm256_max_ps(best,
+					_mm256_sub_ps(_mm256_loadu_ps(g + k),
+							_mm256_loadu_ps(row + k)));
+		}
+		__m128 half = _mm_max_ps(_mm256_castps256_ps128(best),
+				_mm256_extractf128_ps(best, 1));
+		half = _mm_max_ps(half, _mm_movehl_ps(half, half));
+		half = _mm_max_ss(half, _mm_shuffle_ps(half, half, 1));
+		bound = _mm_cvtss_f32(half);
+#elif defined(__SSE2__)
+		__m128 best = _mm_setzero_ps();
+		for (; k < m_Stride; k += 4) {
+			best = _mm_max_ps(best,
+					_mm_sub_ps(_mm_loadu_ps(g + k), _mm_loadu_ps(row + k)));
+		}
+		best = _mm_max_ps(best, _mm_movehl_ps(best, best));
+		best = _mm_max_ss(best, _mm_shuffle_ps(best, best, 1));
+		bound = _mm_cvtss_f32(best);
+#endif
+
+		for (; k < m_Stride; k++) {
+			bound = max(bound, g[k] - row[k]);
+		}
+		h[i] = max(h[i], bound);
+	}
+}
@@ -0,0 +1,66 @@
+/*
+ * LandmarkTable.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef LANDMARKTABLE_H_
+#define LANDMARKTABLE_H_
+
+#include <vector>
+
+#include "MapSearchNode.h"
+
+// Landmark (ALT) heuristic. The cost d(L, n) from each of a few landmark
+// cells L to every cell n is stored, and since d(L, goal) <= d(L, n) +
+// d(n, goal), the cost from n to the goal is at least d(L, goal) - d(L, n)
+// for every L. That bound is admissible and consistent, and on maps with
+// walls or costly terrain usually well above the octile distance.
+//
+// Landmarks are picked farthest first: each one the cell costliest to reach
+// from those already picked, all in the largest region of cells the agent
+// fits in, so they help the most queries. The distances of a cell are
+// stored side by side, padded to a multiple of eight, so Raise() takes the
+// bound of all the landmarks in one or two vector instructions. Four bytes
+// a landmark a cell.
+//
+// Built for the map in force at the time and the rules it is given, the
+// defaults as they are then unless given.
+
+class LandmarkTable {
+public:
+	LandmarkTable();
+	virtual ~LandmarkTable();
+
+	void Build(int landmarks,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	int GetLandmarkCount() const;
+	void GetLandmark(int landmark, int &x, int &y) const;
+	long GetTableSize() const;
+
+	// Cost from the landmark to (x, y), FLT_MAX if it cannot get there
+	float GetDistance(int landmark, int x, int y) const;
+
+	// Raises each h[i] to the landmark bound from (x[i], y[i]) to goal where
+	// that is higher. A goal no landmark reaches raises nothing
+	void Raise(const int *x, const int *y, int count,
+			const MapSearchNode &goal, float *h) const;
+
+private:
+	int FindSeed() const;
+	void BuildDistances(int landmark, std::vector<float> &distance) const;
+
+private:
+	int m_Width;
+	int m_Height;
+	int m_Stride;
+	MapSearchNode::Rules m_Rules;
+	std::vector<int> m_Landmarks;
+
+	// m_Stride costs a cell, FLT_MAX where the landmark cannot reach
+	std::vector<float> m_Distances;
+};
+
+#endif /* LANDMARKTABLE_H_ */
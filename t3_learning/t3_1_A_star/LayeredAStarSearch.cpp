@@ -0,0 +1,203 @@
+/*
+ * LayeredAStarSearch.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "LayeredAStarSearch.h"
+
+#include <algorithm>
+
+#include "AStarSearch.h"
+
+const unsigned int LayeredAStarSearch::NO_NODE;
+
+// Tiles of 8 x 8 cells, as in LayeredMap
+static const int TILE_SHIFT = 3;
+static const int TILE_SIZE = 1 << TILE_SHIFT;
+static const int TILE_CELLS = TILE_SIZE * TILE_SIZE;
+
+bool LayeredAStarSearch::HeapCompare_f::operator ()(const OpenEntry &x,
+		const OpenEntry &y) const {
+	return x.f > y.f;
+}
+
+LayeredAStarSearch::LayeredAStarSearch(const LayeredMap &map) :
+		m_Map(map), m_TilesX((map.GetWidth() + TILE_SIZE - 1) >> TILE_SHIFT),
+		m_TilesY((map.GetHeight() + TILE_SIZE - 1) >> TILE_SHIFT),
+		m_TileBlocks(map.GetLayerCount()), m_BlockCount(0),
+		m_State(AStarSearch::SEARCH_STATE_NOT_INITIALISED), m_Steps(0),
+		m_CurrentSolutionNode(0), m_SolutionCost(FLT_MAX) {
+}
+
+LayeredAStarSearch::~LayeredAStarSearch() {
+}
+
+void LayeredAStarSearch::SetStartAndGoalStates(const LayeredMap::Cell &Start,
+		const LayeredMap::Cell &Goal) {
+	// Hand back the blocks the last search took
+	for (unsigned int i = 0; i < m_ReachedTiles.size(); i++) {
+		m_TileBlocks[m_ReachedTiles[i].first][m_ReachedTiles[i].second] = -1;
+	}
+	m_ReachedTiles.clear();
+	m_BlockCount = 0;
+
+	m_Nodes.clear();
+	m_OpenList.clear();
+	m_Solution.clear();
+	m_SolutionCost = FLT_MAX;
+	m_Goal = Goal;
+	m_Steps = 0;
+
+	// Successors are only found for open cells, and only open cells are
+	// reached, which leaves out cells off the map
+	if (!m_Map.IsOpen(Start.x, Start.y, Start.z)
+			|| !m_Map.IsOpen(Goal.x, Goal.y, Goal.z)) {
+		m_State = AStarSearch::SEARCH_STATE_FAILED;
+		return;
+	}
+
+	unsigned int start = AllocateNode(Start, NO_NODE, 0.0f);
+	GetCellNode(Start) = start;
+	PushOpen(start);
+
+	m_State = AStarSearch::SEARCH_STATE_SEARCHING;
+}
+
+unsigned int LayeredAStarSearch::SearchStep() {
+	assert(
+			(m_State > AStarSearch::SEARCH_STATE_NOT_INITIALISED)
+					&& (m_State < AStarSearch::SEARCH_STATE_INVALID));
+
+	if (m_State != AStarSearch::SEARCH_STATE_SEARCHING) {
+		return m_State;
+	}
+
+	// Skip entries for nodes that have been reached more cheaply since
+	OpenEntry best;
+	do {
+		if (m_OpenList.empty()) {
+			m_State = AStarSearch::SEARCH_STATE_FAILED;
+			return m_State;
+		}
+
+		best = m_OpenList.front();
+		pop_heap(m_OpenList.begin(), m_OpenList.end(), HeapCompare_f());
+		m_OpenList.pop_back();
+	} while (best.f > m_Nodes[best.node].g + m_Nodes[best.node].h);
+
+	m_Steps++;
+
+	// Copy, the pool may grow while we expand
+	Node n = m_Nodes[best.node];
+	LayeredMap::Cell state = m_Map.GetCell(n.cell);
+
+	if (state == m_Goal) {
+		for (unsigned int i = best.node; i != NO_NODE;
+				i = m_Nodes[i].parent) {
+			m_Solution.push_back(m_Map.GetCell(m_Nodes[i].cell));
+		}
+		reverse(m_Solution.begin(), m_Solution.end());
+		m_SolutionCost = n.g;
+
+		m_State = AStarSearch::SEARCH_STATE_SUCCEEDED;
+		return m_State;
+	}
+
+	m_Map.GetSuccessors(state, m_Successors, m_SuccessorCosts);
+
+	for (unsigned int i = 0; i < m_Successors.size(); i++) {
+		float newg = n.g + m_SuccessorCosts[i];
+		unsigned int &cellNode = GetCellNode(m_Successors[i]);
+
+		if (cellNode == NO_NODE) {
+			cellNode = AllocateNode(m_Successors[i], best.node, newg);
+			PushOpen(cellNode);
+			continue;
+		}
+
+		// Open or closed, the one we have is cheaper
+		if (m_Nodes[cellNode].g <= newg) {
+			continue;
+		}
+
+		// Reached more cheaply: update in place and (re)open it, the old
+		// open entry if any goes stale
+		m_Nodes[cellNode].g = newg;
+		m_Nodes[cellNode].parent = best.node;
+		PushOpen(cellNode);
+	}
+
+	return m_State;
+}
+
+unsigned int LayeredAStarSearch::AllocateNode(const LayeredMap::Cell &cell,
+		unsigned int parent, float g) {
+	Node node;
+	node.parent = parent;
+	node.cell = m_Map.GetIndex(cell);
+	node.g = g;
+	node.h = m_Map.GetHeuristic(cell, m_Goal);
+
+	m_Nodes.push_back(node);
+	return m_Nodes.size() - 1;
+}
+
+unsigned int &LayeredAStarSearch::GetCellNode(const LayeredMap::Cell &cell) {
+	std::vector<int32_t> &tiles = m_TileBlocks[cell.z];
+	if (tiles.empty()) {
+		tiles.assign(m_TilesX * m_TilesY, -1);
+	}
+
+	int tile = (cell.y >> TILE_SHIFT) * m_TilesX + (cell.x >> TILE_SHIFT);
+	if (tiles[tile] < 0) {
+		tiles[tile] = m_BlockCount++;
+		if (m_Blocks.size() < m_BlockCount * TILE_CELLS) {
+			m_Blocks.resize(m_BlockCount * TILE_CELLS);
+		}
+		std::fill(m_Blocks.begin() + tiles[tile] * TILE_CELLS,
+				m_Blocks.begin() + m_BlockCount * TILE_CELLS, NO_NODE);
+		m_ReachedTiles.push_back(std::make_pair(cell.z, tile));
+	}
+
+	int bit = ((cell.y & (TILE_SIZE - 1)) << TILE_SHIFT)
+			| (cell.x & (TILE_SIZE - 1));
+	return m_Blocks[tiles[tile] * TILE_CELLS + bit];
+}
+
+void LayeredAStarSearch::PushOpen(unsigned int node) {
+	OpenEntry entry;
+	entry.f = m_Nodes[node].g + m_Nodes[node].h;
+	entry.node = node;
+
+	m_OpenList.push_back(entry);
+	push_heap(m_OpenList.begin(), m_OpenList.end(), HeapCompare_f());
+}
+
+LayeredMap::Cell *LayeredAStarSearch::GetSolutionStart() {
+	m_CurrentSolutionNode = 0;
+	if (m_Solution.empty()) {
+		return NULL;
+	}
+	return &m_Solution[0];
+}
+
+LayeredMap::Cell *LayeredAStarSearch::GetSolutionNext() {
+	if (m_CurrentSolutionNode + 1 >= m_Solution.size()) {
+		return NULL;
+	}
+	return &m_Solution[++m_CurrentSolutionNode];
+}
+
+float LayeredAStarSearch::GetSolutionCost() {
+	return m_SolutionCost;
+}
+
+int LayeredAStarSearch::GetStepCount() {
+	return m_Steps;
+}
+
+int LayeredAStarSearch::GetNodeCount() {
+	return m_Nodes.size();
+}
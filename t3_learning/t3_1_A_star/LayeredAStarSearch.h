@@ -0,0 +1,112 @@
+/*
+ * LayeredAStarSearch.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef LAYEREDASTARSEARCH_H_
+#define LAYEREDASTARSEARCH_H_
+
+#include <stdint.h>
+
+#include <vector>
+#include <utility>
+#include <cfloat>
+
+#include "LayeredMap.h"
+
+// A* over a LayeredMap, laid out like CompactAStarSearch: nodes in one pool
+// linked by index, and a cell -> node table in place of list scans. The
+// table is kept per 8 x 8 tile, as LayeredMap keeps terrain, and a tile's
+// block of it is only taken when the search first reaches the tile. A layer
+// has a directory of its tiles once reached. Searches on a big, mostly empty
+// map so pay for the tiles they reach only, and the blocks are reused by
+// the next search.
+//
+// Uses the AStarSearch::SEARCH_STATE_* values.
+
+class LayeredAStarSearch {
+public:
+	static const unsigned int NO_NODE = 0xffffffffu;
+
+	class Node {
+	public:
+		unsigned int parent; // pool index of the parent, NO_NODE for the start
+		unsigned int cell; // LayeredMap::GetIndex of the cell
+		float g; // cost of this node + it's predecessors
+		float h; // heuristic estimate of distance to goal
+	};
+
+	LayeredAStarSearch(const LayeredMap &map);
+	virtual ~LayeredAStarSearch();
+
+	// Set Start and goal states. The search fails at once unless both are
+	// open cells of the map
+	void SetStartAndGoalStates(const LayeredMap::Cell &Start,
+			const LayeredMap::Cell &Goal);
+
+	// Advances search one step
+	unsigned int SearchStep();
+
+	// Functions for traversing the solution
+	LayeredMap::Cell *GetSolutionStart();
+	LayeredMap::Cell *GetSolutionNext();
+
+	// Get final cost of solution
+	// Returns FLT_MAX if there is no solution
+	float GetSolutionCost();
+
+	// Get the number of steps
+	int GetStepCount();
+
+	// Nodes allocated from the pool by this search
+	int GetNodeCount();
+
+private:
+	struct OpenEntry {
+		float f;
+		unsigned int node;
+	};
+
+	class HeapCompare_f {
+	public:
+		bool operator()(const OpenEntry &x, const OpenEntry &y) const;
+	};
+
+	unsigned int AllocateNode(const LayeredMap::Cell &cell,
+			unsigned int parent, float g);
+	void PushOpen(unsigned int node);
+	unsigned int &GetCellNode(const LayeredMap::Cell &cell);
+
+private:
+	const LayeredMap &m_Map;
+
+	std::vector<Node> m_Nodes;
+	std::vector<OpenEntry> m_OpenList;
+
+	// Pool index of the node for each cell, NO_NODE if not reached yet. Per
+	// layer the block of each tile, -1 for none, and the blocks, each a
+	// tile's cells in the bit order of LayeredMap's tile masks
+	int m_TilesX;
+	int m_TilesY;
+	std::vector<std::vector<int32_t> > m_TileBlocks;
+	std::vector<unsigned int> m_Blocks;
+	unsigned int m_BlockCount;
+
+	// Tiles given a block by this search, layer and tile
+	std::vector<std::pair<int, int> > m_ReachedTiles;
+
+	LayeredMap::Cell m_Goal;
+	unsigned int m_State;
+	int m_Steps;
+
+	std::vector<LayeredMap::Cell> m_Solution;
+	unsigned int m_CurrentSolutionNode;
+	float m_SolutionCost;
+
+	std::vector<LayeredMap::Cell> m_Successors;
+	std::vector<float> m_SuccessorCosts;
+};
+
+#endif /* LAYEREDASTARSEARCH_H_ */
@@ -0,0 +1,241 @@
+/*
+ * LayeredMap.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "LayeredMap.h"
+
+#include <assert.h>
+#include <math.h>
+
+#include <algorithm>
+
+using namespace std;
+
+static const int TILE_SHIFT = 3;
+static const int TILE_SIZE = 1 << TILE_SHIFT;
+
+static const float SQRT2 = 1.41421356237f;
+static const float SQRT3 = 1.73205080757f;
+
+LayeredMap::Cell::Cell() :
+		x(0), y(0), z(0) {
+}
+
+LayeredMap::Cell::Cell(int px, int py, int pz) :
+		x(px), y(py), z(pz) {
+}
+
+bool LayeredMap::Cell::operator==(const Cell &other) const {
+	return x == other.x && y == other.y && z == other.z;
+}
+
+bool LayeredMap::Portal::operator<(const Portal &other) const {
+	return from < other.from;
+}
+
+LayeredMap::LayeredMap(int width, int height, int layers) :
+		m_Width(width), m_Height(height),
+		m_TilesX((width + TILE_SIZE - 1) >> TILE_SHIFT),
+		m_TilesY((height + TILE_SIZE - 1) >> TILE_SHIFT),
+		m_Connectivity(CONNECT_4), m_Layers(layers) {
+	assert((double) width * height * layers < 4294967296.0);
+}
+
+LayeredMap::~LayeredMap() {
+}
+
+void LayeredMap::SetLayer(int z, const vector<int> &data) {
+	Layer &layer = m_Layers[z];
+	layer.tiles.assign(m_TilesX * m_TilesY, -1);
+	layer.masks.clear();
+	layer.ranks.clear();
+	layer.terrain.clear();
+
+	for (int tile = 0; tile < m_TilesX * m_TilesY; tile++) {
+		int x0 = (tile % m_TilesX) << TILE_SHIFT;
+		int y0 = (tile / m_TilesX) << TILE_SHIFT;
+
+		// Terrain is packed in bit order, so a cell's rank in the mask is its
+		// offset from the tile's first
+		uint64_t mask = 0;
+		uint32_t rank = layer.terrain.size();
+		for (int bit = 0; bit < TILE_SIZE * TILE_SIZE; bit++) {
+			int x = x0 + (bit & (TILE_SIZE - 1));
+			int y = y0 + (bit >> TILE_SHIFT);
+			if (x < m_Width && y < m_Height && data[y * m_Width + x] < 9) {
+				mask |= (uint64_t) 1 << bit;
+				layer.terrain.push_back(data[y * m_Width + x]);
+			}
+		}
+
+		if (mask) {
+			layer.tiles[tile] = layer.masks.size();
+			layer.masks.push_back(mask);
+			layer.ranks.push_back(rank);
+		}
+	}
+
+	if (layer.masks.empty()) {
+		layer.tiles.clear();
+	}
+}
+
+bool LayeredMap::AddPortal(const Cell &from, const Cell &to, float cost) {
+	if (!IsOpen(from.x, from.y, from.z) || !IsOpen(to.x, to.y, to.z)
+			|| cost < GetHeuristic(from, to)) {
+		return false;
+	}
+
+	Portal portal = { GetIndex(from), GetIndex(to), cost };
+	m_Portals.insert(upper_bound(m_Portals.begin(), m_Portals.end(), portal),
+			portal);
+	return true;
+}
+
+void LayeredMap::SetConnectivity(int connectivity) {
+	m_Connectivity = connectivity;
+}
+
+int LayeredMap::GetConnectivity() const {
+	return m_Connectivity;
+}
+
+int LayeredMap::GetWidth() const {
+	return m_Width;
+}
+
+int LayeredMap::GetHeight() const {
+	return m_Height;
+}
+
+int LayeredMap::GetLayerCount() const {
+	return m_Layers.size();
+}
+
+int LayeredMap::GetTerrain(int x, int y, int z) const {
+	if (x < 0 || x >= m_Width || y < 0 || y >= m_Height || z < 0
+			|| z >= (int) m_Layers.size()) {
+		return 9;
+	}
+
+	const Layer &layer = m_Layers[z];
+	if (layer.tiles.empty()) {
+		return 9;
+	}
+
+	int tile = layer.tiles[(y >> TILE_SHIFT) * m_TilesX + (x >> TILE_SHIFT)];
+	if (tile < 0) {
+		return 9;
+	}
+
+	int bit = ((y & (TILE_SIZE - 1)) << TILE_SHIFT) + (x & (TILE_SIZE - 1));
+	uint64_t mask = layer.masks[tile];
+	if (!((mask >> bit) & 1)) {
+		return 9;
+	}
+
+	uint64_t before = mask & (((uint64_t) 1 << bit) - 1);
+	return layer.terrain[layer.ranks[tile] + __builtin_popcountll(before)];
+}
+
+bool LayeredMap::IsOpen(int x, int y, int z) const {
+	return GetTerrain(x, y, z) < 9;
+}
+
+void LayeredMap::GetSuccessors(const Cell &cell, vector<Cell> &successors,
+		vector<float> &costs) const {
+	successors.clear();
+	costs.clear();
+
+	float terrain = GetTerrain(cell.x, cell.y, cell.z);
+	bool voxel = m_Connectivity == CONNECT_6 || m_Connectivity == CONNECT_26;
+	int maxAxes = (m_Connectivity == CONNECT_4 || m_Connectivity == CONNECT_6) ?
+			1 : 3;
+
+	for (int dz = voxel ? -1 : 0; dz <= (voxel ? 1 : 0); dz++) {
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				int axes = (dx != 0) + (dy != 0) + (dz != 0);
+				if (axes == 0 || axes > maxAxes
+						|| !IsMoveOpen(cell.x, cell.y, cell.z, dx, dy, dz)) {
+					continue;
+				}
+
+				successors.push_back(Cell(cell.x + dx, cell.y + dy, cell.z + dz));
+				costs.push_back(
+						terrain * (axes == 1 ? 1.0f : (axes == 2 ? SQRT2 : SQRT3)));
+			}
+		}
+	}
+
+	if (!m_Portals.empty()) {
+		Portal key = { GetIndex(cell), 0, 0.0f };
+		vector<Portal>::const_iterator portal = lower_bound(m_Portals.begin(),
+				m_Portals.end(), key);
+		for (; portal != m_Portals.end() && portal->from == key.from;
+				portal++) {
+			successors.push_back(GetCell(portal->to));
+			costs.push_back(portal->cost);
+		}
+	}
+}
+
+// Every cell the move passes, each combination of its axes, must be open
+bool LayeredMap::IsMoveOpen(int x, int y, int z, int dx, int dy,
+		int dz) const {
+	int axes = (dx != 0) | ((dy != 0) << 1) | ((dz != 0) << 2);
+
+	for (int part = 1; part < 8; part++) {
+		if ((part & axes) != part) {
+			continue;
+		}
+		if (!IsOpen(x + ((part & 1) ? dx : 0), y + ((part & 2) ? dy : 0),
+				z + ((part & 4) ? dz : 0))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Octile distance in as many dimensions as moves have, at the cheapest
+// terrain cost of 1. Layered maps leave the layers out, portals pay for those
+float LayeredMap::GetHeuristic(const Cell &a, const Cell &b) const {
+	float d[3] = { fabsf(a.x - b.x), fabsf(a.y - b.y), fabsf(a.z - b.z) };
+
+	switch (m_Connectivity) {
+	case CONNECT_4:
+		return d[0] + d[1];
+	case CONNECT_6:
+		return d[0] + d[1] + d[2];
+	case CONNECT_8:
+		return max(d[0], d[1]) + (SQRT2 - 1.0f) * min(d[0], d[1]);
+	default:
+		sort(d, d + 3);
+		return d[2] + (SQRT2 - 1.0f) * d[1] + (SQRT3 - SQRT2) * d[0];
+	}
+}
+
+unsigned int LayeredMap::GetIndex(const Cell &cell) const {
+	return ((unsigned int) cell.z * m_Height + cell.y) * m_Width + cell.x;
+}
+
+LayeredMap::Cell LayeredMap::GetCell(unsigned int index) const {
+	return Cell(index % m_Width, (index / m_Width) % m_Height,
+			index / m_Width / m_Height);
+}
+
+long LayeredMap::GetMemoryUsage() const {
+	long bytes = m_Portals.size() * sizeof(Portal);
+
+	for (unsigned int z = 0; z < m_Layers.size(); z++) {
+		const Layer &layer = m_Layers[z];
+		bytes += layer.tiles.size() * sizeof(int32_t)
+				+ layer.masks.size() * sizeof(uint64_t)
+				+ layer.ranks.size() * sizeof(uint32_t)
+				+ layer.terrain.size();
+	}
+	return bytes;
+}
@@ -0,0 +1,121 @@
+/*
+ * LayeredMap.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef LAYEREDMAP_H_
+#define LAYEREDMAP_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+// A map of several layers of width x height cells, either the floors of a
+// building joined by portals (stairs, lifts, ladders) or the slices of a
+// voxel world. Terrain costs follow Map: 1 to 8 passable, 9 and up blocked.
+//
+// Storage is sparse so mostly empty layers are cheap. Each layer is cut into
+// 8 x 8 tiles; a tile with no passable cell takes 4 bytes, any other a 64
+// bit mask of its passable cells, a running count of the passable cells
+// before it, and a byte of terrain per passable cell only. A layer with no
+// passable cell at all takes nothing.
+//
+// Moves within a layer follow CONNECT_4 or CONNECT_8, diagonals needing both
+// cells beside them open, and layers are joined only by portals. CONNECT_6
+// and CONNECT_26 treat the layers as a voxel grid instead, with moves up and
+// down between open cells as well, and again no corner cutting: a move may
+// only pass cells that are open. A move costs the terrain of the cell it
+// leaves times its length.
+//
+// Independent of Map and MapSearchNode, which 2D searches keep using as
+// before.
+
+class LayeredMap {
+public:
+	enum {
+		CONNECT_4, CONNECT_8, CONNECT_6, CONNECT_26
+	};
+
+	struct Cell {
+		Cell();
+		Cell(int px, int py, int pz);
+
+		bool operator==(const Cell &other) const;
+
+		int x;
+		int y;
+		int z; // layer
+	};
+
+	LayeredMap(int width, int height, int layers);
+	virtual ~LayeredMap();
+
+	// Replaces a layer with width x height terrain costs, row by row
+	void SetLayer(int z, const std::vector<int> &data);
+
+	// A one way link from an open cell to another. Its cost may not be less
+	// than the heuristic distance between them, or searches would lose
+	// optimality; such portals are refused
+	bool AddPortal(const Cell &from, const Cell &to, float cost);
+
+	void SetConnectivity(int connectivity);
+	int GetConnectivity() const;
+
+	int GetWidth() const;
+	int GetHeight() const;
+	int GetLayerCount() const;
+
+	// Terrain cost of the cell, 9 if blocked or off the map
+	int GetTerrain(int x, int y, int z) const;
+	bool IsOpen(int x, int y, int z) const;
+
+	// Open neighbours of an open cell and the cost of moving to each,
+	// portals included
+	void GetSuccessors(const Cell &cell, std::vector<Cell> &successors,
+			std::vector<float> &costs) const;
+
+	// Lower bound on the cost of a path between the two cells
+	float GetHeuristic(const Cell &a, const Cell &b) const;
+
+	// Index of the cell in a dense width x height x layers array
+	unsigned int GetIndex(const Cell &cell) const;
+	Cell GetCell(unsigned int index) const;
+
+	// Bytes of terrain storage, portals included
+	long GetMemoryUsage() const;
+
+private:
+	struct Layer {
+		// Per tile: index into the other vectors, or -1 for an empty tile
+		std::vector<int32_t> tiles;
+		std::vector<uint64_t> masks;
+		std::vector<uint32_t> ranks;
+		std::vector<unsigned char> terrain;
+	};
+
+	struct Portal {
+		unsigned int from;
+		unsigned int to;
+		float cost;
+
+		bool operator<(const Portal &other) const;
+	};
+
+	bool IsMoveOpen(int x, int y, int z, int dx, int dy, int dz) const;
+
+private:
+	int m_Width;
+	int m_Height;
+	int m_TilesX;
+	int m_TilesY;
+	int m_Connectivity;
+
+	std::vector<Layer> m_Layers;
+
+	// Sorted by source cell
+	std::vector<Portal> m_Portals;
+};
+
+#endif /* LAYEREDMAP_H_ */
@@ -0,0 +1,341 @@
+/*
+ * LazyThetaStarSearch.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "LazyThetaStarSearch.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "AStarSearch.h"
+#include "Map.h"
+#include "MapSnapshot.h"
+
+bool LazyThetaStarSearch::HeapCompare_f::operator ()(const OpenEntry &x,
+		const OpenEntry &y) const {
+	return x.f > y.f;
+}
+
+LazyThetaStarSearch::LazyThetaStarSearch() :
+		m_Width(0), m_Height(0), m_TerrainAgentSize(0), m_CurrentStamp(0),
+		m_StartCell(0), m_GoalCell(0), m_State(AStarSearch::SEARCH_STATE_NOT_INITIALISED), m_Steps(0),
+		m_LineOfSightChecks(0), m_LineOfSightFailures(0),
+		m_CurrentSolutionNode(0), m_SolutionCost(FLT_MAX) {
+}
+
+LazyThetaStarSearch::~LazyThetaStarSearch() {
+}
+
+void LazyThetaStarSearch::SetStartAndGoalStates(MapSearchNode &Start,
+		MapSearchNode &Goal, const MapSearchNode::Rules &rules) {
+	m_Rules = rules;
+
+	std::shared_ptr<const MapSnapshot> map = Map::GetSnapshot();
+	if (map != m_TerrainMap
+			|| m_Rules.agentSize != m_TerrainAgentSize) {
+		m_TerrainMap = map;
+		m_TerrainAgentSize = m_Rules.agentSize;
+		BuildTerrain();
+	}
+
+	Reset();
+	m_OpenList.clear();
+	m_Solution.clear();
+	m_SolutionCost = FLT_MAX;
+	m_Steps = 0;
+	m_LineOfSightChecks = 0;
+	m_LineOfSightFailures = 0;
+
+	if (!Start.IsOnMap() || !Goal.IsOnMap()) {
+		m_State = AStarSearch::SEARCH_STATE_FAILED;
+		return;
+	}
+
+	m_StartCell = Start.y * m_Width + Start.x;
+	m_GoalCell = Goal.y * m_Width + Goal.x;
+
+	// The start is its own parent
+	Open(m_StartCell, 0.0f, m_StartCell);
+
+	m_State = AStarSearch::SEARCH_STATE_SEARCHING;
+}
+
+unsigned int LazyThetaStarSearch::SearchStep() {
+	assert(
+			(m_State > AStarSearch::SEARCH_STATE_NOT_INITIALISED)
+					&& (m_State < AStarSearch::SEARCH_STATE_INVALID));
+
+	if (m_State != AStarSearch::SEARCH_STATE_SEARCHING) {
+		return m_State;
+	}
+
+	OpenEntry best;
+	do {
+		if (m_OpenList.empty()) {
+			m_State = AStarSearch::SEARCH_STATE_FAILED;
+			return m_State;
+		}
+
+		best = m_OpenList.front();
+		pop_heap(m_OpenList.begin(), m_OpenList.end(), HeapCompare_f());
+		m_OpenList.pop_back();
+	} while (IsClosed(best.cell) || best.g > m_G[best.cell]);
+
+	m_Steps++;
+
+	int s = best.cell;
+	SetVertex(s);
+	m_Closed[s] = m_CurrentStamp;
+
+	if (s == m_GoalCell) {
+		for (int c = s;; c = m_Parent[c]) {
+			m_Solution.push_back(MapSearchNode(c % m_Width, c / m_Width));
+			if (c == m_StartCell) {
+				break;
+			}
+		}
+		reverse(m_Solution.begin(), m_Solution.end());
+		m_SolutionCost = m_G[s];
+
+		m_State = AStarSearch::SEARCH_STATE_SUCCEEDED;
+		return m_State;
+	}
+
+	// Assume each successor can see our parent, SetVertex checks later. On
+	// mixed terrain the grid move from here can still be cheaper, and needs
+	// no check
+	int p = m_Parent[s];
+	MapSearchNode state(s % m_Width, s / m_Width);
+	state.GetSuccessors(NULL, m_SuccessorX, m_SuccessorY, m_Rules);
+
+	for (unsigned int i = 0; i < m_SuccessorX.size(); i++) {
+		int n = m_SuccessorY[i] * m_Width + m_SuccessorX[i];
+		if (IsClosed(n)) {
+			continue;
+		}
+
+		MapSearchNode successor(m_SuccessorX[i], m_SuccessorY[i]);
+		float g = m_G[p] + SegmentCost(p, n);
+		float gridG = m_G[s] + state.GetCost(successor, m_Rules);
+
+		if (gridG < g) {
+			if (gridG < GetG(n)) {
+				Open(n, gridG, s);
+			}
+		} else if (g < GetG(n)) {
+			Open(n, g, p);
+		}
+	}
+
+	return m_State;
+}
+
+// Called as a cell is expanded: if it cannot see the parent it was given,
+// take the best expanded grid neighbour as parent instead. One always exists,
+// the cell was reached from one
+void LazyThetaStarSearch::SetVertex(int cell) {
+	int p = m_Parent[cell];
+	if (p == cell || LineOfSight(p, cell)) {
+		return;
+	}
+
+	// Moves without the overlay are symmetric, so our successors are also
+	// our predecessors. The overlay let us onto this cell when it was opened
+	MapSearchNode::Rules moves = m_Rules;
+	moves.overlay = NULL;
+
+	MapSearchNode state(cell % m_Width, cell / m_Width);
+	state.GetSuccessors(NULL, m_SuccessorX, m_SuccessorY, moves);
+
+	m_G[cell] = FLT_MAX;
+	for (unsigned int i = 0; i < m_SuccessorX.size(); i++) {
+		int n = m_SuccessorY[i] * m_Width + m_SuccessorX[i];
+		if (!IsClosed(n)) {
+			continue;
+		}
+
+		MapSearchNode neighbour(m_SuccessorX[i], m_SuccessorY[i]);
+		float g = m_G[n] + neighbour.GetCost(state, moves);
+		if (g < m_G[cell]) {
+			m_G[cell] = g;
+			m_Parent[cell] = n;
+		}
+	}
+}
+
+// Bresenham from one cell to the other. Every cell stepped onto before the
+// end must be clear and free of units, and on a diagonal step the corner
+// rule decides which of the two cells beside the corner must be clear too
+bool LazyThetaStarSearch::LineOfSight(int from, int to) {
+	m_LineOfSightChecks++;
+
+	int x = from % m_Width;
+	int y = from / m_Width;
+	int x1 = to % m_Width;
+	int y1 = to / m_Width;
+	int limit = GetTerrain(x, y);
+
+	int dx = abs(x1 - x);
+	int dy = -abs(y1 - y);
+	int sx = x < x1 ? 1 : -1;
+	int sy = y < y1 ? 1 : -1;
+	int err = dx + dy;
+
+	int cornerRule = m_Rules.cornerRule;
+	if (m_Rules.connectivity == MapSearchNode::CONNECT_4) {
+		cornerRule = MapSearchNode::CORNER_CUT_FORBIDDEN;
+	}
+
+	for (;;) {
+		int e2 = 2 * err;
+		bool stepX = e2 >= dy;
+		bool stepY = e2 <= dx;
+
+		if (stepX && stepY
+				&& cornerRule != MapSearchNode::CORNER_CUT_ALLOWED) {
+			int blocked = !IsClear(x + sx, y, limit)
+					+ !IsClear(x, y + sy, limit);
+
+			if (blocked == 2
+					|| (blocked == 1
+							&& cornerRule
+									== MapSearchNode::CORNER_CUT_FORBIDDEN)) {
+				m_LineOfSightFailures++;
+				return false;
+			}
+		}
+
+		if (stepX) {
+			err += dy;
+			x += sx;
+		}
+		if (stepY) {
+			err += dx;
+			y += sy;
+		}
+
+		if (x == x1 && y == y1) {
+			return true;
+		}
+
+		MapSearchNode cell(x, y);
+		if (!IsClear(x, y, limit) || cell.IsOccupied(m_Rules)) {
+			m_LineOfSightFailures++;
+			return false;
+		}
+	}
+}
+
+bool LazyThetaStarSearch::IsClear(int x, int y, int limit) const {
+	return GetTerrain(x, y) < 9 && GetTerrain(x, y) <= limit;
+}
+
+float LazyThetaStarSearch::SegmentCost(int from, int to) const {
+	return Distance(from, to) * GetTerrain(from % m_Width, from / m_Width);
+}
+
+float LazyThetaStarSearch::Distance(int from, int to) const {
+	float dx = (float) (from % m_Width - to % m_Width);
+	float dy = (float) (from / m_Width - to / m_Width);
+	return sqrtf(dx * dx + dy * dy);
+}
+
+int LazyThetaStarSearch::GetTerrain(int x, int y) const {
+	return m_Terrain[(y + 1) * (m_Width + 2) + x + 1];
+}
+
+// Cells the agent does not fit in count as blocked
+void LazyThetaStarSearch::BuildTerrain() {
+	m_Width = m_TerrainMap->GetWidth();
+	m_Height = m_TerrainMap->GetHeight();
+
+	m_Terrain.assign((m_Width + 2) * (m_Height + 2), 9);
+	for (int y = 0; y < m_Height; y++) {
+		for (int x = 0; x < m_Width; x++) {
+			if (m_TerrainMap->GetClearance(x, y) >= m_TerrainAgentSize) {
+				m_Terrain[(y + 1) * (m_Width + 2) + x + 1] = std::min(
+						m_TerrainMap->GetMap(x, y), 9);
+			}
+		}
+	}
+}
+
+void LazyThetaStarSearch::Reset() {
+	int cells = m_Width * m_Height;
+
+	if ((int) m_Stamp.size() != cells) {
+		m_G.assign(cells, FLT_MAX);
+		m_Parent.assign(cells, -1);
+		m_Stamp.assign(cells, 0);
+		m_Closed.assign(cells, 0);
+		m_CurrentStamp = 0;
+	}
+
+	// A new stamp invalidates everything the last search touched
+	m_CurrentStamp++;
+	if (m_CurrentStamp == 0) {
+		m_Stamp.assign(cells, 0);
+		m_Closed.assign(cells, 0);
+		m_CurrentStamp = 1;
+	}
+}
+
+bool LazyThetaStarSearch::IsCurrent(int cell) const {
+	return m_Stamp[cell] == m_CurrentStamp;
+}
+
+bool LazyThetaStarSearch::IsClosed(int cell) const {
+	return m_Closed[cell] == m_CurrentStamp;
+}
+
+float LazyThetaStarSearch::GetG(int cell) const {
+	return IsCurrent(cell) ? m_G[cell] : FLT_MAX;
+}
+
+void LazyThetaStarSearch::Open(int cell, float g, int parent) {
+	m_Stamp[cell] = m_CurrentStamp;
+	m_G[cell] = g;
+	m_Parent[cell] = parent;
+
+	OpenEntry entry;
+	entry.f = g + Distance(cell, m_GoalCell);
+	entry.g = g;
+	entry.cell = cell;
+
+	m_OpenList.push_back(entry);
+	push_heap(m_OpenList.begin(), m_OpenList.end(), HeapCompare_f());
+}
+
+MapSearchNode *LazyThetaStarSearch::GetSolutionStart() {
+	m_CurrentSolutionNode = 0;
+	if (m_Solution.empty()) {
+		return NULL;
+	}
+	return &m_Solution[0];
+}
+
+MapSearchNode *LazyThetaStarSearch::GetSolutionNext() {
+	if (m_CurrentSolutionNode + 1 >= m_Solution.size()) {
+		return NULL;
+	}
+	return &m_Solution[++m_CurrentSolutionNode];
+}
+
+float LazyThetaStarSearch::GetSolutionCost() {
+	return m_SolutionCost;
+}
+
+int LazyThetaStarSearch::GetStepCount() {
+	return m_Steps;
+}
+
+int LazyThetaStarSearch::GetLineOfSightChecks() {
+	return m_LineOfSightChecks;
+}
+
+int LazyThetaStarSearch::GetLineOfSightFailures() {
+	return m_LineOfSightFailures;
+}
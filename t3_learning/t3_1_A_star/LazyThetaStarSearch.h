@@ -0,0 +1,126 @@
+/*
+ * LazyThetaStarSearch.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef LAZYTHETASTARSEARCH_H_
+#define LAZYTHETASTARSEARCH_H_
+
+#include <memory>
+#include <vector>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+class MapSnapshot;
+
+// Any-angle search (Lazy Theta*). Expands the same grid successors as
+// AStarSearch, but a node may take its grandparent as parent when the
+// straight line between them is clear, so the solution is a short list of
+// waypoints joined by straight segments rather than every cell on the way.
+// As in Lazy Theta* the line is only walked when the node is expanded, not
+// each time it is reached.
+//
+// A segment costs its euclidean length times the terrain value of the cell
+// it starts from, and is clear when every cell the line crosses is passable
+// and no more expensive than that, and no unit in the overlay holds it.
+// Diagonal steps of the line obey the MapSearchNode corner rule (no corner
+// cutting with 4-connected movement).
+// Paths are short, but not guaranteed optimal: on mixed terrain they can cost
+// a little more than the best grid path.
+//
+// Uses the AStarSearch::SEARCH_STATE_* values.
+
+class LazyThetaStarSearch {
+public:
+	LazyThetaStarSearch();
+	virtual ~LazyThetaStarSearch();
+
+	// Set Start and goal states, and the rules to move by, the defaults as
+	// they are now unless given
+	void SetStartAndGoalStates(MapSearchNode &Start, MapSearchNode &Goal,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Advances search one step
+	unsigned int SearchStep();
+
+	// Functions for traversing the waypoints, start and goal included
+	MapSearchNode *GetSolutionStart();
+	MapSearchNode *GetSolutionNext();
+
+	// Get final cost of solution
+	// Returns FLT_MAX if there is no solution
+	float GetSolutionCost();
+
+	// Get the number of steps
+	int GetStepCount();
+
+	// Lines of sight walked, and how many of them were blocked
+	int GetLineOfSightChecks();
+	int GetLineOfSightFailures();
+
+private:
+	// An entry whose g is above the cell's current g has been superseded
+	struct OpenEntry {
+		float f;
+		float g;
+		int cell;
+	};
+
+	class HeapCompare_f {
+	public:
+		bool operator()(const OpenEntry &x, const OpenEntry &y) const;
+	};
+
+	void BuildTerrain();
+	void Reset();
+	bool IsCurrent(int cell) const;
+	bool IsClosed(int cell) const;
+	float GetG(int cell) const;
+	void Open(int cell, float g, int parent);
+	void SetVertex(int cell);
+	bool LineOfSight(int from, int to);
+	bool IsClear(int x, int y, int limit) const;
+	float SegmentCost(int from, int to) const;
+	float Distance(int from, int to) const;
+	int GetTerrain(int x, int y) const;
+
+private:
+	int m_Width;
+	int m_Height;
+
+	// Terrain of every cell in a byte, with a border of blocked cells so the
+	// line walk needs no bounds checks. Kept for the next search while the
+	// map and agent size stay the same
+	std::vector<unsigned char> m_Terrain;
+	std::shared_ptr<const MapSnapshot> m_TerrainMap;
+	int m_TerrainAgentSize;
+
+	// A cell's g and parent are only valid while its stamp matches the
+	// current search, and it is closed while its closed stamp does
+	std::vector<float> m_G;
+	std::vector<int> m_Parent;
+	std::vector<unsigned int> m_Stamp;
+	std::vector<unsigned int> m_Closed;
+	unsigned int m_CurrentStamp;
+	std::vector<OpenEntry> m_OpenList;
+
+	MapSearchNode::Rules m_Rules;
+	int m_StartCell;
+	int m_GoalCell;
+	unsigned int m_State;
+	int m_Steps;
+	int m_LineOfSightChecks;
+	int m_LineOfSightFailures;
+
+	std::vector<MapSearchNode> m_Solution;
+	unsigned int m_CurrentSolutionNode;
+	float m_SolutionCost;
+
+	std::vector<int> m_SuccessorX;
+	std::vector<int> m_SuccessorY;
+};
+
+#endif /* LAZYTHETASTARSEARCH_H_ */
@@ -7,7 +7,25 @@
 
 #include "Map.h"
 
-std::vector<int> world_map(MAP_WIDTH * MAP_HEIGHT);
+#include <atomic>
+#include <mutex>
+
+#include "MapSnapshot.h"
+
+// The world map, and the snapshot each thread has bound instead, if any.
+// A thread that has not bound one reads its own reference to the world map,
+// taken again whenever world_generation shows it has been replaced, so a
+// replacement never frees a map another thread is still reading
+std::mutex world_mutex;
+std::shared_ptr<const MapSnapshot> world_map = std::make_shared<
+		const MapSnapshot>(MAP_WIDTH, MAP_HEIGHT,
+		std::vector<int>(MAP_WIDTH * MAP_HEIGHT));
+std::atomic<unsigned int> world_generation(1);
+thread_local std::shared_ptr<const MapSnapshot> held_world;
+thread_local unsigned int held_generation = 0;
+thread_local const std::shared_ptr<const MapSnapshot> *bound_snapshot = NULL;
+thread_local const MapSnapshot *bound_map = NULL;
+
 int auxMap[] = {
 
 // 0001020304050607080910111213141516171819
@@ -34,24 +52,93 @@ int auxMap[] = {
 
 		};
 
-Map::Map() {
-	for (int i = 0; i < MAP_WIDTH * MAP_WIDTH; i++) {
-		world_map[i] = auxMap[i];
+static const MapSnapshot *HoldWorldMap() {
+	std::lock_guard<std::mutex> lock(world_mutex);
+	held_world = world_map;
+	held_generation = world_generation.load(std::memory_order_relaxed);
+	return held_world.get();
+}
+
+static const MapSnapshot *CurrentMap() {
+	if (bound_map) {
+		return bound_map;
+	}
+	if (held_generation != world_generation.load(std::memory_order_acquire)) {
+		return HoldWorldMap();
 	}
+	return held_world.get();
+}
+
+Map::Map() {
+	SetWorldMap(MAP_WIDTH, MAP_HEIGHT,
+			std::vector<int>(auxMap, auxMap + MAP_WIDTH * MAP_HEIGHT));
 }
 
 Map::~Map() {
 
 }
 
+// These are the hottest calls of every search, so they read the snapshot
+// themselves rather than call it
 int Map::GetMap(int x, int y) {
-	if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT) {
+	const MapSnapshot *map = CurrentMap();
+	if (x < 0 || x >= map->m_Width || y < 0 || y >= map->m_Height) {
 		return 9;
 	}
 
-	return world_map[(y * MAP_WIDTH) + x];
+	return map->m_Data[(y * map->m_Width) + x];
 }
 
-std::vector<int> Map::getWorldMap() {
+int Map::GetWidth() {
+	return CurrentMap()->GetWidth();
+}
+
+int Map::GetHeight() {
+	return CurrentMap()->GetHeight();
+}
+
+void Map::SetWorldMap(int width, int height, const std::vector<int>& data) {
+	std::shared_ptr<const MapSnapshot> snapshot = std::make_shared<
+			const MapSnapshot>(width, height, data);
+
+	std::lock_guard<std::mutex> lock(world_mutex);
+	world_map.swap(snapshot);
+	world_generation.fetch_add(1, std::memory_order_release);
+}
+
+int Map::GetClearance(int x, int y) {
+	const MapSnapshot *map = CurrentMap();
+	if (x < 0 || x >= map->m_Width || y < 0 || y >= map->m_Height) {
+		return 0;
+	}
+
+	return map->m_Clearance[(y * map->m_Width) + x];
+}
+
+bool Map::IsCurrent(const MapSnapshot *snapshot) {
+	return CurrentMap() == snapshot;
+}
+
+std::shared_ptr<const MapSnapshot> Map::GetSnapshot() {
+	if (bound_snapshot) {
+		return *bound_snapshot;
+	}
+
+	std::lock_guard<std::mutex> lock(world_mutex);
 	return world_map;
 }
+
+Map::SnapshotScope::SnapshotScope(std::shared_ptr<const MapSnapshot> snapshot) :
+		m_Snapshot(std::move(snapshot)), m_Previous(bound_snapshot) {
+	bound_snapshot = &m_Snapshot;
+	bound_map = m_Snapshot.get();
+}
+
+Map::SnapshotScope::~SnapshotScope() {
+	bound_snapshot = m_Previous;
+	bound_map = m_Previous ? m_Previous->get() : NULL;
+}
+
+std::vector<int> Map::getWorldMap() {
+	return CurrentMap()->GetData();
+}
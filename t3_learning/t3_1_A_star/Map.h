@@ -8,18 +8,71 @@
 #ifndef MAP_H_
 #define MAP_H_
 
+#include <memory>
 #include <vector>
 
-// The world map, map data in Map.cpp
+class MapSnapshot;
+
+// The world map, map data in Map.cpp. Searches read the map through the
+// static calls below, which give the world map unless the thread has bound
+// a snapshot of its own with a SnapshotScope. Threads that each bind their
+// own snapshot so search different maps at once.
+//
+// The world map itself is a snapshot that SetWorldMap replaces. A thread
+// reading it unbound keeps the world map it last read alive, and moves on
+// to the replacement at its next Map call, so a replacement never frees a
+// map under a reader. A search that must see one map throughout while the
+// world map may be replaced binds a snapshot first, as PathQueryPool does.
+// Each search has its own movement rules, edge cost table and overlay, see
+// MapSearchNode::Rules.
 
 const int MAP_WIDTH = 20;
 const int MAP_HEIGHT = 20;
 
+const int MAX_CLEARANCE = 255;
+
 class Map {
 public:
 	Map();
 	virtual ~Map();
 	static int GetMap(int x, int y);
+	static int GetWidth();
+	static int GetHeight();
+
+	// Replaces the world map with a width x height grid of terrain costs,
+	// stored row by row like the built-in map
+	static void SetWorldMap(int width, int height,
+			const std::vector<int>& data);
+
+	// Side of the largest passable square with its top left corner at (x, y),
+	// 0 for blocked cells and off the map, capped at MAX_CLEARANCE. An agent
+	// of size n, occupying n x n cells from its position, fits where this is
+	// at least n. Kept up to date whenever the world map is replaced
+	static int GetClearance(int x, int y);
+
+	// The map this thread's Map calls read, its bound snapshot or the world
+	// map as it is now, unchanged for as long as it is held. Threads a search
+	// starts bind it so they search the same map
+	static std::shared_ptr<const MapSnapshot> GetSnapshot();
+
+	// Whether this thread's Map calls read the given snapshot
+	static bool IsCurrent(const MapSnapshot *snapshot);
+
+	// While one lives the thread's Map calls read its snapshot. Scopes nest,
+	// the innermost wins
+	class SnapshotScope {
+	public:
+		SnapshotScope(std::shared_ptr<const MapSnapshot> snapshot);
+		virtual ~SnapshotScope();
+
+		SnapshotScope(const SnapshotScope &) = delete;
+		SnapshotScope &operator=(const SnapshotScope &) = delete;
+
+	private:
+		std::shared_ptr<const MapSnapshot> m_Snapshot;
+		const std::shared_ptr<const MapSnapshot> *m_Previous;
+	};
+
 	std::vector<int> getWorldMap();
 };
 
@@ -0,0 +1,339 @@
+/*
+ * MapGenerator.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "MapGenerator.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+
+using namespace std;
+
+const int MapGenerator::ROOM_SIZE;
+
+static const char *KIND_NAMES[MapGenerator::MAP_KINDS] = { "maze", "rooms",
+		"random", "open" };
+
+// Maze cells one step apart in each direction, and the direction back
+static const int STEP_X[4] = { -1, 0, 1, 0 };
+static const int STEP_Y[4] = { 0, -1, 0, 1 };
+static const int STEP_BACK[4] = { 2, 3, 0, 1 };
+
+// Marks for the region search
+static const unsigned char UNSEEN = 0;
+static const unsigned char SEEN = 1;
+static const unsigned char LARGEST = 2;
+
+// Cells of the 4-connected open region around the start, marked with mark
+// where they were marked UNSEEN
+static long MarkRegion(int size, const vector<int> &data,
+		vector<unsigned char> &marks, long start, unsigned char mark) {
+	deque<long> open;
+	long cells = 1;
+
+	marks[start] = mark;
+	open.push_back(start);
+	while (!open.empty()) {
+		long c = open.front();
+		open.pop_front();
+		int x = c % size;
+		int y = c / size;
+
+		for (int d = 0; d < 4; d++) {
+			int nx = x + STEP_X[d];
+			int ny = y + STEP_Y[d];
+			long n = (long) ny * size + nx;
+			if (nx >= 0 && nx < size && ny >= 0 && ny < size && data[n] < 9
+					&& marks[n] == UNSEEN) {
+				marks[n] = mark;
+				open.push_back(n);
+				cells++;
+			}
+		}
+	}
+	return cells;
+}
+
+const char *MapGenerator::GetKindName(int kind) {
+	return kind >= 0 && kind < MAP_KINDS ? KIND_NAMES[kind] : "unknown";
+}
+
+int MapGenerator::GetKind(const char *name) {
+	for (int kind = 0; kind < MAP_KINDS; kind++) {
+		if (strcmp(name, KIND_NAMES[kind]) == 0) {
+			return kind;
+		}
+	}
+	return -1;
+}
+
+void MapGenerator::Generate(int kind, int size, unsigned int seed,
+		vector<int> &data) {
+	// A generator of our own, the same everywhere, rather than the C one
+	mt19937 random(seed);
+	data.assign((long) size * size, 9);
+
+	switch (kind) {
+	case MAP_MAZE:
+		MakeMaze(size, random, data);
+		break;
+	case MAP_ROOMS:
+		MakeRooms(size, random, data);
+		break;
+	case MAP_RANDOM:
+		MakeRandom(size, random, data);
+		break;
+	default:
+		MakeOpen(size, random, data);
+		break;
+	}
+}
+
+void MapGenerator::MakeMaze(int size, mt19937 &random,
+		vector<int> &data) {
+	// Maze cell (i, j) is map cell (2i + 1, 2j + 1), the cells between them
+	// walls until a passage is carved through. The depth first search
+	// remembers the way back in a byte per maze cell instead of a stack
+	int cells = (size - 1) / 2;
+	if (cells <= 0) {
+		return;
+	}
+
+	const unsigned char UNVISITED = 4;
+	const unsigned char ROOT = 5;
+	vector<unsigned char> back((long) cells * cells, UNVISITED);
+
+	int i = random() % cells;
+	int j = random() % cells;
+	back[(long) j * cells + i] = ROOT;
+	data[(long) (2 * j + 1) * size + 2 * i + 1] = 1;
+
+	for (;;) {
+		int next[4];
+		int count = 0;
+		for (int d = 0; d < 4; d++) {
+			int ni = i + STEP_X[d];
+			int nj = j + STEP_Y[d];
+			if (ni >= 0 && ni < cells && nj >= 0 && nj < cells
+					&& back[(long) nj * cells + ni] == UNVISITED) {
+				next[count++] = d;
+			}
+		}
+
+		if (count == 0) {
+			unsigned char d = back[(long) j * cells + i];
+			if (d == ROOT) {
+				break;
+			}
+			i += STEP_X[d];
+			j += STEP_Y[d];
+			continue;
+		}
+
+		int d = next[random() % count];
+		int wx = 2 * i + 1 + STEP_X[d];
+		int wy = 2 * j + 1 + STEP_Y[d];
+		data[(long) wy * size + wx] = 1;
+		i += STEP_X[d];
+		j += STEP_Y[d];
+		back[(long) j * cells + i] = STEP_BACK[d];
+		data[(long) (2 * j + 1) * size + 2 * i + 1] = 1;
+	}
+
+	// Knock through some of the walls left between maze cells
+	for (int y = 1; y < 2 * cells; y++) {
+		for (int x = 1 + y % 2; x < 2 * cells; x += 2) {
+			long c = (long) y * size + x;
+			if (data[c] == 9 && random() % 20 == 0) {
+				data[c] = 1;
+			}
+		}
+	}
+}
+
+void MapGenerator::MakeRooms(int size, mt19937 &random,
+		vector<int> &data) {
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			bool wall = x % ROOM_SIZE == 0 || y % ROOM_SIZE == 0;
+			data[(long) y * size + x] = wall ? 9 : 1 + random() % 4;
+		}
+	}
+
+	for (int y = 0; y < size; y += ROOM_SIZE) {
+		for (int x = 0; x < size; x += ROOM_SIZE) {
+			for (int side = 0; side < 2; side++) {
+				int offset = 1 + random() % (ROOM_SIZE - 2);
+				bool shut = random() % 4 == 0;
+
+				for (int k = offset; k < offset + 2; k++) {
+					int dx = side ? k : ROOM_SIZE;
+					int dy = side ? ROOM_SIZE : k;
+					if (!shut && x + dx < size && y + dy < size) {
+						data[(long) (y + dy) * size + x + dx] = 1
+								+ random() % 4;
+					}
+				}
+			}
+		}
+	}
+}
+
+void MapGenerator::MakeRandom(int size, mt19937 &random,
+		vector<int> &data) {
+	for (long i = 0; i < (long) size * size; i++) {
+		data[i] = (random() % 100 < 20) ? 9 : 1 + random() % 4;
+	}
+}
+
+void MapGenerator::MakeOpen(int size, mt19937 &random,
+		vector<int> &data) {
+	fill(data.begin(), data.end(), 1);
+
+	// Walls are thin and up to 64 cells long, rough ground comes in blocks,
+	// one of either per 1024 cells
+	long rectangles = max(1L, (long) size * size / 1024);
+	for (long i = 0; i < rectangles; i++) {
+		bool wall = random() % 4 == 0;
+		int w = wall ? 1 + random() % 64 : 4 + random() % 32;
+		int h = wall ? 1 : 4 + random() % 32;
+		if (wall && random() % 2) {
+			swap(w, h);
+		}
+		int terrain = wall ? 9 : 2 + random() % 3;
+
+		int x0 = random() % size;
+		int y0 = random() % size;
+		for (int y = y0; y < min(size, y0 + h); y++) {
+			for (int x = x0; x < min(size, x0 + w); x++) {
+				data[(long) y * size + x] = terrain;
+			}
+		}
+	}
+}
+
+void MapGenerator::GenerateQueries(int size, const vector<int> &data,
+		int count, unsigned int seed, vector<MapSearchNode> &starts,
+		vector<MapSearchNode> &goals) {
+	starts.clear();
+	goals.clear();
+
+	// Find the largest region, then mark it apart from the rest
+	vector<unsigned char> marks(data.size(), UNSEEN);
+	long largest = -1;
+	long largestCells = 0;
+	for (long c = 0; c < (long) data.size(); c++) {
+		if (data[c] < 9 && marks[c] == UNSEEN) {
+			long cells = MarkRegion(size, data, marks, c, SEEN);
+			if (cells > largestCells) {
+				largest = c;
+				largestCells = cells;
+			}
+		}
+	}
+	if (largest < 0) {
+		return;
+	}
+	fill(marks.begin(), marks.end(), UNSEEN);
+	MarkRegion(size, data, marks, largest, LARGEST);
+
+	mt19937 random(seed);
+	vector<MapSearchNode> *ends[2] = { &starts, &goals };
+	while ((int) goals.size() < count) {
+		for (int e = 0; e < 2; e++) {
+			int x, y;
+			do {
+				x = random() % size;
+				y = random() % size;
+			} while (marks[(long) y * size + x] != LARGEST);
+			ends[e]->push_back(MapSearchNode(x, y));
+		}
+	}
+}
+
+bool MapGenerator::Save(const char *fileName, int width, int height,
+		const vector<int> &data) {
+	FILE *file = fopen(fileName, "w");
+	if (!file) {
+		return false;
+	}
+
+	// Terrain costs are single digits, so a row is written in one go
+	vector<char> row(2 * width);
+	bool ok = fprintf(file, "%d %d\n", width, height) > 0;
+	for (int y = 0; ok && y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			row[2 * x] = '0' + data[(long) y * width + x] % 10;
+			row[2 * x + 1] = ' ';
+		}
+		row[2 * width - 1] = '\n';
+		ok = fwrite(&row[0], 1, 2 * width, file) == (size_t) (2 * width);
+	}
+	return fclose(file) == 0 && ok;
+}
+
+bool MapGenerator::Load(const char *fileName, int &width, int &height,
+		vector<int> &data) {
+	FILE *file = fopen(fileName, "r");
+	if (!file) {
+		return false;
+	}
+
+	bool ok = fscanf(file, "%d %d", &width, &height) == 2 && width > 0
+			&& height > 0 && width <= 0x10000 && height <= 0x10000;
+
+	data.clear();
+	for (long i = 0; ok && i < (long) width * height; i++) {
+		int value;
+		ok = fscanf(file, "%d", &value) == 1;
+		data.push_back(value);
+	}
+	fclose(file);
+	return ok;
+}
+
+bool MapGenerator::SaveQueries(const char *fileName,
+		const vector<MapSearchNode> &starts,
+		const vector<MapSearchNode> &goals) {
+	FILE *file = fopen(fileName, "w");
+	if (!file) {
+		return false;
+	}
+
+	bool ok = fprintf(file, "%d\n", (int) starts.size()) > 0;
+	for (unsigned int i = 0; ok && i < starts.size(); i++) {
+		ok = fprintf(file, "%d %d %d %d\n", starts[i].x, starts[i].y,
+				goals[i].x, goals[i].y) > 0;
+	}
+	return fclose(file) == 0 && ok;
+}
+
+bool MapGenerator::LoadQueries(const char *fileName,
+		vector<MapSearchNode> &starts, vector<MapSearchNode> &goals) {
+	FILE *file = fopen(fileName, "r");
+	if (!file) {
+		return false;
+	}
+
+	int count;
+	bool ok = fscanf(file, "%d", &count) == 1 && count >= 0;
+
+	starts.clear();
+	goals.clear();
+	for (int i = 0; ok && i < count; i++) {
+		MapSearchNode start, goal;
+		ok = fscanf(file, "%d %d %d %d", &start.x, &start.y, &goal.x, &goal.y)
+				== 4;
+		starts.push_back(start);
+		goals.push_back(goal);
+	}
+	fclose(file);
+	return ok;
+}
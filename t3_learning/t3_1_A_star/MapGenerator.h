@@ -0,0 +1,79 @@
+/*
+ * MapGenerator.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef MAPGENERATOR_H_
+#define MAPGENERATOR_H_
+
+#include <random>
+#include <vector>
+
+#include "MapSearchNode.h"
+
+// Synthetic square maps for benchmarking, any size from a few cells to
+// 16384 x 16384 and up, made the same for the same seed on any platform:
+//
+// MAP_MAZE: one cell passages of cost 1 between one cell walls, a perfect
+// maze with 1 in 20 of its inner walls knocked through so routes can loop.
+// MAP_ROOMS: rooms of ROOM_SIZE cells of terrain costs 1 to 4, each with a
+// two cell door at a random place in its right and bottom walls, a quarter
+// of them shut.
+// MAP_RANDOM: 20% walls over terrain costs 1 to 4.
+// MAP_OPEN: cost 1 ground under rectangles of rough ground, costs 2 to 4,
+// and a few of walls.
+//
+// Queries join random cells of the largest 4-connected region, so every
+// goal is reachable under any movement rule for an agent of size 1.
+//
+// Maps are saved as text, the width and height and then every terrain
+// value, row by row, the format path_daemon reads. Queries are saved as
+// their count and then one line of start x, y and goal x, y each.
+
+class MapGenerator {
+public:
+	enum {
+		MAP_MAZE, MAP_ROOMS, MAP_RANDOM, MAP_OPEN, MAP_KINDS
+	};
+
+	static const int ROOM_SIZE = 16;
+
+	// The name of a kind, "maze", "rooms", "random" or "open", and back, -1
+	// for an unknown name
+	static const char *GetKindName(int kind);
+	static int GetKind(const char *name);
+
+	// A size x size map of the kind, row by row
+	static void Generate(int kind, int size, unsigned int seed,
+			std::vector<int> &data);
+
+	static void GenerateQueries(int size, const std::vector<int> &data,
+			int count, unsigned int seed, std::vector<MapSearchNode> &starts,
+			std::vector<MapSearchNode> &goals);
+
+	static bool Save(const char *fileName, int width, int height,
+			const std::vector<int> &data);
+	static bool Load(const char *fileName, int &width, int &height,
+			std::vector<int> &data);
+
+	static bool SaveQueries(const char *fileName,
+			const std::vector<MapSearchNode> &starts,
+			const std::vector<MapSearchNode> &goals);
+	static bool LoadQueries(const char *fileName,
+			std::vector<MapSearchNode> &starts,
+			std::vector<MapSearchNode> &goals);
+
+private:
+	static void MakeMaze(int size, std::mt19937 &random,
+			std::vector<int> &data);
+	static void MakeRooms(int size, std::mt19937 &random,
+			std::vector<int> &data);
+	static void MakeRandom(int size, std::mt19937 &random,
+			std::vector<int> &data);
+	static void MakeOpen(int size, std::mt19937 &random,
+			std::vector<int> &data);
+};
+
+#endif /* MAPGENERATOR_H_ */
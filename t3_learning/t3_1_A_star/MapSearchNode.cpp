@@ -7,12 +7,42 @@
 
 #include "MapSearchNode.h"
 
+#include "EdgeCostTable.h"
 #include "Map.h"
+#include "ObstacleOverlay.h"
 
+#include <atomic>
 #include <cmath>
 #include <iostream>
 using namespace std;
 
+const float SQRT2 = 1.41421356f;
+
+// The four orthogonal moves first, in the order they have always been
+// generated, then the diagonals
+const int MOVE_X[8] = { -1, 0, 1, 0, -1, 1, 1, -1 };
+const int MOVE_Y[8] = { 0, -1, 0, 1, -1, -1, 1, 1 };
+
+// The defaults each search copies when it starts, atomic as any thread may
+// start one while another sets them
+atomic<int> movement_connectivity(MapSearchNode::CONNECT_4);
+atomic<int> movement_corner_rule(MapSearchNode::CORNER_CUT_FORBIDDEN);
+atomic<int> agent_size(1);
+atomic<const EdgeCostTable *> edge_costs(NULL);
+atomic<const ObstacleOverlay *> obstacle_overlay(NULL);
+
+MapSearchNode::Rules::Rules() :
+		connectivity(movement_connectivity.load()),
+		cornerRule(movement_corner_rule.load()), agentSize(agent_size.load()),
+		edgeCosts(edge_costs.load()), overlay(obstacle_overlay.load()) {
+}
+
+bool MapSearchNode::Rules::operator==(const Rules &rhs) const {
+	return connectivity == rhs.connectivity && cornerRule == rhs.cornerRule
+			&& agentSize == rhs.agentSize && edgeCosts == rhs.edgeCosts
+			&& overlay == rhs.overlay;
+}
+
 MapSearchNode::MapSearchNode() {
 	x = y = 0;
 }
@@ -22,6 +52,43 @@ MapSearchNode::MapSearchNode(int px, int py) {
 	y = py;
 }
 
+void MapSearchNode::SetMovement(int connectivity, int cornerRule) {
+	movement_connectivity.store(connectivity);
+	movement_corner_rule.store(cornerRule);
+}
+
+int MapSearchNode::GetConnectivity() {
+	return movement_connectivity.load();
+}
+
+int MapSearchNode::GetCornerRule() {
+	return movement_corner_rule.load();
+}
+
+void MapSearchNode::SetAgentSize(int size) {
+	agent_size.store(size);
+}
+
+int MapSearchNode::GetAgentSize() {
+	return agent_size.load();
+}
+
+void MapSearchNode::SetEdgeCosts(const EdgeCostTable *table) {
+	edge_costs.store(table);
+}
+
+const EdgeCostTable *MapSearchNode::GetEdgeCosts() {
+	return edge_costs.load();
+}
+
+void MapSearchNode::SetObstacleOverlay(const ObstacleOverlay *overlay) {
+	obstacle_overlay.store(overlay);
+}
+
+const ObstacleOverlay *MapSearchNode::GetObstacleOverlay() {
+	return obstacle_overlay.load();
+}
+
 bool MapSearchNode::IsSameState(MapSearchNode &rhs) {
 
 	// same state in a maze search is simply when (x,y) are the same
@@ -38,10 +105,31 @@ void MapSearchNode::PrintNodeInfo() {
 }
 
 // Here's the heuristic function that estimates the distance from a Node
-// to the Goal.
+// to the Goal. Manhattan distance for 4-connected movement, octile distance
+// (diagonal steps as far as possible, then straight) for 8-connected.
 
 float MapSearchNode::GoalDistanceEstimate(MapSearchNode &nodeGoal) {
-	return fabsf(x - nodeGoal.x) + fabsf(y - nodeGoal.y);
+	return GoalDistanceEstimate(nodeGoal, Rules());
+}
+
+float MapSearchNode::GoalDistanceEstimate(MapSearchNode &nodeGoal,
+		const Rules &rules) {
+	float dx = fabsf(x - nodeGoal.x);
+	float dy = fabsf(y - nodeGoal.y);
+
+	if (rules.connectivity == CONNECT_8) {
+		return max(dx, dy) + (SQRT2 - 1.0f) * min(dx, dy);
+	}
+
+	return dx + dy;
+}
+
+bool MapSearchNode::IsOnMap() const {
+	return x >= 0 && x < Map::GetWidth() && y >= 0 && y < Map::GetHeight();
+}
+
+bool MapSearchNode::IsOccupied(const Rules &rules) {
+	return rules.overlay && rules.overlay->IsBlocked(x, y, rules.agentSize);
 }
 
 bool MapSearchNode::IsGoal(MapSearchNode &nodeGoal) {
@@ -55,6 +143,11 @@ bool MapSearchNode::IsGoal(MapSearchNode &nodeGoal) {
 
 bool MapSearchNode::GetSuccessors(MapSearchNode *parent_node,
 		std::vector<int>& newX, std::vector<int>& newY) {
+	return GetSuccessors(parent_node, newX, newY, Rules());
+}
+
+bool MapSearchNode::GetSuccessors(MapSearchNode *parent_node,
+		std::vector<int>& newX, std::vector<int>& newY, const Rules &rules) {
 
 	newX.clear();
 	newY.clear();
@@ -69,28 +162,58 @@ bool MapSearchNode::GetSuccessors(MapSearchNode *parent_node,
 
 	// push each possible move except allowing the search to go backwards
 
-	if ((Map::GetMap(x - 1, y) < 9)
-			&& !((parent_x == x - 1) && (parent_y == y))) {
-		newX.push_back(x - 1);
-		newY.push_back(y);
-	}
-
-	if ((Map::GetMap(x, y - 1) < 9)
-			&& !((parent_x == x) && (parent_y == y - 1))) {
-		newX.push_back(x);
-		newY.push_back(y - 1);
-	}
-
-	if ((Map::GetMap(x + 1, y) < 9)
-			&& !((parent_x == x + 1) && (parent_y == y))) {
-		newX.push_back(x + 1);
-		newY.push_back(y);
+	int moves = (rules.connectivity == CONNECT_8) ? 8 : 4;
+
+	// The table has already ruled out the moves that are not allowed
+	if (rules.edgeCosts && rules.edgeCosts->IsFor(rules)) {
+		const float *costs = rules.edgeCosts->GetCosts(x, y);
+
+		for (int i = 0; i < rules.edgeCosts->GetDirectionCount(); i++) {
+			int nx = x + MOVE_X[i];
+			int ny = y + MOVE_Y[i];
+
+			if (costs[i] != EdgeCostTable::NO_MOVE
+					&& ((parent_x != nx) || (parent_y != ny))
+					&& !(rules.overlay
+							&& rules.overlay->IsBlocked(nx, ny,
+									rules.agentSize))) {
+				newX.push_back(nx);
+				newY.push_back(ny);
+			}
+		}
+		return true;
 	}
 
-	if ((Map::GetMap(x, y + 1) < 9)
-			&& !((parent_x == x) && (parent_y == y + 1))) {
-		newX.push_back(x);
-		newY.push_back(y + 1);
+	for (int i = 0; i < moves; i++) {
+		int nx = x + MOVE_X[i];
+		int ny = y + MOVE_Y[i];
+
+		// The clearance check also rules out blocked cells, which have none
+		if ((Map::GetClearance(nx, ny) < rules.agentSize)
+				|| ((parent_x == nx) && (parent_y == ny))) {
+			continue;
+		}
+
+		// Diagonals: check the two cells beside the corner we pass
+		if (i >= 4 && rules.cornerRule != CORNER_CUT_ALLOWED) {
+			int blocked = (Map::GetClearance(nx, y) < rules.agentSize)
+					+ (Map::GetClearance(x, ny) < rules.agentSize);
+
+			if (blocked == 2
+					|| (blocked == 1
+							&& rules.cornerRule == CORNER_CUT_FORBIDDEN)) {
+				continue;
+			}
+		}
+
+		// Units only stop the agent moving onto their cells, not past them
+		if (rules.overlay
+				&& rules.overlay->IsBlocked(nx, ny, rules.agentSize)) {
+			continue;
+		}
+
+		newX.push_back(nx);
+		newY.push_back(ny);
 	}
 
 	return true;
@@ -98,9 +221,22 @@ bool MapSearchNode::GetSuccessors(MapSearchNode *parent_node,
 
 // given this node, what does it cost to move to successor. In the case
 // of our map the answer is the map terrain value at this node since that is
-// conceptually where we're moving
+// conceptually where we're moving, times the length of a diagonal step
 
 float MapSearchNode::GetCost(MapSearchNode &successor) {
+	return GetCost(successor, Rules());
+}
+
+float MapSearchNode::GetCost(MapSearchNode &successor, const Rules &rules) {
+	if (rules.edgeCosts && rules.edgeCosts->IsFor(rules)) {
+		return rules.edgeCosts->GetCost(x, y, successor.x - x,
+				successor.y - y);
+	}
+
+	if ((successor.x != x) && (successor.y != y)) {
+		return SQRT2 * Map::GetMap(x, y);
+	}
+
 	return (float) Map::GetMap(x, y);
 
 }
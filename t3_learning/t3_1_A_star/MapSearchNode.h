@@ -10,21 +10,96 @@
 
 #include <vector>
 
+class EdgeCostTable;
+class ObstacleOverlay;
+
 class MapSearchNode {
 public:
+	// Movement rules
+	enum {
+		CONNECT_4, CONNECT_8
+	};
+
+	// With 8-connected movement, when may a diagonal step pass the corner of
+	// a blocked cell: always, unless both cells beside it are blocked, or
+	// only when neither is
+	enum {
+		CORNER_CUT_ALLOWED, CORNER_SQUEEZE_FORBIDDEN, CORNER_CUT_FORBIDDEN
+	};
+
+	// The rules one search moves by. A search copies them when it starts and
+	// hands them to every call it makes below, so searches under different
+	// rules may run side by side, and changing the defaults never reaches a
+	// search already running. Made from the defaults unless filled in
+	struct Rules {
+		Rules();
+
+		bool operator==(const Rules &rhs) const;
+
+		int connectivity;
+		int cornerRule;
+
+		// Size of the agent searched for: it occupies size x size cells from
+		// its position, and only moves where Map::GetClearance allows
+		int agentSize;
+
+		// Moves and their costs are read from this table, NULL to work them
+		// out from the map. A table built for another map than the one
+		// searched, or for other movement, is passed over
+		const EdgeCostTable *edgeCosts;
+
+		// Also keep off the cells this overlay has blocked for now, NULL for
+		// none. Tables built from the map outlast the units on it, so they
+		// are built without
+		const ObstacleOverlay *overlay;
+	};
+
 	int x;	 // the (x,y) positions of the node
 	int y;
 
 	MapSearchNode();
 	MapSearchNode(int px, int py);
 
+	// Defaults for the searches started from now on, see Rules. Default
+	// CONNECT_4, CORNER_CUT_FORBIDDEN
+	static void SetMovement(int connectivity, int cornerRule);
+	static int GetConnectivity();
+	static int GetCornerRule();
+
+	// Default agent size, see Rules. Default 1
+	static void SetAgentSize(int size);
+	static int GetAgentSize();
+
+	// Default edge cost table and overlay, see Rules. Default NULL
+	static void SetEdgeCosts(const EdgeCostTable *table);
+	static const EdgeCostTable *GetEdgeCosts();
+
+	static void SetObstacleOverlay(const ObstacleOverlay *overlay);
+	static const ObstacleOverlay *GetObstacleOverlay();
+
+	// Under the default rules
 	float GoalDistanceEstimate(MapSearchNode &nodeGoal);
 	bool IsGoal(MapSearchNode &nodeGoal);
 	bool GetSuccessors(MapSearchNode *parent_node, std::vector<int>& newX,
 			std::vector<int>& newY);
 	float GetCost(MapSearchNode &successor);
+
+	// Under the given rules
+	float GoalDistanceEstimate(MapSearchNode &nodeGoal, const Rules &rules);
+	bool GetSuccessors(MapSearchNode *parent_node, std::vector<int>& newX,
+			std::vector<int>& newY, const Rules &rules);
+	float GetCost(MapSearchNode &successor, const Rules &rules);
 	bool IsSameState(MapSearchNode &rhs);
 
+	// Whether the node is a cell of the map this thread's Map calls read.
+	// Searches fail at once for a start or goal that is not
+	bool IsOnMap() const;
+
+	// Whether the rules' overlay keeps the agent off this cell for now. It
+	// only stops moves onto the cell, so searches that walk moves backwards
+	// leave the overlay out of the rules and test the cell moved onto
+	bool IsOccupied(const Rules &rules);
+
 	void PrintNodeInfo();
 
 };
@@ -0,0 +1,70 @@
+/*
+ * MapSnapshot.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "MapSnapshot.h"
+
+#include <algorithm>
+
+#include "Map.h"
+
+MapSnapshot::MapSnapshot(int width, int height, const std::vector<int> &data) :
+		m_Width(width), m_Height(height), m_Data(data.begin(),
+				data.begin() + (long) width * height) {
+	BuildClearance();
+}
+
+MapSnapshot::~MapSnapshot() {
+}
+
+int MapSnapshot::GetMap(int x, int y) const {
+	if (x < 0 || x >= m_Width || y < 0 || y >= m_Height) {
+		return 9;
+	}
+
+	return m_Data[(y * m_Width) + x];
+}
+
+int MapSnapshot::GetWidth() const {
+	return m_Width;
+}
+
+int MapSnapshot::GetHeight() const {
+	return m_Height;
+}
+
+int MapSnapshot::GetClearance(int x, int y) const {
+	if (x < 0 || x >= m_Width || y < 0 || y >= m_Height) {
+		return 0;
+	}
+
+	return m_Clearance[(y * m_Width) + x];
+}
+
+const std::vector<int> &MapSnapshot::GetData() const {
+	return m_Data;
+}
+
+// One sweep from the bottom right corner back: a square fits at a cell when
+// the cell is passable and squares one smaller fit to its right, below it and
+// diagonally below right
+void MapSnapshot::BuildClearance() {
+	m_Clearance.assign(m_Data.size(), 0);
+
+	for (int y = m_Height - 1; y >= 0; y--) {
+		for (int x = m_Width - 1; x >= 0; x--) {
+			if (GetMap(x, y) >= 9) {
+				continue;
+			}
+
+			int clearance = std::min(GetClearance(x + 1, y),
+					std::min(GetClearance(x, y + 1),
+							GetClearance(x + 1, y + 1))) + 1;
+			m_Clearance[(y * m_Width) + x] = std::min(clearance,
+					MAX_CLEARANCE);
+		}
+	}
+}
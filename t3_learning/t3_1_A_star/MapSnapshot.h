@@ -0,0 +1,43 @@
+/*
+ * MapSnapshot.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef MAPSNAPSHOT_H_
+#define MAPSNAPSHOT_H_
+
+#include <vector>
+
+// One map's terrain costs and clearances, fixed once made. Shared through a
+// std::shared_ptr<const MapSnapshot>, so any number of threads can search
+// it at once while it stays alive for as long as one of them holds it.
+// Searches read it through the static Map calls, see Map::SnapshotScope.
+
+class MapSnapshot {
+public:
+	// A width x height grid of terrain costs, row by row
+	MapSnapshot(int width, int height, const std::vector<int> &data);
+	virtual ~MapSnapshot();
+
+	int GetMap(int x, int y) const;
+	int GetWidth() const;
+	int GetHeight() const;
+	int GetClearance(int x, int y) const;
+
+	const std::vector<int> &GetData() const;
+
+private:
+	// Map's static calls read the members directly
+	friend class Map;
+
+	void BuildClearance();
+
+	int m_Width;
+	int m_Height;
+	std::vector<int> m_Data;
+	std::vector<unsigned char> m_Clearance;
+};
+
+#endif /* MAPSNAPSHOT_H_ */
@@ -0,0 +1,266 @@
+/*
+ * MultiGoalSearch.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "MultiGoalSearch.h"
+
+#include "AStarSearch.h"
+#include "Map.h"
+
+bool MultiGoalSearch::HeapCompare_f::operator ()(const OpenEntry &x,
+		const OpenEntry &y) const {
+	return x.f > y.f;
+}
+
+MultiGoalSearch::MultiGoalSearch() :
+		m_Mode(MODE_AUTO), m_LastMode(MODE_AUTO), m_MinHeuristicGoalLimit(8),
+		m_Width(0), m_CurrentStamp(0), m_GoalIndex(-1),
+		m_SolutionCost(FLT_MAX), m_Steps(0) {
+}
+
+MultiGoalSearch::~MultiGoalSearch() {
+}
+
+void MultiGoalSearch::SetMode(int mode) {
+	m_Mode = mode;
+}
+
+void MultiGoalSearch::SetMinHeuristicGoalLimit(int limit) {
+	m_MinHeuristicGoalLimit = limit;
+}
+
+unsigned int MultiGoalSearch::Search(MapSearchNode &Start,
+		const std::vector<MapSearchNode> &Goals,
+		const MapSearchNode::Rules &rules) {
+	Reset();
+
+	m_Rules = rules;
+	m_Goals = Goals;
+	for (unsigned int i = 0; i < m_Goals.size(); i++) {
+		// A goal the agent does not fit on, or off the map, can never be
+		// reached; searching backwards it must not be a source either. Nor
+		// can one held by a unit, unless the agent is already there
+		if (Map::GetClearance(m_Goals[i].x, m_Goals[i].y) < m_Rules.agentSize
+				|| (m_Goals[i].IsOccupied(m_Rules)
+						&& !m_Goals[i].IsSameState(Start))) {
+			continue;
+		}
+
+		// The first of several identical goals wins
+		m_GoalCells.insert(std::make_pair(GetCell(m_Goals[i]), (int) i));
+	}
+
+	m_LastMode = m_Mode;
+	if (m_LastMode == MODE_AUTO) {
+		m_LastMode =
+				(int) m_Goals.size() <= m_MinHeuristicGoalLimit ?
+						MODE_MIN_HEURISTIC : MODE_REVERSE_DIJKSTRA;
+	}
+
+	int goalCell = -1;
+	if (!m_GoalCells.empty() && Start.IsOnMap()) {
+		goalCell = m_LastMode == MODE_MIN_HEURISTIC ?
+				SearchForwards(Start) : SearchBackwards(Start);
+	}
+
+	m_OpenList.clear();
+
+	if (goalCell < 0) {
+		return AStarSearch::SEARCH_STATE_FAILED;
+	}
+
+	m_GoalIndex = m_GoalCells[goalCell];
+	return AStarSearch::SEARCH_STATE_SUCCEEDED;
+}
+
+int MultiGoalSearch::SearchForwards(MapSearchNode &Start) {
+	int startCell = GetCell(Start);
+	Open(startCell, 0.0f, -1, MinGoalDistance(Start));
+
+	std::vector<int> x, y;
+
+	while (!m_OpenList.empty()) {
+		OpenEntry best = m_OpenList.front();
+		pop_heap(m_OpenList.begin(), m_OpenList.end(), HeapCompare_f());
+		m_OpenList.pop_back();
+
+		if (best.g > m_G[best.cell]) {
+			continue;
+		}
+
+		m_Steps++;
+
+		if (m_GoalCells.count(best.cell)) {
+			for (int cell = best.cell; cell >= 0; cell = m_Parent[cell]) {
+				m_Solution.push_back(GetState(cell));
+			}
+			reverse(m_Solution.begin(), m_Solution.end());
+			m_SolutionCost = best.g;
+			return best.cell;
+		}
+
+		MapSearchNode state = GetState(best.cell);
+		MapSearchNode parent;
+		if (m_Parent[best.cell] >= 0) {
+			parent = GetState(m_Parent[best.cell]);
+		}
+
+		state.GetSuccessors(m_Parent[best.cell] >= 0 ? &parent : NULL, x, y,
+				m_Rules);
+
+		for (unsigned int i = 0; i < x.size(); i++) {
+			MapSearchNode successor(x[i], y[i]);
+			int cell = GetCell(successor);
+			float g = best.g + state.GetCost(successor, m_Rules);
+
+			if (!IsCurrent(cell) || g < m_G[cell]) {
+				Open(cell, g, best.cell, MinGoalDistance(successor));
+			}
+		}
+	}
+
+	return -1;
+}
+
+int MultiGoalSearch::SearchBackwards(MapSearchNode &Start) {
+	int startCell = GetCell(Start);
+
+	// Every goal is a source. Heading for the one start, the ordinary
+	// estimate towards it keeps the search focused; m_Parent points towards
+	// the goals
+	for (std::unordered_map<int, int>::iterator it = m_GoalCells.begin();
+			it != m_GoalCells.end(); it++) {
+		MapSearchNode goal = GetState(it->first);
+		Open(it->first, 0.0f, -1, goal.GoalDistanceEstimate(Start, m_Rules));
+	}
+
+	// Moves without the overlay are symmetric, so the cells a cell can move
+	// to are also the cells that can move into it. The overlay only stops
+	// moves onto a cell, and is tested on the cell moved onto
+	MapSearchNode::Rules moves = m_Rules;
+	moves.overlay = NULL;
+
+	std::vector<int> x, y;
+
+	while (!m_OpenList.empty()) {
+		OpenEntry best = m_OpenList.front();
+		pop_heap(m_OpenList.begin(), m_OpenList.end(), HeapCompare_f());
+		m_OpenList.pop_back();
+
+		if (best.g > m_G[best.cell]) {
+			continue;
+		}
+
+		m_Steps++;
+
+		if (best.cell == startCell) {
+			int cell = startCell;
+			for (; m_Parent[cell] >= 0; cell = m_Parent[cell]) {
+				m_Solution.push_back(GetState(cell));
+			}
+			m_Solution.push_back(GetState(cell));
+			m_SolutionCost = best.g;
+			return cell;
+		}
+
+		MapSearchNode state = GetState(best.cell);
+		if (state.IsOccupied(m_Rules)) {
+			continue;
+		}
+		state.GetSuccessors(NULL, x, y, moves);
+
+		for (unsigned int i = 0; i < x.size(); i++) {
+			MapSearchNode predecessor(x[i], y[i]);
+			int cell = GetCell(predecessor);
+			float g = best.g + predecessor.GetCost(state, moves);
+
+			if (!IsCurrent(cell) || g < m_G[cell]) {
+				Open(cell, g, best.cell,
+						predecessor.GoalDistanceEstimate(Start, m_Rules));
+			}
+		}
+	}
+
+	return -1;
+}
+
+float MultiGoalSearch::MinGoalDistance(MapSearchNode &state) {
+	float h = FLT_MAX;
+	for (unsigned int i = 0; i < m_Goals.size(); i++) {
+		h = std::min(h, state.GoalDistanceEstimate(m_Goals[i], m_Rules));
+	}
+	return h;
+}
+
+void MultiGoalSearch::Reset() {
+	int cells = Map::GetWidth() * Map::GetHeight();
+
+	m_Width = Map::GetWidth();
+
+	if ((int) m_G.size() != cells) {
+		m_G.assign(cells, FLT_MAX);
+		m_Parent.assign(cells, -1);
+		m_Stamp.assign(cells, 0);
+		m_CurrentStamp = 0;
+	}
+
+	// A new stamp invalidates everything the last search touched
+	m_CurrentStamp++;
+	if (m_CurrentStamp == 0) {
+		m_Stamp.assign(cells, 0);
+		m_CurrentStamp = 1;
+	}
+
+	m_Goals.clear();
+	m_GoalCells.clear();
+	m_OpenList.clear();
+	m_Solution.clear();
+	m_SolutionCost = FLT_MAX;
+	m_GoalIndex = -1;
+	m_Steps = 0;
+}
+
+void MultiGoalSearch::Open(int cell, float g, int parent, float h) {
+	m_Stamp[cell] = m_CurrentStamp;
+	m_G[cell] = g;
+	m_Parent[cell] = parent;
+
+	OpenEntry entry = { g + h, g, cell };
+	m_OpenList.push_back(entry);
+	push_heap(m_OpenList.begin(), m_OpenList.end(), HeapCompare_f());
+}
+
+bool MultiGoalSearch::IsCurrent(int cell) const {
+	return m_Stamp[cell] == m_CurrentStamp;
+}
+
+MapSearchNode MultiGoalSearch::GetState(int cell) const {
+	return MapSearchNode(cell % m_Width, cell / m_Width);
+}
+
+int MultiGoalSearch::GetCell(const MapSearchNode &state) const {
+	return state.y * m_Width + state.x;
+}
+
+int MultiGoalSearch::GetGoalIndex() const {
+	return m_GoalIndex;
+}
+
+const std::vector<MapSearchNode> &MultiGoalSearch::GetSolution() const {
+	return m_Solution;
+}
+
+float MultiGoalSearch::GetSolutionCost() const {
+	return m_SolutionCost;
+}
+
+int MultiGoalSearch::GetStepCount() const {
+	return m_Steps;
+}
+
+int MultiGoalSearch::GetLastMode() const {
+	return m_LastMode;
+}
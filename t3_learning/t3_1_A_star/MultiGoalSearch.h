@@ -0,0 +1,115 @@
+/*
+ * MultiGoalSearch.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef MULTIGOALSEARCH_H_
+#define MULTIGOALSEARCH_H_
+
+#include <vector>
+#include <unordered_map>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+// Finds the cheapest path from a start to whichever of a set of goals is
+// closest, in one search.
+//
+// With few goals it runs A* forwards using the smallest GoalDistanceEstimate
+// over all goals, which stays admissible. With many goals that minimum gets
+// expensive, so it searches backwards instead: a multi-source Dijkstra from
+// all goals at once, steered towards the start by the ordinary estimate.
+// The backward search relies on movement being symmetric (if a can move to b
+// then b can move to a), which holds for the grid moves MapSearchNode
+// generates without the overlay; edge costs are still taken in the forward
+// direction. The overlay only stops moves onto a cell, so searching
+// backwards it is tested on the cell moved onto, and both modes find the
+// same cost.
+//
+// Uses the AStarSearch::SEARCH_STATE_* values.
+
+class MultiGoalSearch {
+public:
+	enum {
+		MODE_AUTO, MODE_MIN_HEURISTIC, MODE_REVERSE_DIJKSTRA
+	};
+
+	MultiGoalSearch();
+	virtual ~MultiGoalSearch();
+
+	// MODE_AUTO picks the min heuristic for up to limit goals
+	void SetMode(int mode);
+	void SetMinHeuristicGoalLimit(int limit);
+
+	// Runs the whole search, under the given rules or the defaults as they
+	// are now
+	unsigned int Search(MapSearchNode &Start,
+			const std::vector<MapSearchNode> &Goals,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Index into the goals passed to Search of the goal reached, -1 if none
+	int GetGoalIndex() const;
+
+	// The solution from start to goal, both included
+	const std::vector<MapSearchNode> &GetSolution() const;
+
+	// Returns FLT_MAX if no goal is reachable
+	float GetSolutionCost() const;
+
+	int GetStepCount() const;
+
+	// The mode the last search actually ran in
+	int GetLastMode() const;
+
+private:
+	// An entry whose g is above the cell's current g has been superseded
+	struct OpenEntry {
+		float f;
+		float g;
+		int cell;
+	};
+
+	class HeapCompare_f {
+	public:
+		bool operator()(const OpenEntry &x, const OpenEntry &y) const;
+	};
+
+	void Reset();
+	void Open(int cell, float g, int parent, float h);
+	bool IsCurrent(int cell) const;
+	int SearchForwards(MapSearchNode &Start);
+	int SearchBackwards(MapSearchNode &Start);
+	float MinGoalDistance(MapSearchNode &state);
+
+	MapSearchNode GetState(int cell) const;
+	int GetCell(const MapSearchNode &state) const;
+
+private:
+	int m_Mode;
+	int m_LastMode;
+	int m_MinHeuristicGoalLimit;
+
+	int m_Width;
+
+	MapSearchNode::Rules m_Rules;
+	std::vector<MapSearchNode> m_Goals;
+	std::unordered_map<int, int> m_GoalCells;
+
+	// Per cell search state, valid only where the stamp is current, so a
+	// search only pays for the cells it touches
+	std::vector<float> m_G;
+	std::vector<int> m_Parent;
+	std::vector<unsigned int> m_Stamp;
+	unsigned int m_CurrentStamp;
+
+	std::vector<OpenEntry> m_OpenList;
+
+	int m_GoalIndex;
+	std::vector<MapSearchNode> m_Solution;
+	float m_SolutionCost;
+	int m_Steps;
+};
+
+#endif /* MULTIGOALSEARCH_H_ */
@@ -0,0 +1,82 @@
+/*
+ * ObstacleOverlay.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "ObstacleOverlay.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// Readers only act on the flag itself, so relaxed order is enough
+static const memory_order OVERLAY_ORDER = memory_order_relaxed;
+
+ObstacleOverlay::ObstacleOverlay(int width, int height) :
+		m_Width(width), m_Height(height), m_Epoch(1), m_Cells(width * height) {
+	for (unsigned int i = 0; i < m_Cells.size(); i++) {
+		m_Cells[i].store(0, OVERLAY_ORDER);
+	}
+}
+
+ObstacleOverlay::~ObstacleOverlay() {
+}
+
+int ObstacleOverlay::GetWidth() const {
+	return m_Width;
+}
+
+int ObstacleOverlay::GetHeight() const {
+	return m_Height;
+}
+
+unsigned int ObstacleOverlay::GetEpoch() const {
+	return m_Epoch.load(OVERLAY_ORDER);
+}
+
+void ObstacleOverlay::Advance() {
+	m_Epoch.fetch_add(1, OVERLAY_ORDER);
+}
+
+void ObstacleOverlay::Block(int x, int y, int epochs) {
+	if (x < 0 || x >= m_Width || y < 0 || y >= m_Height || epochs <= 0) {
+		return;
+	}
+
+	// A reservation never shortens one already held
+	atomic<unsigned int> &cell = m_Cells[y * m_Width + x];
+	unsigned int until = GetEpoch() + epochs - 1;
+	unsigned int held = cell.load(OVERLAY_ORDER);
+	while (held < until
+			&& !cell.compare_exchange_weak(held, until, OVERLAY_ORDER)) {
+	}
+}
+
+void ObstacleOverlay::Unblock(int x, int y) {
+	if (x < 0 || x >= m_Width || y < 0 || y >= m_Height) {
+		return;
+	}
+	m_Cells[y * m_Width + x].store(0, OVERLAY_ORDER);
+}
+
+bool ObstacleOverlay::IsBlocked(int x, int y) const {
+	if (x < 0 || x >= m_Width || y < 0 || y >= m_Height) {
+		return false;
+	}
+	return m_Cells[y * m_Width + x].load(OVERLAY_ORDER) >= GetEpoch();
+}
+
+bool ObstacleOverlay::IsBlocked(int x, int y, int size) const {
+	unsigned int epoch = GetEpoch();
+
+	for (int cy = max(y, 0); cy < min(y + size, m_Height); cy++) {
+		for (int cx = max(x, 0); cx < min(x + size, m_Width); cx++) {
+			if (m_Cells[cy * m_Width + cx].load(OVERLAY_ORDER) >= epoch) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
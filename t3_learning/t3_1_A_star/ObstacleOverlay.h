@@ -0,0 +1,68 @@
+/*
+ * ObstacleOverlay.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef OBSTACLEOVERLAY_H_
+#define OBSTACLEOVERLAY_H_
+
+#include <atomic>
+#include <vector>
+
+// Cells blocked for a while by moving units, laid over the world map
+// without touching it. Each cell holds the last epoch it is blocked in, so
+// a unit reserves its cell for the current epoch, or a few ahead, and
+// Advance() unblocks every reservation that has run out at once, with no
+// pass over the cells. Epochs are 32 bit, enough for two years at 60 a
+// second.
+//
+// Cells and the epoch are atomic, so units may block and unblock cells and
+// advance the epoch while searches read the overlay on other threads. A
+// search sees each cell as it is when it looks at it: one that runs
+// across a change may find a path the change has since blocked.
+//
+// A search consults the overlay given in its rules, see
+// MapSearchNode::Rules, an agent not moving onto a cell its footprint would
+// share with a unit. Cells off the overlay are never blocked. Tables built
+// from the map (edge costs, landmarks, goal bounds, quadtrees, subgoal
+// graphs, pruning, contraction hierarchies) are built without it whatever
+// the rules they are given; a search reading edge costs from a table still
+// keeps off the overlay's cells.
+
+class ObstacleOverlay {
+public:
+	ObstacleOverlay(int width, int height);
+	virtual ~ObstacleOverlay();
+
+	int GetWidth() const;
+	int GetHeight() const;
+
+	unsigned int GetEpoch() const;
+
+	// Moves on to the next epoch, unblocking the cells reserved up to this
+	// one
+	void Advance();
+
+	// Blocks the cell for this epoch and the epochs - 1 after it
+	void Block(int x, int y, int epochs);
+	void Unblock(int x, int y);
+
+	bool IsBlocked(int x, int y) const;
+
+	// Whether any cell of the size x size square from (x, y) is blocked
+	bool IsBlocked(int x, int y, int size) const;
+
+private:
+	int m_Width;
+	int m_Height;
+
+	// Starts at 1, a cell holding 0 was never blocked
+	std::atomic<unsigned int> m_Epoch;
+
+	// Last epoch each cell is blocked in
+	std::vector<std::atomic<unsigned int> > m_Cells;
+};
+
+#endif /* OBSTACLEOVERLAY_H_ */
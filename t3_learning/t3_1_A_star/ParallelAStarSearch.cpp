@@ -0,0 +1,332 @@
+/*
+ * ParallelAStarSearch.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "ParallelAStarSearch.h"
+
+#include "AStarSearch.h"
+#include "Map.h"
+
+#include <thread>
+
+// Successors for one worker are batched so a queue operation carries many
+// nodes, and every worker flushes at least this often while it expands
+const unsigned int BATCH_SIZE = 64;
+const int FLUSH_INTERVAL = 32;
+
+ParallelAStarSearch::BatchQueue::BatchQueue() :
+		m_Head(&m_Stub), m_Tail(&m_Stub) {
+	m_Stub.next.store(NULL);
+}
+
+ParallelAStarSearch::BatchQueue::~BatchQueue() {
+	Batch *batch;
+	while ((batch = Pop()) != NULL) {
+		delete batch;
+	}
+}
+
+void ParallelAStarSearch::BatchQueue::Push(Batch *batch) {
+	batch->next.store(NULL, std::memory_order_relaxed);
+	Batch *prev = m_Head.exchange(batch, std::memory_order_acq_rel);
+	prev->next.store(batch, std::memory_order_release);
+}
+
+ParallelAStarSearch::Batch *ParallelAStarSearch::BatchQueue::Pop() {
+	Batch *tail = m_Tail;
+	Batch *next = tail->next.load(std::memory_order_acquire);
+
+	if (tail == &m_Stub) {
+		if (!next) {
+			return NULL;
+		}
+		m_Tail = next;
+		tail = next;
+		next = next->next.load(std::memory_order_acquire);
+	}
+
+	if (next) {
+		m_Tail = next;
+		return tail;
+	}
+
+	// A producer has swapped the head but not linked it yet, try again later
+	if (tail != m_Head.load(std::memory_order_acquire)) {
+		return NULL;
+	}
+
+	// tail is the last batch; put the stub behind it so it can be handed out
+	Push(&m_Stub);
+	next = tail->next.load(std::memory_order_acquire);
+
+	if (next) {
+		m_Tail = next;
+		return tail;
+	}
+
+	return NULL;
+}
+
+bool ParallelAStarSearch::HeapCompare_f::operator ()(const OpenEntry &x,
+		const OpenEntry &y) const {
+	return x.f > y.f;
+}
+
+ParallelAStarSearch::ParallelAStarSearch(int threads) :
+		m_ThreadCount(threads > 0 ? threads : 1), m_Width(0), m_GoalCell(-1),
+		m_Pending(0), m_Done(false), m_Incumbent(FLT_MAX),
+		m_SolutionCost(FLT_MAX), m_Steps(0) {
+}
+
+ParallelAStarSearch::~ParallelAStarSearch() {
+	for (unsigned int i = 0; i < m_Workers.size(); i++) {
+		delete m_Workers[i];
+	}
+}
+
+unsigned int ParallelAStarSearch::Search(MapSearchNode &Start,
+		MapSearchNode &Goal, const MapSearchNode::Rules &rules) {
+	for (unsigned int i = 0; i < m_Workers.size(); i++) {
+		delete m_Workers[i];
+	}
+	m_Workers.clear();
+
+	for (int i = 0; i < m_ThreadCount; i++) {
+		Worker *worker = new Worker;
+		worker->outgoing.assign(m_ThreadCount, NULL);
+		worker->steps = 0;
+		m_Workers.push_back(worker);
+	}
+
+	m_Width = Map::GetWidth();
+	m_Goal = Goal;
+	m_Rules = rules;
+	m_GoalCell = Goal.y * m_Width + Goal.x;
+	m_Solution.clear();
+	m_SolutionCost = FLT_MAX;
+	m_Steps = 0;
+
+	m_Incumbent.store(FLT_MAX);
+	m_Done.store(false);
+	m_Pending.store(m_ThreadCount);
+
+	int startCell = Start.y * m_Width + Start.x;
+	Receive(*m_Workers[GetOwner(startCell)], startCell, -1, 0.0f);
+
+	// The other threads search the map this one does
+	std::shared_ptr<const MapSnapshot> map = Map::GetSnapshot();
+	std::vector<std::thread> threads;
+	for (int i = 1; i < m_ThreadCount; i++) {
+		threads.push_back(std::thread([this, i, map]() {
+			Map::SnapshotScope scope(map);
+			Run(i);
+		}));
+	}
+	Run(0);
+	for (unsigned int i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+
+	for (int i = 0; i < m_ThreadCount; i++) {
+		m_Steps += m_Workers[i]->steps;
+	}
+
+	m_SolutionCost = m_Incumbent.load();
+
+	if (m_SolutionCost == FLT_MAX) {
+		return AStarSearch::SEARCH_STATE_FAILED;
+	}
+
+	// Walk the parents back through whichever worker owns each cell
+	for (int cell = m_GoalCell; cell >= 0;) {
+		m_Solution.push_back(MapSearchNode(cell % m_Width, cell / m_Width));
+		cell = m_Workers[GetOwner(cell)]->closedList[cell].parent;
+	}
+	reverse(m_Solution.begin(), m_Solution.end());
+
+	return AStarSearch::SEARCH_STATE_SUCCEEDED;
+}
+
+void ParallelAStarSearch::Run(int id) {
+	Worker &worker = *m_Workers[id];
+	bool active = true;
+	int sinceFlush = 0;
+
+	std::vector<int> x, y;
+
+	while (!m_Done.load(std::memory_order_acquire)) {
+		Batch *batch;
+
+		while ((batch = worker.queue.Pop()) != NULL) {
+			// Become active before the batch stops counting as pending, so
+			// the count never touches zero while there is work about
+			if (!active) {
+				m_Pending.fetch_add(1);
+				active = true;
+			}
+
+			for (unsigned int i = 0; i < batch->messages.size(); i++) {
+				const Message &message = batch->messages[i];
+				Receive(worker, message.cell, message.parent, message.g);
+			}
+
+			delete batch;
+			m_Pending.fetch_sub(1);
+		}
+
+		if (!HasUsefulWork(worker)) {
+			// Anything still buffered must be on its way before we go idle
+			Flush(worker);
+			sinceFlush = 0;
+
+			if (active) {
+				active = false;
+				if (m_Pending.fetch_sub(1) == 1) {
+					m_Done.store(true, std::memory_order_release);
+				}
+			} else {
+				std::this_thread::yield();
+			}
+
+			continue;
+		}
+
+		OpenEntry entry = worker.openList.front();
+		pop_heap(worker.openList.begin(), worker.openList.end(),
+				HeapCompare_f());
+		worker.openList.pop_back();
+
+		ClosedEntry &closed = worker.closedList[entry.cell];
+
+		// Superseded by a cheaper copy of the same cell
+		if (entry.g > closed.g) {
+			continue;
+		}
+
+		worker.steps++;
+
+		if (entry.cell == m_GoalCell) {
+			UpdateIncumbent(entry.g);
+			continue;
+		}
+
+		MapSearchNode node(entry.cell % m_Width, entry.cell / m_Width);
+		MapSearchNode parent(closed.parent % m_Width, closed.parent / m_Width);
+
+		node.GetSuccessors(closed.parent >= 0 ? &parent : NULL, x, y,
+				m_Rules);
+
+		for (unsigned int i = 0; i < x.size(); i++) {
+			MapSearchNode successor(x[i], y[i]);
+			int cell = y[i] * m_Width + x[i];
+			float g = entry.g + node.GetCost(successor, m_Rules);
+			int owner = GetOwner(cell);
+
+			if (owner == id) {
+				Receive(worker, cell, entry.cell, g);
+				continue;
+			}
+
+			Batch *&out = worker.outgoing[owner];
+			if (!out) {
+				out = new Batch;
+				out->messages.reserve(BATCH_SIZE);
+			}
+
+			Message message = { cell, entry.cell, g };
+			out->messages.push_back(message);
+
+			if (out->messages.size() >= BATCH_SIZE) {
+				m_Pending.fetch_add(1);
+				m_Workers[owner]->queue.Push(out);
+				out = NULL;
+			}
+		}
+
+		if (++sinceFlush >= FLUSH_INTERVAL) {
+			Flush(worker);
+			sinceFlush = 0;
+		}
+	}
+}
+
+void ParallelAStarSearch::Receive(Worker &worker, int cell, int parent,
+		float g) {
+	MapSearchNode node(cell % m_Width, cell / m_Width);
+	float f = g + node.GoalDistanceEstimate(m_Goal, m_Rules);
+
+	// Nothing through this node can beat a path we already have
+	if (f >= m_Incumbent.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	std::unordered_map<int, ClosedEntry>::iterator it = worker.closedList.find(
+			cell);
+
+	if (it != worker.closedList.end()) {
+		if (it->second.g <= g) {
+			return;
+		}
+		it->second.g = g;
+		it->second.parent = parent;
+	} else {
+		ClosedEntry closed = { g, parent };
+		worker.closedList.insert(std::make_pair(cell, closed));
+	}
+
+	OpenEntry entry = { f, g, cell };
+	worker.openList.push_back(entry);
+	push_heap(worker.openList.begin(), worker.openList.end(), HeapCompare_f());
+}
+
+void ParallelAStarSearch::Flush(Worker &worker) {
+	for (int i = 0; i < m_ThreadCount; i++) {
+		if (worker.outgoing[i]) {
+			// Counted before it becomes visible to the receiver
+			m_Pending.fetch_add(1);
+			m_Workers[i]->queue.Push(worker.outgoing[i]);
+			worker.outgoing[i] = NULL;
+		}
+	}
+}
+
+bool ParallelAStarSearch::HasUsefulWork(Worker &worker) {
+	return !worker.openList.empty()
+			&& worker.openList.front().f
+					< m_Incumbent.load(std::memory_order_relaxed);
+}
+
+void ParallelAStarSearch::UpdateIncumbent(float cost) {
+	float current = m_Incumbent.load();
+	while (cost < current
+			&& !m_Incumbent.compare_exchange_weak(current, cost)) {
+	}
+}
+
+int ParallelAStarSearch::GetOwner(int cell) const {
+	// Mix the bits so neighbouring cells land on different workers
+	unsigned int h = (unsigned int) cell;
+	h ^= h >> 16;
+	h *= 0x45d9f3bu;
+	h ^= h >> 16;
+	return h % m_ThreadCount;
+}
+
+const std::vector<MapSearchNode> &ParallelAStarSearch::GetSolution() const {
+	return m_Solution;
+}
+
+float ParallelAStarSearch::GetSolutionCost() const {
+	return m_SolutionCost;
+}
+
+int ParallelAStarSearch::GetStepCount() const {
+	return m_Steps;
+}
+
+int ParallelAStarSearch::GetThreadCount() const {
+	return m_ThreadCount;
+}
@@ -0,0 +1,129 @@
+/*
+ * ParallelAStarSearch.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef PARALLELASTARSEARCH_H_
+#define PARALLELASTARSEARCH_H_
+
+#include <atomic>
+#include <vector>
+#include <unordered_map>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+// Hash distributed A* (HDA*). Every cell is owned by one worker thread, chosen
+// by hashing its coordinates. A worker expands the nodes it owns and sends
+// each successor to the owner of the successor cell through that worker's
+// lock-free message queue, so duplicate detection never needs a lock.
+//
+// The first goal found is not necessarily optimal, so a goal only lowers the
+// incumbent cost and the workers carry on until no open node anywhere can
+// beat it and no message is still in flight.
+
+class ParallelAStarSearch {
+public:
+	ParallelAStarSearch(int threads);
+	virtual ~ParallelAStarSearch();
+
+	// Runs the whole search and returns AStarSearch::SEARCH_STATE_SUCCEEDED
+	// or AStarSearch::SEARCH_STATE_FAILED. Every worker moves by the given
+	// rules, the defaults as they are now unless given
+	unsigned int Search(MapSearchNode &Start, MapSearchNode &Goal,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// The solution from start to goal, both included
+	const std::vector<MapSearchNode> &GetSolution() const;
+
+	// Returns FLT_MAX if there is no solution
+	float GetSolutionCost() const;
+
+	// Nodes expanded by all workers together
+	int GetStepCount() const;
+
+	int GetThreadCount() const;
+
+private:
+	// Successors bound for one worker, sent as a single queue node
+	struct Message {
+		int cell;
+		int parent;
+		float g;
+	};
+
+	struct Batch {
+		std::atomic<Batch *> next;
+		std::vector<Message> messages;
+	};
+
+	// Vyukov's intrusive multi producer single consumer queue: producers
+	// only ever exchange the head, the owning worker alone walks the tail
+	class BatchQueue {
+	public:
+		BatchQueue();
+		~BatchQueue();
+
+		void Push(Batch *batch);
+		Batch *Pop();
+
+	private:
+		std::atomic<Batch *> m_Head;
+		Batch *m_Tail;
+		Batch m_Stub;
+	};
+
+	struct OpenEntry {
+		float f;
+		float g;
+		int cell;
+	};
+
+	class HeapCompare_f {
+	public:
+		bool operator()(const OpenEntry &x, const OpenEntry &y) const;
+	};
+
+	struct ClosedEntry {
+		float g;
+		int parent;
+	};
+
+	struct Worker {
+		BatchQueue queue;
+		std::vector<OpenEntry> openList;
+		std::unordered_map<int, ClosedEntry> closedList;
+		std::vector<Batch *> outgoing;
+		int steps;
+	};
+
+	void Run(int id);
+	void Receive(Worker &worker, int cell, int parent, float g);
+	void Flush(Worker &worker);
+	bool HasUsefulWork(Worker &worker);
+	void UpdateIncumbent(float cost);
+	int GetOwner(int cell) const;
+
+private:
+	int m_ThreadCount;
+	std::vector<Worker *> m_Workers;
+
+	int m_Width;
+	int m_GoalCell;
+	MapSearchNode m_Goal;
+	MapSearchNode::Rules m_Rules;
+
+	// Active workers plus batches sent but not yet processed. Nothing can
+	// happen once it drops to zero, which is how the workers terminate
+	std::atomic<int> m_Pending;
+	std::atomic<bool> m_Done;
+	std::atomic<float> m_Incumbent;
+
+	std::vector<MapSearchNode> m_Solution;
+	float m_SolutionCost;
+	int m_Steps;
+};
+
+#endif /* PARALLELASTARSEARCH_H_ */
@@ -0,0 +1,99 @@
+/*
+ * PathEncoder.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "PathEncoder.h"
+
+#include <assert.h>
+
+const int PathEncoder::HEADER_SIZE;
+const int PathEncoder::MAX_RUN;
+
+// Same order as the moves in MapSearchNode.cpp
+const int DIRECTION_X[8] = { -1, 0, 1, 0, -1, 1, 1, -1 };
+const int DIRECTION_Y[8] = { 0, -1, 0, 1, -1, -1, 1, 1 };
+
+PathEncoder::PathEncoder(unsigned char *buffer, int size) :
+		m_Buffer(buffer), m_Size(size), m_Length(0), m_Started(false),
+		m_RunDirection(0), m_RunLength(0) {
+}
+
+void PathEncoder::Add(const MapSearchNode &node) {
+	if (!m_Started) {
+		m_Started = true;
+		m_Last = node;
+
+		Put(node.x & 0xff);
+		Put(node.x >> 8);
+		Put(node.y & 0xff);
+		Put(node.y >> 8);
+		return;
+	}
+
+	int direction = GetDirection(node.x - m_Last.x, node.y - m_Last.y);
+	assert(direction >= 0);
+	m_Last = node;
+
+	if (m_RunLength > 0
+			&& (direction != m_RunDirection || m_RunLength == MAX_RUN)) {
+		FlushRun();
+	}
+
+	m_RunDirection = direction;
+	m_RunLength++;
+}
+
+int PathEncoder::Finish() {
+	if (m_RunLength > 0) {
+		FlushRun();
+	}
+	return m_Length;
+}
+
+bool PathEncoder::Decode(const unsigned char *buffer, int size,
+		std::vector<MapSearchNode> &path) {
+	if (size < HEADER_SIZE) {
+		return false;
+	}
+
+	MapSearchNode node(buffer[0] | (buffer[1] << 8),
+			buffer[2] | (buffer[3] << 8));
+	path.push_back(node);
+
+	for (int i = HEADER_SIZE; i < size; i++) {
+		int direction = buffer[i] >> 5;
+		int run = (buffer[i] & 0x1f) + 1;
+
+		for (int j = 0; j < run; j++) {
+			node.x += DIRECTION_X[direction];
+			node.y += DIRECTION_Y[direction];
+			path.push_back(node);
+		}
+	}
+
+	return true;
+}
+
+void PathEncoder::Put(unsigned char byte) {
+	if (m_Length < m_Size) {
+		m_Buffer[m_Length] = byte;
+	}
+	m_Length++;
+}
+
+void PathEncoder::FlushRun() {
+	Put((m_RunDirection << 5) | (m_RunLength - 1));
+	m_RunLength = 0;
+}
+
+int PathEncoder::GetDirection(int dx, int dy) {
+	for (int i = 0; i < 8; i++) {
+		if (DIRECTION_X[i] == dx && DIRECTION_Y[i] == dy) {
+			return i;
+		}
+	}
+	return -1;
+}
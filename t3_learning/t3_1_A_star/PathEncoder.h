@@ -0,0 +1,64 @@
+/*
+ * PathEncoder.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef PATHENCODER_H_
+#define PATHENCODER_H_
+
+#include <vector>
+
+#include "MapSearchNode.h"
+
+// Compact form of a grid path, for storing it once the search is gone.
+//
+// The first 4 bytes are the start cell, x then y, 16 bits each with the low
+// byte first. Every further byte is a run of moves in one direction: the
+// direction in the top 3 bits, in the order MapSearchNode generates them
+// (west, north, east, south, then north west, north east, south east, south
+// west), and the run length minus one in the low 5 bits. Longer runs take
+// several bytes. A path of n cells in m straight stretches takes about
+// 4 + m bytes, against 8n as MapSearchNodes.
+//
+// The encoder takes the cells one at a time and writes into a buffer owned by
+// the caller, so nothing is allocated. If the buffer is too small it stops
+// writing but keeps counting, so the caller can retry with the size needed.
+
+class PathEncoder {
+public:
+	static const int HEADER_SIZE = 4;
+	static const int MAX_RUN = 32;
+
+	PathEncoder(unsigned char *buffer, int size);
+
+	// Appends the next cell, which must be a neighbour of the last one
+	void Add(const MapSearchNode &node);
+
+	// Writes the last run. Returns the bytes the path takes, which is more
+	// than the buffer size if it did not fit
+	int Finish();
+
+	// Appends the cells of an encoded path to path. Returns false if the data
+	// is malformed
+	static bool Decode(const unsigned char *buffer, int size,
+			std::vector<MapSearchNode> &path);
+
+private:
+	void Put(unsigned char byte);
+	void FlushRun();
+	static int GetDirection(int dx, int dy);
+
+private:
+	unsigned char *m_Buffer;
+	int m_Size;
+	int m_Length;
+
+	bool m_Started;
+	MapSearchNode m_Last;
+	int m_RunDirection;
+	int m_RunLength;
+};
+
+#endif /* PATHENCODER_H_ */
@@ -0,0 +1,184 @@
+/*
+ * PathQueryPool.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "PathQueryPool.h"
+
+#include "AStarSearch.h"
+#include "CompactAStarSearch.h"
+#include "Map.h"
+#include "MapSnapshot.h"
+
+// Reading the clock costs about as much as a step, so not every step
+const int DEADLINE_CHECK_INTERVAL = 32;
+
+PathQueryPool::CancellationToken::CancellationToken() :
+		m_Cancelled(std::make_shared<std::atomic<bool> >(false)) {
+}
+
+void PathQueryPool::CancellationToken::Cancel() {
+	m_Cancelled->store(true, std::memory_order_relaxed);
+}
+
+bool PathQueryPool::CancellationToken::IsCancelled() const {
+	return m_Cancelled->load(std::memory_order_relaxed);
+}
+
+PathQueryPool::Result::Result() :
+		status(QUERY_FAILED), cost(FLT_MAX), steps(0) {
+}
+
+PathQueryPool::PathQueryPool(int threads) :
+		m_Stopping(false), m_Abort(false) {
+	if (threads < 1) {
+		threads = 1;
+	}
+
+	for (int i = 0; i < threads; i++) {
+		m_Threads.push_back(std::thread(&PathQueryPool::Run, this));
+	}
+}
+
+PathQueryPool::~PathQueryPool() {
+	std::deque<std::shared_ptr<Query> > abandoned;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+		abandoned.swap(m_Queue);
+	}
+	m_Abort.store(true, std::memory_order_relaxed);
+	m_Wake.notify_all();
+
+	for (unsigned int i = 0; i < abandoned.size(); i++) {
+		Result result;
+		result.status = QUERY_CANCELLED;
+		abandoned[i]->promise.set_value(result);
+	}
+
+	for (unsigned int i = 0; i < m_Threads.size(); i++) {
+		m_Threads[i].join();
+	}
+}
+
+std::future<PathQueryPool::Result> PathQueryPool::Submit(
+		const MapSearchNode &Start, const MapSearchNode &Goal,
+		CancellationToken token, Clock::time_point deadline) {
+	return Submit(Map::GetSnapshot(), Start, Goal, token, deadline);
+}
+
+std::future<PathQueryPool::Result> PathQueryPool::Submit(
+		std::shared_ptr<const MapSnapshot> map, const MapSearchNode &Start,
+		const MapSearchNode &Goal, CancellationToken token,
+		Clock::time_point deadline) {
+	return Submit(map, MapSearchNode::Rules(), Start, Goal, token, deadline);
+}
+
+std::future<PathQueryPool::Result> PathQueryPool::Submit(
+		std::shared_ptr<const MapSnapshot> map,
+		const MapSearchNode::Rules &rules, const MapSearchNode &Start,
+		const MapSearchNode &Goal, CancellationToken token,
+		Clock::time_point deadline) {
+	// A start or goal off the map fails without troubling a worker
+	int width = map->GetWidth();
+	int height = map->GetHeight();
+	if (Start.x < 0 || Start.x >= width || Start.y < 0 || Start.y >= height
+			|| Goal.x < 0 || Goal.x >= width || Goal.y < 0
+			|| Goal.y >= height) {
+		std::promise<Result> failed;
+		failed.set_value(Result());
+		return failed.get_future();
+	}
+
+	std::shared_ptr<Query> query = std::make_shared<Query>();
+	query->map = map;
+	query->rules = rules;
+	query->start = Start;
+	query->goal = Goal;
+	query->token = token;
+	query->deadline = deadline;
+
+	std::future<Result> future = query->promise.get_future();
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Queue.push_back(query);
+	}
+	m_Wake.notify_one();
+
+	return future;
+}
+
+int PathQueryPool::GetThreadCount() const {
+	return m_Threads.size();
+}
+
+int PathQueryPool::GetQueuedCount() {
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Queue.size();
+}
+
+void PathQueryPool::Run() {
+	// One search per worker, reused so its pool and lists keep their size
+	CompactAStarSearch search;
+
+	for (;;) {
+		std::shared_ptr<Query> query;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			while (!m_Stopping && m_Queue.empty()) {
+				m_Wake.wait(lock);
+			}
+			if (m_Stopping) {
+				return;
+			}
+
+			query = m_Queue.front();
+			m_Queue.pop_front();
+		}
+
+		Map::SnapshotScope scope(query->map);
+		query->promise.set_value(Search(*query, search));
+	}
+}
+
+PathQueryPool::Result PathQueryPool::Search(Query &query,
+		CompactAStarSearch &search) {
+	Result result;
+
+	search.SetStartAndGoalStates(query.start, query.goal, query.rules);
+
+	unsigned int state = AStarSearch::SEARCH_STATE_SEARCHING;
+	for (int step = 0; state == AStarSearch::SEARCH_STATE_SEARCHING; step++) {
+		if (query.token.IsCancelled()
+				|| m_Abort.load(std::memory_order_relaxed)) {
+			result.status = QUERY_CANCELLED;
+			result.steps = step;
+			return result;
+		}
+
+		if (step % DEADLINE_CHECK_INTERVAL == 0
+				&& Clock::now() >= query.deadline) {
+			result.status = QUERY_TIMED_OUT;
+			result.steps = step;
+			return result;
+		}
+
+		state = search.SearchStep();
+	}
+
+	result.steps = search.GetStepCount();
+
+	if (state == AStarSearch::SEARCH_STATE_SUCCEEDED) {
+		result.status = QUERY_SUCCEEDED;
+		result.cost = search.GetSolutionCost();
+
+		for (MapSearchNode *node = search.GetSolutionStart(); node; node =
+				search.GetSolutionNext()) {
+			result.path.push_back(*node);
+		}
+	}
+
+	return result;
+}
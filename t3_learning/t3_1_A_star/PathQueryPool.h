@@ -0,0 +1,130 @@
+/*
+ * PathQueryPool.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef PATHQUERYPOOL_H_
+#define PATHQUERYPOOL_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+class CompactAStarSearch;
+class MapSnapshot;
+
+// Runs path queries on a pool of worker threads so the caller never blocks:
+// Submit returns a std::future straight away, and the game loop can poll it
+// with wait_for(std::chrono::seconds(0)) each frame.
+//
+// Each query is a CompactAStarSearch stepped by a worker, which keeps one
+// search for all its queries. Between steps the worker checks the query's
+// cancellation token, and every few steps its deadline, and gives up with
+// QUERY_CANCELLED or QUERY_TIMED_OUT.
+//
+// A query searches the map it was submitted with, the world map as it was
+// at Submit unless a snapshot is given, so the world map may be replaced
+// and queries over different maps may run side by side. Likewise it moves
+// by the MapSearchNode rules given, or the defaults as they were at Submit,
+// so queries for different agents may share the pool. A query with its
+// start or goal off its map is QUERY_FAILED at once.
+
+class PathQueryPool {
+public:
+	enum {
+		QUERY_SUCCEEDED,
+		QUERY_FAILED,
+		QUERY_CANCELLED,
+		QUERY_TIMED_OUT
+	};
+
+	typedef std::chrono::steady_clock Clock;
+
+	// Shared between the caller and the query. Copies share the flag
+	class CancellationToken {
+	public:
+		CancellationToken();
+
+		void Cancel();
+		bool IsCancelled() const;
+
+	private:
+		std::shared_ptr<std::atomic<bool> > m_Cancelled;
+	};
+
+	struct Result {
+		Result();
+
+		int status;
+		float cost; // FLT_MAX unless the query succeeded
+		int steps;
+		std::vector<MapSearchNode> path; // start to goal, both included
+	};
+
+	PathQueryPool(int threads);
+
+	// Queries still waiting are completed as QUERY_CANCELLED, running ones
+	// are cancelled and waited for
+	virtual ~PathQueryPool();
+
+	std::future<Result> Submit(const MapSearchNode &Start,
+			const MapSearchNode &Goal,
+			CancellationToken token = CancellationToken(),
+			Clock::time_point deadline = Clock::time_point::max());
+
+	// The same over the given map
+	std::future<Result> Submit(std::shared_ptr<const MapSnapshot> map,
+			const MapSearchNode &Start, const MapSearchNode &Goal,
+			CancellationToken token = CancellationToken(),
+			Clock::time_point deadline = Clock::time_point::max());
+
+	// The same over the given map by the given rules
+	std::future<Result> Submit(std::shared_ptr<const MapSnapshot> map,
+			const MapSearchNode::Rules &rules, const MapSearchNode &Start,
+			const MapSearchNode &Goal,
+			CancellationToken token = CancellationToken(),
+			Clock::time_point deadline = Clock::time_point::max());
+
+	int GetThreadCount() const;
+
+	// Queries submitted but not yet picked up by a worker
+	int GetQueuedCount();
+
+private:
+	struct Query {
+		std::shared_ptr<const MapSnapshot> map;
+		MapSearchNode::Rules rules;
+		MapSearchNode start;
+		MapSearchNode goal;
+		CancellationToken token;
+		Clock::time_point deadline;
+		std::promise<Result> promise;
+	};
+
+	void Run();
+	Result Search(Query &query, CompactAStarSearch &search);
+
+private:
+	std::vector<std::thread> m_Threads;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_Wake;
+	std::deque<std::shared_ptr<Query> > m_Queue;
+	bool m_Stopping;
+
+	// Set on shutdown so running queries stop at their next step
+	std::atomic<bool> m_Abort;
+};
+
+#endif /* PATHQUERYPOOL_H_ */
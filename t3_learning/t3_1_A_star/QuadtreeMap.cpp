@@ -0,0 +1,393 @@
+/*
+ * QuadtreeMap.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "QuadtreeMap.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <functional>
+
+#include "Map.h"
+
+using namespace std;
+
+static const float SQRT2 = 1.41421356237f;
+
+QuadtreeMap::QuadtreeMap() :
+		m_Width(0), m_Height(0), m_Root(-1), m_OpenLeaves(0),
+		m_CurrentStamp(0), m_Expanded(0), m_Refined(0) {
+}
+
+QuadtreeMap::~QuadtreeMap() {
+}
+
+void QuadtreeMap::Build(const MapSearchNode::Rules &rules) {
+	m_Width = Map::GetWidth();
+	m_Height = Map::GetHeight();
+	m_Rules = rules;
+	m_Rules.overlay = NULL;
+
+	int side = 1;
+	while (side < m_Width || side < m_Height) {
+		side *= 2;
+	}
+
+	m_Tree.clear();
+	m_Leaves.clear();
+	m_OpenLeaves = 0;
+	m_Root = BuildNode(0, 0, side);
+
+	// Leaves get ids in tree order, the ones wholly off the map none
+	for (unsigned int i = 0; i < m_Tree.size(); i++) {
+		TreeNode &node = m_Tree[i];
+		if (node.children[0] < 0 && node.x < m_Width && node.y < m_Height) {
+			node.leaf = m_Leaves.size();
+			m_Leaves.push_back(i);
+			m_OpenLeaves += node.terrain < 9;
+		}
+	}
+
+	// Adjacency from the moves out of every cell on a leaf's rim
+	vector<unsigned int> seen(m_Leaves.size(), 0);
+	vector<int> x, y;
+	m_Offsets.assign(1, 0);
+	m_Adjacent.clear();
+
+	for (unsigned int leaf = 0; leaf < m_Leaves.size(); leaf++) {
+		const TreeNode &node = m_Tree[m_Leaves[leaf]];
+		seen[leaf] = leaf + 1;
+
+		int x1 = min(node.x + node.size, m_Width) - 1;
+		int y1 = min(node.y + node.size, m_Height) - 1;
+
+		for (int cy = node.y; node.terrain < 9 && cy <= y1; cy++) {
+			for (int cx = node.x; cx <= x1; cx++) {
+				if (cy != node.y && cy != y1 && cx != node.x && cx != x1) {
+					cx = x1 - 1;
+					continue;
+				}
+
+				MapSearchNode cell(cx, cy);
+				cell.GetSuccessors(NULL, x, y, m_Rules);
+				for (unsigned int i = 0; i < x.size(); i++) {
+					int other = GetLeafAt(x[i], y[i]);
+					if (other >= 0 && seen[other] != leaf + 1) {
+						seen[other] = leaf + 1;
+						m_Adjacent.push_back(other);
+					}
+				}
+			}
+		}
+		m_Offsets.push_back(m_Adjacent.size());
+	}
+
+	m_LeafLabels.clear();
+	m_CellLabels.clear();
+	m_Corridor.clear();
+	m_CurrentStamp = 0;
+}
+
+// Builds the subtree of the square, merging four children that are leaves of
+// the same terrain back into one
+int QuadtreeMap::BuildNode(int x, int y, int size) {
+	int index = m_Tree.size();
+	TreeNode node = { x, y, size, -1, { -1, -1, -1, -1 }, -1 };
+	m_Tree.push_back(node);
+
+	if (size == 1) {
+		m_Tree[index].terrain = GetTerrain(x, y);
+		return index;
+	}
+
+	int half = size / 2;
+	int children[4] = { BuildNode(x, y, half), BuildNode(x + half, y, half),
+			BuildNode(x, y + half, half), BuildNode(x + half, y + half, half) };
+
+	bool uniform = true;
+	for (int i = 0; i < 4; i++) {
+		const TreeNode &child = m_Tree[children[i]];
+		uniform = uniform && child.children[0] < 0 && child.terrain >= 0
+				&& child.terrain == m_Tree[children[0]].terrain;
+	}
+
+	if (uniform) {
+		m_Tree[index].terrain = m_Tree[children[0]].terrain;
+		m_Tree.resize(index + 1);
+	} else {
+		for (int i = 0; i < 4; i++) {
+			m_Tree[index].children[i] = children[i];
+		}
+	}
+	return index;
+}
+
+// Terrain as the leaves see it: cells the agent does not fit are blocked
+int QuadtreeMap::GetTerrain(int x, int y) const {
+	if (x >= m_Width || y >= m_Height
+			|| Map::GetClearance(x, y) < m_Rules.agentSize) {
+		return 9;
+	}
+	return Map::GetMap(x, y);
+}
+
+int QuadtreeMap::GetLeafCount() const {
+	return m_Leaves.size();
+}
+
+int QuadtreeMap::GetOpenLeafCount() const {
+	return m_OpenLeaves;
+}
+
+int QuadtreeMap::GetAdjacencyCount() const {
+	return m_Adjacent.size();
+}
+
+void QuadtreeMap::GetLeaf(int leaf, int &x, int &y, int &size,
+		int &terrain) const {
+	const TreeNode &node = m_Tree[m_Leaves[leaf]];
+	x = node.x;
+	y = node.y;
+	size = node.size;
+	terrain = node.terrain;
+}
+
+int QuadtreeMap::GetLeafAt(int x, int y) const {
+	if (x < 0 || x >= m_Width || y < 0 || y >= m_Height || m_Root < 0) {
+		return -1;
+	}
+
+	int index = m_Root;
+	while (m_Tree[index].children[0] >= 0) {
+		const TreeNode &node = m_Tree[index];
+		int half = node.size / 2;
+		index = node.children[(x >= node.x + half) + 2 * (y >= node.y + half)];
+	}
+	return m_Tree[index].leaf;
+}
+
+float QuadtreeMap::GetDistance(float x0, float y0, float x1, float y1) const {
+	float dx = fabsf(x1 - x0);
+	float dy = fabsf(y1 - y0);
+
+	if (m_Rules.connectivity == MapSearchNode::CONNECT_8) {
+		return max(dx, dy) + (SQRT2 - 1.0f) * min(dx, dy);
+	}
+	return dx + dy;
+}
+
+float QuadtreeMap::Query(const MapSearchNode &start,
+		const MapSearchNode &goal, vector<int> *leaves) {
+	m_Expanded = 0;
+
+	if (leaves) {
+		leaves->clear();
+	}
+
+	int startLeaf = GetLeafAt(start.x, start.y);
+	int goalLeaf = GetLeafAt(goal.x, goal.y);
+	if (startLeaf < 0 || goalLeaf < 0
+			|| m_Tree[m_Leaves[startLeaf]].terrain >= 9
+			|| m_Tree[m_Leaves[goalLeaf]].terrain >= 9) {
+		return FLT_MAX;
+	}
+
+	if (m_LeafLabels.size() != m_Leaves.size()) {
+		Label unused = { FLT_MAX, -1, 0 };
+		m_LeafLabels.assign(m_Leaves.size(), unused);
+		m_Corridor.assign(m_Leaves.size(), 0);
+	}
+	m_CurrentStamp++;
+
+	// A leaf stands at its centre, except the start's and goal's at those
+	// cells. The distance is consistent with the step costs, every terrain
+	// cost being at least 1
+
+	m_Open.clear();
+	Label &first = m_LeafLabels[startLeaf];
+	first.dist = 0.0f;
+	first.parent = -1;
+	first.stamp = m_CurrentStamp;
+	m_Open.push_back(
+			QueueEntry(GetDistance(start.x, start.y, goal.x, goal.y),
+					startLeaf));
+
+	float cost = FLT_MAX;
+
+	while (!m_Open.empty()) {
+		QueueEntry e = m_Open.front();
+		pop_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+		m_Open.pop_back();
+
+		int u = e.second;
+		const TreeNode &node = m_Tree[m_Leaves[u]];
+		float ux = node.x + (node.size - 1) * 0.5f;
+		float uy = node.y + (node.size - 1) * 0.5f;
+		if (u == startLeaf) {
+			ux = start.x;
+			uy = start.y;
+		} else if (u == goalLeaf) {
+			ux = goal.x;
+			uy = goal.y;
+		}
+
+		if (e.first > m_LeafLabels[u].dist + GetDistance(ux, uy, goal.x, goal.y)) {
+			continue;
+		}
+
+		m_Expanded++;
+		if (u == goalLeaf) {
+			cost = m_LeafLabels[u].dist;
+			break;
+		}
+
+		for (int i = m_Offsets[u]; i < m_Offsets[u + 1]; i++) {
+			int v = m_Adjacent[i];
+			const TreeNode &next = m_Tree[m_Leaves[v]];
+			if (next.terrain >= 9) {
+				continue;
+			}
+
+			float vx = next.x + (next.size - 1) * 0.5f;
+			float vy = next.y + (next.size - 1) * 0.5f;
+			if (v == startLeaf) {
+				vx = start.x;
+				vy = start.y;
+			} else if (v == goalLeaf) {
+				vx = goal.x;
+				vy = goal.y;
+			}
+
+			float dist = m_LeafLabels[u].dist
+					+ GetDistance(ux, uy, vx, vy)
+							* (node.terrain + next.terrain) * 0.5f;
+			Label &label = m_LeafLabels[v];
+
+			if (label.stamp != m_CurrentStamp || dist < label.dist) {
+				label.dist = dist;
+				label.parent = u;
+				label.stamp = m_CurrentStamp;
+				m_Open.push_back(
+						QueueEntry(dist + GetDistance(vx, vy, goal.x, goal.y),
+								v));
+				push_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+			}
+		}
+	}
+
+	if (cost != FLT_MAX && leaves) {
+		for (int v = goalLeaf; v >= 0; v = m_LeafLabels[v].parent) {
+			leaves->push_back(v);
+		}
+		reverse(leaves->begin(), leaves->end());
+	}
+	return cost;
+}
+
+float QuadtreeMap::Refine(const MapSearchNode &start,
+		const MapSearchNode &goal, const vector<int> &leaves,
+		vector<MapSearchNode> &path) {
+	m_Refined = 0;
+	path.clear();
+
+	if (m_Corridor.size() != m_Leaves.size()) {
+		Label unused = { FLT_MAX, -1, 0 };
+		m_LeafLabels.assign(m_Leaves.size(), unused);
+		m_Corridor.assign(m_Leaves.size(), 0);
+	}
+	if (m_CellLabels.size() != (unsigned int) m_Width * m_Height) {
+		Label unused = { FLT_MAX, -1, 0 };
+		m_CellLabels.assign(m_Width * m_Height, unused);
+	}
+	m_CurrentStamp++;
+
+	for (unsigned int i = 0; i < leaves.size(); i++) {
+		m_Corridor[leaves[i]] = m_CurrentStamp;
+	}
+
+	int startLeaf = GetLeafAt(start.x, start.y);
+	int goalLeaf = GetLeafAt(goal.x, goal.y);
+	if (startLeaf < 0 || goalLeaf < 0 || m_Corridor[startLeaf] != m_CurrentStamp
+			|| m_Corridor[goalLeaf] != m_CurrentStamp) {
+		return FLT_MAX;
+	}
+
+	MapSearchNode target = goal;
+	int startCell = start.y * m_Width + start.x;
+	int goalCell = goal.y * m_Width + goal.x;
+
+	m_Open.clear();
+	Label &first = m_CellLabels[startCell];
+	first.dist = 0.0f;
+	first.parent = -1;
+	first.stamp = m_CurrentStamp;
+	MapSearchNode from = start;
+	m_Open.push_back(
+			QueueEntry(from.GoalDistanceEstimate(target, m_Rules), startCell));
+
+	vector<int> x, y;
+	float cost = FLT_MAX;
+
+	while (!m_Open.empty()) {
+		QueueEntry e = m_Open.front();
+		pop_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+		m_Open.pop_back();
+
+		int cell = e.second;
+		MapSearchNode state(cell % m_Width, cell / m_Width);
+		if (e.first
+				> m_CellLabels[cell].dist
+						+ state.GoalDistanceEstimate(target, m_Rules)) {
+			continue;
+		}
+
+		m_Refined++;
+		if (cell == goalCell) {
+			cost = m_CellLabels[cell].dist;
+			break;
+		}
+
+		state.GetSuccessors(NULL, x, y, m_Rules);
+		for (unsigned int i = 0; i < x.size(); i++) {
+			int leaf = GetLeafAt(x[i], y[i]);
+			if (m_Corridor[leaf] != m_CurrentStamp) {
+				continue;
+			}
+
+			MapSearchNode successor(x[i], y[i]);
+			int next = y[i] * m_Width + x[i];
+			float dist = m_CellLabels[cell].dist
+					+ state.GetCost(successor, m_Rules);
+			Label &label = m_CellLabels[next];
+
+			if (label.stamp != m_CurrentStamp || dist < label.dist) {
+				label.dist = dist;
+				label.parent = cell;
+				label.stamp = m_CurrentStamp;
+				float h = successor.GoalDistanceEstimate(target, m_Rules);
+				m_Open.push_back(QueueEntry(dist + h, next));
+				push_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+			}
+		}
+	}
+
+	if (cost != FLT_MAX) {
+		for (int cell = goalCell; cell >= 0; cell = m_CellLabels[cell].parent) {
+			path.push_back(MapSearchNode(cell % m_Width, cell / m_Width));
+		}
+		reverse(path.begin(), path.end());
+	}
+	return cost;
+}
+
+int QuadtreeMap::GetExpandedCount() const {
+	return m_Expanded;
+}
+
+int QuadtreeMap::GetRefinedCount() const {
+	return m_Refined;
+}
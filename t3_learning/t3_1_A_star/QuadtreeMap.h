@@ -0,0 +1,113 @@
+/*
+ * QuadtreeMap.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef QUADTREEMAP_H_
+#define QUADTREEMAP_H_
+
+#include <vector>
+#include <utility>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+// Quadtree form of the world map. Aligned squares whose cells all have the
+// same terrain cost (or are all blocked) are merged into one leaf, so open
+// terrain collapses into a few large leaves. Two leaves are adjacent when a
+// MapSearchNode move leads from a cell of one into the other, so adjacency
+// follows the rules it is built for, and queries keep to them.
+//
+// Query() runs A* over the leaves, a leaf standing at its centre, or at the
+// start or goal cell in their own leaves. A step between leaves costs the
+// distance between them, under the movement's metric, times the mean of
+// their terrain costs. The result is quick but not optimal on the grid.
+// Refine() turns the leaves into cells with an exact search of the cells
+// inside them.
+
+class QuadtreeMap {
+public:
+	// Distance and leaf, kept in a min heap by the searches
+	typedef std::pair<float, int> QueueEntry;
+
+	QuadtreeMap();
+	virtual ~QuadtreeMap();
+
+	// Builds the tree and the adjacency of the current world map under the
+	// given rules, the defaults as they are now unless given
+	void Build(const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	int GetLeafCount() const;
+	int GetOpenLeafCount() const;
+	int GetAdjacencyCount() const;
+
+	// Top left corner and side of a leaf, and its terrain cost, 9 if
+	// blocked
+	void GetLeaf(int leaf, int &x, int &y, int &size, int &terrain) const;
+
+	// The leaf holding the cell, -1 off the map
+	int GetLeafAt(int x, int y) const;
+
+	// Returns the cost of the leaf path from start to goal, or FLT_MAX if
+	// there is none. If leaves is not NULL it receives the path's leaves,
+	// start's first
+	float Query(const MapSearchNode &start, const MapSearchNode &goal,
+			std::vector<int> *leaves);
+
+	// Cheapest cell path from start to goal through the given leaves only,
+	// start and goal included. Returns its cost, FLT_MAX if there is none
+	float Refine(const MapSearchNode &start, const MapSearchNode &goal,
+			const std::vector<int> &leaves, std::vector<MapSearchNode> &path);
+
+	// Leaves expanded by the last query, cells by the last refinement
+	int GetExpandedCount() const;
+	int GetRefinedCount() const;
+
+private:
+	struct TreeNode {
+		int x;
+		int y;
+		int size;
+		int terrain; // 9 if blocked, -1 if the children differ
+		int children[4]; // -1 for a leaf
+		int leaf;
+	};
+
+	// Search state of one leaf or cell, valid only while stamp matches
+	struct Label {
+		float dist;
+		int parent;
+		unsigned int stamp;
+	};
+
+	int BuildNode(int x, int y, int size);
+	int GetTerrain(int x, int y) const;
+	float GetDistance(float x0, float y0, float x1, float y1) const;
+
+private:
+	int m_Width;
+	int m_Height;
+	MapSearchNode::Rules m_Rules;
+
+	std::vector<TreeNode> m_Tree;
+	int m_Root;
+
+	// Tree node of each leaf, and the leaves adjacent to each in CSR form
+	std::vector<int> m_Leaves;
+	std::vector<int> m_Offsets;
+	std::vector<int> m_Adjacent;
+	int m_OpenLeaves;
+
+	// Per search scratch space, reset through the stamps
+	std::vector<Label> m_LeafLabels;
+	std::vector<Label> m_CellLabels;
+	std::vector<unsigned int> m_Corridor;
+	std::vector<QueueEntry> m_Open;
+	unsigned int m_CurrentStamp;
+	int m_Expanded;
+	int m_Refined;
+};
+
+#endif /* QUADTREEMAP_H_ */
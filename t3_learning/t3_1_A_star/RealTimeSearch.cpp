@@ -0,0 +1,271 @@
+/*
+ * RealTimeSearch.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "RealTimeSearch.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "AStarSearch.h"
+#include "Map.h"
+
+using namespace std;
+
+RealTimeSearch::RealTimeSearch() :
+		m_Width(0), m_Height(0), m_Lookahead(64), m_GoalStamp(0),
+		m_SearchStamp(0), m_PathPosition(0), m_Goal(-1, -1), m_Position(0),
+		m_State(AStarSearch::SEARCH_STATE_NOT_INITIALISED), m_Travelled(0.0f),
+		m_Moves(0), m_Expanded(0), m_TotalExpanded(0) {
+}
+
+RealTimeSearch::~RealTimeSearch() {
+}
+
+void RealTimeSearch::SetLookahead(int expansions) {
+	m_Lookahead = max(1, expansions);
+}
+
+int RealTimeSearch::GetLookahead() const {
+	return m_Lookahead;
+}
+
+void RealTimeSearch::SetStartAndGoalStates(MapSearchNode &Start,
+		MapSearchNode &Goal, const MapSearchNode::Rules &rules) {
+	if (Map::GetWidth() != m_Width || Map::GetHeight() != m_Height) {
+		m_Width = Map::GetWidth();
+		m_Height = Map::GetHeight();
+
+		Label unused = { FLT_MAX, -1, 0, false };
+		m_Labels.assign(m_Width * m_Height, unused);
+		m_Heuristic.assign(m_Width * m_Height, 0.0f);
+		m_HeuristicStamp.assign(m_Width * m_Height, 0);
+		m_SearchStamp = 0;
+		m_GoalStamp++;
+	} else if (!Goal.IsSameState(m_Goal) || !(rules == m_Rules)) {
+		m_GoalStamp++;
+	}
+
+	m_Rules = rules;
+	m_Goal = Goal;
+	m_Path.clear();
+	m_PathPosition = 0;
+	m_Travelled = 0.0f;
+	m_Moves = 0;
+	m_Expanded = 0;
+	m_TotalExpanded = 0;
+
+	if (!Start.IsOnMap() || !Goal.IsOnMap()) {
+		m_Position = 0;
+		m_State = AStarSearch::SEARCH_STATE_FAILED;
+		return;
+	}
+	m_Position = Start.y * m_Width + Start.x;
+
+	m_State = Start.IsSameState(Goal) ?
+			AStarSearch::SEARCH_STATE_SUCCEEDED :
+			AStarSearch::SEARCH_STATE_SEARCHING;
+}
+
+void RealTimeSearch::ResetLearning() {
+	m_GoalStamp++;
+}
+
+unsigned int RealTimeSearch::SearchStep() {
+	assert(
+			(m_State > AStarSearch::SEARCH_STATE_NOT_INITIALISED)
+					&& (m_State < AStarSearch::SEARCH_STATE_INVALID));
+
+	m_Expanded = 0;
+	if (m_State != AStarSearch::SEARCH_STATE_SEARCHING) {
+		return m_State;
+	}
+
+	if (m_PathPosition >= m_Path.size() && !Plan()) {
+		m_State = AStarSearch::SEARCH_STATE_FAILED;
+		return m_State;
+	}
+
+	MapSearchNode from(m_Position % m_Width, m_Position / m_Width);
+	m_Position = m_Path[m_PathPosition++];
+	MapSearchNode to(m_Position % m_Width, m_Position / m_Width);
+
+	m_Travelled += from.GetCost(to, m_Rules);
+	m_Moves++;
+
+	if (to.IsSameState(m_Goal)) {
+		m_State = AStarSearch::SEARCH_STATE_SUCCEEDED;
+	}
+	return m_State;
+}
+
+// Lookahead, learning and the walk to the best frontier cell. Returns false
+// if the lookahead ran out of cells without finding the goal
+bool RealTimeSearch::Plan() {
+	int goal = m_Goal.y * m_Width + m_Goal.x;
+	m_SearchStamp++;
+	m_Open.clear();
+	m_Closed.clear();
+
+	Label &first = m_Labels[m_Position];
+	first.g = 0.0f;
+	first.parent = -1;
+	first.stamp = m_SearchStamp;
+	first.closed = false;
+	m_Open.push_back(QueueEntry(GetHeuristic(m_Position), m_Position));
+
+	int target = -1;
+
+	while (!m_Open.empty()) {
+		QueueEntry e = m_Open.front();
+		int cell = e.second;
+		Label &label = m_Labels[cell];
+
+		// Entries of cells reached more cheaply since, or closed, are stale
+		if (label.closed || e.first > label.g + GetHeuristic(cell)) {
+			pop_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+			m_Open.pop_back();
+			continue;
+		}
+
+		// The goal or the least f cell left when the budget is spent is
+		// where the agent heads, still open
+		if (cell == goal || (int) m_Closed.size() >= m_Lookahead) {
+			target = cell;
+			break;
+		}
+
+		pop_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+		m_Open.pop_back();
+		label.closed = true;
+		m_Closed.push_back(cell);
+
+		MapSearchNode state(cell % m_Width, cell / m_Width);
+		state.GetSuccessors(NULL, m_SuccessorX, m_SuccessorY, m_Rules);
+
+		for (unsigned int i = 0; i < m_SuccessorX.size(); i++) {
+			MapSearchNode successor(m_SuccessorX[i], m_SuccessorY[i]);
+			int next = successor.y * m_Width + successor.x;
+			float g = label.g + state.GetCost(successor, m_Rules);
+			Label &nextLabel = m_Labels[next];
+
+			if (nextLabel.stamp != m_SearchStamp) {
+				nextLabel.stamp = m_SearchStamp;
+				nextLabel.closed = false;
+			} else if (nextLabel.closed || nextLabel.g <= g) {
+				continue;
+			}
+
+			nextLabel.g = g;
+			nextLabel.parent = cell;
+			m_Open.push_back(QueueEntry(g + GetHeuristic(next), next));
+			push_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+		}
+	}
+
+	m_Expanded = m_Closed.size();
+	m_TotalExpanded += m_Expanded;
+
+	if (target < 0) {
+		return false;
+	}
+
+	// Learning: every closed cell takes the least cost to the frontier plus
+	// the frontier cell's heuristic. The open list is reused for the pass
+	for (unsigned int i = 0; i < m_Closed.size(); i++) {
+		SetHeuristic(m_Closed[i], FLT_MAX);
+	}
+
+	vector<QueueEntry> frontier;
+	frontier.swap(m_Open);
+	for (unsigned int i = 0; i < frontier.size(); i++) {
+		int cell = frontier[i].second;
+		if (!m_Labels[cell].closed) {
+			m_Open.push_back(QueueEntry(GetHeuristic(cell), cell));
+		}
+	}
+	make_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+
+	// Moves without the overlay are symmetric, so the cells that can step
+	// here are the ones this cell can step to, unless a unit holds it
+	MapSearchNode::Rules moves = m_Rules;
+	moves.overlay = NULL;
+
+	while (!m_Open.empty()) {
+		QueueEntry e = m_Open.front();
+		pop_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+		m_Open.pop_back();
+
+		int cell = e.second;
+		if (e.first > GetHeuristic(cell)) {
+			continue;
+		}
+
+		MapSearchNode state(cell % m_Width, cell / m_Width);
+		if (state.IsOccupied(m_Rules)) {
+			continue;
+		}
+		state.GetSuccessors(NULL, m_SuccessorX, m_SuccessorY, moves);
+
+		for (unsigned int i = 0; i < m_SuccessorX.size(); i++) {
+			MapSearchNode predecessor(m_SuccessorX[i], m_SuccessorY[i]);
+			int previous = predecessor.y * m_Width + predecessor.x;
+			const Label &label = m_Labels[previous];
+			if (label.stamp != m_SearchStamp || !label.closed) {
+				continue;
+			}
+
+			float h = e.first + predecessor.GetCost(state, moves);
+			if (h < GetHeuristic(previous)) {
+				SetHeuristic(previous, h);
+				m_Open.push_back(QueueEntry(h, previous));
+				push_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+			}
+		}
+	}
+
+	m_Path.clear();
+	m_PathPosition = 0;
+	for (int cell = target; cell != m_Position; cell = m_Labels[cell].parent) {
+		m_Path.push_back(cell);
+	}
+	reverse(m_Path.begin(), m_Path.end());
+	return true;
+}
+
+float RealTimeSearch::GetHeuristic(int cell) {
+	if (m_HeuristicStamp[cell] == m_GoalStamp) {
+		return m_Heuristic[cell];
+	}
+
+	MapSearchNode state(cell % m_Width, cell / m_Width);
+	return state.GoalDistanceEstimate(m_Goal, m_Rules);
+}
+
+void RealTimeSearch::SetHeuristic(int cell, float h) {
+	m_Heuristic[cell] = h;
+	m_HeuristicStamp[cell] = m_GoalStamp;
+}
+
+MapSearchNode RealTimeSearch::GetPosition() const {
+	return MapSearchNode(m_Position % m_Width, m_Position / m_Width);
+}
+
+float RealTimeSearch::GetTravelledCost() const {
+	return m_Travelled;
+}
+
+int RealTimeSearch::GetMoveCount() const {
+	return m_Moves;
+}
+
+int RealTimeSearch::GetExpandedCount() const {
+	return m_Expanded;
+}
+
+long RealTimeSearch::GetTotalExpandedCount() const {
+	return m_TotalExpanded;
+}
@@ -0,0 +1,117 @@
+/*
+ * RealTimeSearch.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef REALTIMESEARCH_H_
+#define REALTIMESEARCH_H_
+
+#include <vector>
+#include <utility>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+// LSS-LRTA*: real-time search for an agent that must move before it knows
+// the whole path. Each plan is an A* lookahead from the agent's cell capped
+// at a number of expansions, after which the heuristic of every expanded
+// cell is raised by a Dijkstra pass from the lookahead's frontier. The
+// agent then walks towards the frontier cell of least f, one cell per
+// SearchStep(), and plans again when it gets there. So a step costs at most
+// one bounded lookahead and its learning, however far the goal.
+//
+// The learned heuristic is kept per cell while the goal stays the same, so
+// repeated trips to one goal converge on an optimal path. It assumes moves
+// are symmetric, as MapSearchNode's are without the overlay, which learning
+// tests on the cell moved onto.
+//
+// Uses the AStarSearch::SEARCH_STATE_* values. An unreachable goal is only
+// reported once a lookahead has taken in all of the agent's region, until
+// then the agent wanders it.
+
+class RealTimeSearch {
+public:
+	// Distance and cell, kept in a min heap by the lookahead and learning
+	typedef std::pair<float, int> QueueEntry;
+
+	RealTimeSearch();
+	virtual ~RealTimeSearch();
+
+	// Most cells a lookahead may expand, at least 1. Default 64
+	void SetLookahead(int expansions);
+	int GetLookahead() const;
+
+	// Puts the agent at Start, to move by the given rules or the defaults
+	// as they are now. The heuristic learned so far is kept if Goal is the
+	// goal of the last trip on a map of the same size under the same rules.
+	// A start or goal off the map fails the trip at once, the agent at (0, 0)
+	void SetStartAndGoalStates(MapSearchNode &Start, MapSearchNode &Goal,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Forgets the learned heuristic, for when the map has changed
+	void ResetLearning();
+
+	// Moves the agent one cell, planning first if it has reached the end of
+	// its last plan
+	unsigned int SearchStep();
+
+	MapSearchNode GetPosition() const;
+
+	// Cost and number of the moves made since the start
+	float GetTravelledCost() const;
+	int GetMoveCount() const;
+
+	// Cells expanded by the last step, 0 if it did not plan, and by all
+	// steps since the start
+	int GetExpandedCount() const;
+	long GetTotalExpandedCount() const;
+
+private:
+	// Lookahead state of one cell, valid only while stamp matches
+	struct Label {
+		float g;
+		int parent;
+		unsigned int stamp;
+		bool closed;
+	};
+
+	bool Plan();
+	float GetHeuristic(int cell);
+	void SetHeuristic(int cell, float h);
+
+private:
+	int m_Width;
+	int m_Height;
+	int m_Lookahead;
+
+	// Learned heuristic of each cell, valid only while its stamp matches
+	std::vector<float> m_Heuristic;
+	std::vector<unsigned int> m_HeuristicStamp;
+	unsigned int m_GoalStamp;
+
+	std::vector<Label> m_Labels;
+	unsigned int m_SearchStamp;
+	std::vector<QueueEntry> m_Open;
+	std::vector<int> m_Closed;
+
+	// Cells left to walk of the last plan
+	std::vector<int> m_Path;
+	unsigned int m_PathPosition;
+
+	MapSearchNode::Rules m_Rules;
+	MapSearchNode m_Goal;
+	int m_Position;
+	unsigned int m_State;
+
+	float m_Travelled;
+	int m_Moves;
+	int m_Expanded;
+	long m_TotalExpanded;
+
+	std::vector<int> m_SuccessorX;
+	std::vector<int> m_SuccessorY;
+};
+
+#endif /* REALTIMESEARCH_H_ */
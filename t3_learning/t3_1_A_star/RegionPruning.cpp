@@ -0,0 +1,585 @@
+/*
+ * RegionPruning.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "RegionPruning.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <functional>
+#include <utility>
+
+#include "Map.h"
+
+// Same order as the moves in MapSearchNode.cpp
+const int PRUNING_MOVE_X[8] = { -1, 0, 1, 0, -1, 1, 1, -1 };
+const int PRUNING_MOVE_Y[8] = { 0, -1, 0, 1, -1, -1, 1, 1 };
+
+// Swamp candidates are the cells of SWAMP_TILE x SWAMP_TILE tiles, and the
+// way round one is looked for up to SWAMP_MARGIN cells away
+const int SWAMP_TILE = 4;
+const int SWAMP_MARGIN = 8;
+
+typedef std::pair<float, int> QueueEntry;
+typedef std::vector<QueueEntry> Queue;
+
+RegionPruning::RegionPruning() :
+		m_Width(0), m_Height(0), m_Blocks(0), m_Articulations(0),
+		m_Swamps(0), m_SwampCells(0), m_Stamp(0), m_StartSwamp(-1),
+		m_GoalSwamp(-1), m_CurrentDistanceStamp(0) {
+}
+
+RegionPruning::~RegionPruning() {
+}
+
+void RegionPruning::Build(const MapSearchNode::Rules &rules) {
+	m_Width = Map::GetWidth();
+	m_Height = Map::GetHeight();
+	m_Rules = rules;
+	m_Rules.overlay = NULL;
+
+	FindMoves();
+	FindBlocks();
+	BuildBlockTree();
+	FindSwamps();
+
+	m_TreeStamp.assign(m_TreeParent.size(), 0);
+	m_Stamp = 0;
+}
+
+void RegionPruning::Prepare(const MapSearchNode &start,
+		const MapSearchNode &goal) {
+	m_Stamp++;
+	m_StartSwamp = m_GoalSwamp = -1;
+
+	if (start.x < 0 || start.x >= m_Width || start.y < 0
+			|| start.y >= m_Height || goal.x < 0 || goal.x >= m_Width
+			|| goal.y < 0 || goal.y >= m_Height) {
+		return;
+	}
+
+	int startCell = start.y * m_Width + start.x;
+	int goalCell = goal.y * m_Width + goal.x;
+	m_StartSwamp = m_CellSwamp[startCell];
+	m_GoalSwamp = m_CellSwamp[goalCell];
+
+	int from = GetTreeNode(startCell);
+	int to = GetTreeNode(goalCell);
+	if (from >= 0 && to >= 0) {
+		MarkTreePath(from, to);
+	}
+}
+
+bool RegionPruning::IsAllowed(int x, int y) const {
+	if (x < 0 || x >= m_Width || y < 0 || y >= m_Height) {
+		return false;
+	}
+
+	int cell = y * m_Width + x;
+	int swamp = m_CellSwamp[cell];
+	if (swamp >= 0 && swamp != m_StartSwamp && swamp != m_GoalSwamp) {
+		return false;
+	}
+
+	int block = m_CellBlock[cell];
+	if (block >= 0) {
+		return m_TreeStamp[block] == m_Stamp;
+	}
+	if (block == -1) {
+		return false;
+	}
+
+	// An articulation cell can be crossed inside any block it belongs to
+	int articulation = -2 - block;
+	if (m_TreeStamp[m_Blocks + articulation] == m_Stamp) {
+		return true;
+	}
+	for (int i = m_ArticulationOffsets[articulation];
+			i < m_ArticulationOffsets[articulation + 1]; i++) {
+		if (m_TreeStamp[m_ArticulationBlocks[i]] == m_Stamp) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int RegionPruning::GetBlockCount() const {
+	return m_Blocks;
+}
+
+int RegionPruning::GetSwampCount() const {
+	return m_Swamps;
+}
+
+int RegionPruning::GetSwampCellCount() const {
+	return m_SwampCells;
+}
+
+void RegionPruning::FindMoves() {
+	m_Moves.assign(m_Width * m_Height, 0);
+	std::vector<int> x, y;
+
+	for (int cell = 0; cell < m_Width * m_Height; cell++) {
+		MapSearchNode state(cell % m_Width, cell / m_Width);
+		if (Map::GetClearance(state.x, state.y) < m_Rules.agentSize) {
+			continue;
+		}
+
+		state.GetSuccessors(NULL, x, y, m_Rules);
+		for (unsigned int i = 0; i < x.size(); i++) {
+			for (int d = 0; d < 8; d++) {
+				if (x[i] - state.x == PRUNING_MOVE_X[d]
+						&& y[i] - state.y == PRUNING_MOVE_Y[d]) {
+					m_Moves[cell] |= 1 << d;
+				}
+			}
+		}
+	}
+}
+
+// Tarjan's biconnected components, with an explicit stack since corridors
+// make the search as deep as the map is big
+void RegionPruning::FindBlocks() {
+	struct Frame {
+		int cell;
+		int parent;
+		int next;
+	};
+
+	int cells = m_Width * m_Height;
+	std::vector<int> discovered(cells, -1);
+	std::vector<int> low(cells, 0);
+	std::vector<int> cellStack;
+	std::vector<Frame> frames;
+
+	// (cell, block) for every membership, grouped by cell below
+	std::vector<std::pair<int, int> > members;
+	int time = 0;
+	m_Blocks = 0;
+
+	for (int root = 0; root < cells; root++) {
+		if (discovered[root] >= 0
+				|| Map::GetClearance(root % m_Width, root / m_Width)
+						< m_Rules.agentSize) {
+			continue;
+		}
+
+		discovered[root] = low[root] = time++;
+		cellStack.push_back(root);
+		Frame rootFrame = { root, -1, 0 };
+		frames.push_back(rootFrame);
+		bool rootInBlock = false;
+
+		while (!frames.empty()) {
+			Frame &f = frames.back();
+			int cell = f.cell;
+
+			bool descended = false;
+			while (f.next < 8) {
+				int d = f.next++;
+				if (!(m_Moves[cell] & (1 << d))) {
+					continue;
+				}
+
+				int w = cell + PRUNING_MOVE_Y[d] * m_Width + PRUNING_MOVE_X[d];
+				if (discovered[w] < 0) {
+					discovered[w] = low[w] = time++;
+					cellStack.push_back(w);
+					Frame child = { w, cell, 0 };
+					frames.push_back(child);
+					descended = true;
+					break;
+				}
+				if (w != f.parent) {
+					low[cell] = std::min(low[cell], discovered[w]);
+				}
+			}
+			if (descended) {
+				continue;
+			}
+
+			int parent = f.parent;
+			frames.pop_back();
+			if (parent < 0) {
+				continue;
+			}
+
+			low[parent] = std::min(low[parent], low[cell]);
+			if (low[cell] >= discovered[parent]) {
+				// parent separates everything stacked from cell on
+				int w;
+				do {
+					w = cellStack.back();
+					cellStack.pop_back();
+					members.push_back(std::make_pair(w, m_Blocks));
+				} while (w != cell);
+				members.push_back(std::make_pair(parent, m_Blocks));
+				m_Blocks++;
+
+				rootInBlock = rootInBlock || parent == root;
+			}
+		}
+
+		// Only the root is left on the stack. Alone it is a block of its own
+		cellStack.clear();
+		if (!rootInBlock) {
+			members.push_back(std::make_pair(root, m_Blocks++));
+		}
+	}
+
+	std::sort(members.begin(), members.end());
+
+	m_CellBlock.assign(cells, -1);
+	m_ArticulationOffsets.assign(1, 0);
+	m_ArticulationBlocks.clear();
+	m_Articulations = 0;
+
+	for (unsigned int i = 0; i < members.size();) {
+		unsigned int j = i;
+		while (j < members.size() && members[j].first == members[i].first) {
+			j++;
+		}
+
+		if (j - i == 1) {
+			m_CellBlock[members[i].first] = members[i].second;
+		} else {
+			m_CellBlock[members[i].first] = -2 - m_Articulations++;
+			for (unsigned int k = i; k < j; k++) {
+				m_ArticulationBlocks.push_back(members[k].second);
+			}
+			m_ArticulationOffsets.push_back(m_ArticulationBlocks.size());
+		}
+		i = j;
+	}
+}
+
+void RegionPruning::BuildBlockTree() {
+	int nodes = m_Blocks + m_Articulations;
+	m_TreeParent.assign(nodes, -1);
+	m_TreeDepth.assign(nodes, -1);
+
+	// Blocks of each articulation cell are known, the reverse is not
+	std::vector<std::vector<int> > blockArticulations(m_Blocks);
+	for (int a = 0; a < m_Articulations; a++) {
+		for (int i = m_ArticulationOffsets[a]; i < m_ArticulationOffsets[a + 1];
+				i++) {
+			blockArticulations[m_ArticulationBlocks[i]].push_back(a);
+		}
+	}
+
+	std::vector<int> queue;
+	for (int root = 0; root < m_Blocks; root++) {
+		if (m_TreeDepth[root] >= 0) {
+			continue;
+		}
+
+		m_TreeDepth[root] = 0;
+		queue.assign(1, root);
+
+		for (unsigned int head = 0; head < queue.size(); head++) {
+			int node = queue[head];
+
+			if (node < m_Blocks) {
+				for (unsigned int i = 0; i < blockArticulations[node].size();
+						i++) {
+					int next = m_Blocks + blockArticulations[node][i];
+					if (m_TreeDepth[next] < 0) {
+						m_TreeDepth[next] = m_TreeDepth[node] + 1;
+						m_TreeParent[next] = node;
+						queue.push_back(next);
+					}
+				}
+			} else {
+				int a = node - m_Blocks;
+				for (int i = m_ArticulationOffsets[a];
+						i < m_ArticulationOffsets[a + 1]; i++) {
+					int next = m_ArticulationBlocks[i];
+					if (m_TreeDepth[next] < 0) {
+						m_TreeDepth[next] = m_TreeDepth[node] + 1;
+						m_TreeParent[next] = node;
+						queue.push_back(next);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Stamps every node on the tree path between the two, climbing from the
+// deeper one until they meet. In different trees there is no path at all, so
+// only the start's node is stamped and the search fails quickly
+void RegionPruning::MarkTreePath(int from, int to) {
+	int a = from;
+	int b = to;
+
+	while (m_TreeDepth[a] > m_TreeDepth[b]) {
+		m_TreeStamp[a] = m_Stamp;
+		a = m_TreeParent[a];
+	}
+	while (m_TreeDepth[b] > m_TreeDepth[a]) {
+		m_TreeStamp[b] = m_Stamp;
+		b = m_TreeParent[b];
+	}
+	while (a != b && a >= 0 && b >= 0) {
+		m_TreeStamp[a] = m_Stamp;
+		m_TreeStamp[b] = m_Stamp;
+		a = m_TreeParent[a];
+		b = m_TreeParent[b];
+	}
+
+	if (a < 0 || b < 0) {
+		m_Stamp++;
+		m_TreeStamp[from] = m_Stamp;
+		return;
+	}
+	m_TreeStamp[a] = m_Stamp;
+}
+
+int RegionPruning::GetTreeNode(int cell) const {
+	int block = m_CellBlock[cell];
+	if (block == -1) {
+		return -1;
+	}
+	return block >= 0 ? block : m_Blocks + (-2 - block);
+}
+
+float RegionPruning::GetCost(int from, int direction) const {
+	MapSearchNode state(from % m_Width, from / m_Width);
+	MapSearchNode successor(state.x + PRUNING_MOVE_X[direction],
+			state.y + PRUNING_MOVE_Y[direction]);
+	return state.GetCost(successor, m_Rules);
+}
+
+void RegionPruning::FindSwamps() {
+	int cells = m_Width * m_Height;
+	m_CellSwamp.assign(cells, -1);
+	m_Swamps = 0;
+	m_SwampCells = 0;
+
+	m_Distance.assign(cells, FLT_MAX);
+	m_DistanceStamp.assign(cells, 0);
+	m_CurrentDistanceStamp = 0;
+	m_InRegion.assign(cells, -1);
+
+	std::vector<int> tile, region;
+
+	for (int ty = 0; ty < m_Height; ty += SWAMP_TILE) {
+		for (int tx = 0; tx < m_Width; tx += SWAMP_TILE) {
+			int x1 = std::min(tx + SWAMP_TILE, m_Width);
+			int y1 = std::min(ty + SWAMP_TILE, m_Height);
+
+			// Each connected part of the tile is a candidate of its own
+			tile.clear();
+			for (int y = ty; y < y1; y++) {
+				for (int x = tx; x < x1; x++) {
+					if (m_CellBlock[y * m_Width + x] != -1) {
+						tile.push_back(y * m_Width + x);
+					}
+				}
+			}
+
+			for (unsigned int i = 0; i < tile.size(); i++) {
+				if (m_CellSwamp[tile[i]] != -1) {
+					continue;
+				}
+
+				// -2 marks cells taken by a candidate that failed
+				region.assign(1, tile[i]);
+				m_CellSwamp[tile[i]] = -2;
+				for (unsigned int head = 0; head < region.size(); head++) {
+					int cell = region[head];
+					for (int d = 0; d < 8; d++) {
+						if (!(m_Moves[cell] & (1 << d))) {
+							continue;
+						}
+						int x = cell % m_Width + PRUNING_MOVE_X[d];
+						int y = cell / m_Width + PRUNING_MOVE_Y[d];
+						int w = y * m_Width + x;
+						if (x >= tx && x < x1 && y >= ty && y < y1
+								&& m_CellSwamp[w] == -1) {
+							m_CellSwamp[w] = -2;
+							region.push_back(w);
+						}
+					}
+				}
+
+				bool swamp = IsSwamp(region, m_Swamps);
+				for (unsigned int j = 0; j < region.size(); j++) {
+					m_CellSwamp[region[j]] = swamp ? m_Swamps : -2;
+				}
+				if (swamp) {
+					m_Swamps++;
+					m_SwampCells += region.size();
+				}
+			}
+
+			for (unsigned int i = 0; i < tile.size(); i++) {
+				if (m_CellSwamp[tile[i]] == -2) {
+					m_CellSwamp[tile[i]] = -1;
+				}
+			}
+		}
+	}
+}
+
+// The region may be skipped if, for every cell u next to it and every cell v
+// next to it, getting from u to v through the region is never cheaper than
+// going round it, without entering swamps found earlier either. Any path
+// through the region can then be rerouted round it for no more
+bool RegionPruning::IsSwamp(const std::vector<int> &region, int swamp) {
+	int minX = m_Width, minY = m_Height, maxX = 0, maxY = 0;
+	for (unsigned int i = 0; i < region.size(); i++) {
+		m_InRegion[region[i]] = swamp;
+		minX = std::min(minX, region[i] % m_Width);
+		maxX = std::max(maxX, region[i] % m_Width);
+		minY = std::min(minY, region[i] / m_Width);
+		maxY = std::max(maxY, region[i] / m_Width);
+	}
+	minX = std::max(0, minX - SWAMP_MARGIN);
+	minY = std::max(0, minY - SWAMP_MARGIN);
+	maxX = std::min(m_Width - 1, maxX + SWAMP_MARGIN);
+	maxY = std::min(m_Height - 1, maxY + SWAMP_MARGIN);
+
+	std::vector<int> border;
+	for (unsigned int i = 0; i < region.size(); i++) {
+		for (int d = 0; d < 8; d++) {
+			if (!(m_Moves[region[i]] & (1 << d))) {
+				continue;
+			}
+			int w = region[i] + PRUNING_MOVE_Y[d] * m_Width
+					+ PRUNING_MOVE_X[d];
+			if (m_InRegion[w] != swamp
+					&& std::find(border.begin(), border.end(), w)
+							== border.end()) {
+				border.push_back(w);
+			}
+		}
+	}
+
+	bool result = !border.empty();
+	std::vector<float> through(border.size());
+	Queue open;
+
+	for (unsigned int u = 0; result && u < border.size(); u++) {
+		// Through: from u into the region, on inside it, out to the border
+		m_CurrentDistanceStamp++;
+		open.assign(1, QueueEntry(0.0f, border[u]));
+		m_Distance[border[u]] = 0.0f;
+		m_DistanceStamp[border[u]] = m_CurrentDistanceStamp;
+
+		while (!open.empty()) {
+			QueueEntry e = open.front();
+			std::pop_heap(open.begin(), open.end(),
+					std::greater<QueueEntry>());
+			open.pop_back();
+
+			int cell = e.second;
+			if (e.first > m_Distance[cell]) {
+				continue;
+			}
+			bool inside = m_InRegion[cell] == swamp;
+			if (!inside && cell != border[u]) {
+				continue;
+			}
+
+			for (int d = 0; d < 8; d++) {
+				if (!(m_Moves[cell] & (1 << d))) {
+					continue;
+				}
+				int w = cell + PRUNING_MOVE_Y[d] * m_Width + PRUNING_MOVE_X[d];
+
+				// From u the only way is in
+				if (!inside && m_InRegion[w] != swamp) {
+					continue;
+				}
+
+				float g = e.first + GetCost(cell, d);
+				if (m_DistanceStamp[w] != m_CurrentDistanceStamp
+						|| g < m_Distance[w]) {
+					m_Distance[w] = g;
+					m_DistanceStamp[w] = m_CurrentDistanceStamp;
+					open.push_back(QueueEntry(g, w));
+					std::push_heap(open.begin(), open.end(),
+							std::greater<QueueEntry>());
+				}
+			}
+		}
+
+		float limit = -1.0f;
+		for (unsigned int v = 0; v < border.size(); v++) {
+			through[v] = FLT_MAX;
+			if (v != u
+					&& m_DistanceStamp[border[v]] == m_CurrentDistanceStamp) {
+				through[v] = m_Distance[border[v]];
+				limit = std::max(limit, through[v]);
+			}
+		}
+		if (limit < 0.0f) {
+			continue;
+		}
+
+		// Round: within the window, avoiding the region, passing no earlier
+		// swamp, and no further than the dearest way through
+		m_CurrentDistanceStamp++;
+		open.assign(1, QueueEntry(0.0f, border[u]));
+		m_Distance[border[u]] = 0.0f;
+		m_DistanceStamp[border[u]] = m_CurrentDistanceStamp;
+
+		while (!open.empty()) {
+			QueueEntry e = open.front();
+			std::pop_heap(open.begin(), open.end(),
+					std::greater<QueueEntry>());
+			open.pop_back();
+
+			int cell = e.second;
+			if (e.first > m_Distance[cell]) {
+				continue;
+			}
+			if (e.first > limit) {
+				break;
+			}
+			if (cell != border[u] && m_CellSwamp[cell] >= 0) {
+				continue;
+			}
+
+			for (int d = 0; d < 8; d++) {
+				if (!(m_Moves[cell] & (1 << d))) {
+					continue;
+				}
+				int x = cell % m_Width + PRUNING_MOVE_X[d];
+				int y = cell / m_Width + PRUNING_MOVE_Y[d];
+				int w = y * m_Width + x;
+				if (x < minX || x > maxX || y < minY || y > maxY
+						|| m_InRegion[w] == swamp) {
+					continue;
+				}
+
+				float g = e.first + GetCost(cell, d);
+				if (m_DistanceStamp[w] != m_CurrentDistanceStamp
+						|| g < m_Distance[w]) {
+					m_Distance[w] = g;
+					m_DistanceStamp[w] = m_CurrentDistanceStamp;
+					open.push_back(QueueEntry(g, w));
+					std::push_heap(open.begin(), open.end(),
+							std::greater<QueueEntry>());
+				}
+			}
+		}
+
+		for (unsigned int v = 0; result && v < border.size(); v++) {
+			if (through[v] == FLT_MAX) {
+				continue;
+			}
+			result = m_DistanceStamp[border[v]] == m_CurrentDistanceStamp
+					&& m_Distance[border[v]] <= through[v];
+		}
+	}
+
+	for (unsigned int i = 0; i < region.size(); i++) {
+		m_InRegion[region[i]] = -1;
+	}
+	return result;
+}
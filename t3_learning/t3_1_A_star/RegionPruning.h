@@ -0,0 +1,102 @@
+/*
+ * RegionPruning.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef REGIONPRUNING_H_
+#define REGIONPRUNING_H_
+
+#include <vector>
+
+#include "MapSearchNode.h"
+
+// Preprocessing that lets a search skip parts of the map no optimal path
+// between a given start and goal needs to enter.
+//
+// Dead ends: the map's grid graph is split into biconnected blocks, joined at
+// the articulation cells (single cell doorways and corridors). A shortest
+// path only ever visits the blocks along the path between the start's and
+// the goal's block in the block-cut tree; a room behind a one cell door is
+// skipped unless the start or goal is inside it.
+//
+// Swamps: the map is cut into small tiles, and a tile's cells form a swamp
+// if between any two cells around it going round is never dearer than going
+// through. Swamps are accepted one at a time, each checked with the earlier
+// ones removed, so all of them can be skipped at once. A swamp holding the
+// start or goal is kept.
+//
+// Built for the map in force at the time and the rules it is given, the
+// defaults as they are then unless given, and assumes moves are symmetric
+// like MapSearchNode's. A start or goal the agent
+// does not fit on allows nothing, and the search fails at once.
+
+class RegionPruning {
+public:
+	RegionPruning();
+	virtual ~RegionPruning();
+
+	void Build(const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Works out the cells a search from start to goal may use
+	void Prepare(const MapSearchNode &start, const MapSearchNode &goal);
+
+	// Whether the last prepared search may use the cell
+	bool IsAllowed(int x, int y) const;
+
+	int GetBlockCount() const;
+	int GetSwampCount() const;
+	int GetSwampCellCount() const;
+
+private:
+	void FindMoves();
+	void FindBlocks();
+	void BuildBlockTree();
+	void FindSwamps();
+	bool IsSwamp(const std::vector<int> &region, int swamp);
+	void MarkTreePath(int from, int to);
+	int GetTreeNode(int cell) const;
+	float GetCost(int from, int direction) const;
+
+private:
+	int m_Width;
+	int m_Height;
+	MapSearchNode::Rules m_Rules;
+
+	// Moves out of each cell, bit i set for direction i in MapSearchNode
+	// order
+	std::vector<unsigned char> m_Moves;
+
+	// Block of each cell. Articulation cells belong to several, they hold
+	// -2 - their index into m_ArticulationBlocks instead
+	std::vector<int> m_CellBlock;
+	std::vector<int> m_ArticulationOffsets;
+	std::vector<int> m_ArticulationBlocks;
+	int m_Blocks;
+	int m_Articulations;
+
+	// Block-cut forest: blocks are nodes 0 to m_Blocks - 1, articulation
+	// cells come after. Each node's parent, -1 at a root, and depth
+	std::vector<int> m_TreeParent;
+	std::vector<int> m_TreeDepth;
+
+	// Swamp of each cell, -1 for none
+	std::vector<int> m_CellSwamp;
+	int m_Swamps;
+	int m_SwampCells;
+
+	// Tree nodes on the current path carry the current stamp
+	std::vector<unsigned int> m_TreeStamp;
+	unsigned int m_Stamp;
+	int m_StartSwamp;
+	int m_GoalSwamp;
+
+	// Scratch for the swamp checks
+	std::vector<float> m_Distance;
+	std::vector<unsigned int> m_DistanceStamp;
+	unsigned int m_CurrentDistanceStamp;
+	std::vector<int> m_InRegion;
+};
+
+#endif /* REGIONPRUNING_H_ */
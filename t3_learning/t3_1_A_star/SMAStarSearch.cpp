@@ -0,0 +1,357 @@
+/*
+ * SMAStarSearch.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "SMAStarSearch.h"
+
+#include "AStarSearch.h"
+#include "Map.h"
+
+SMAStarSearch::Node::Node() :
+		parent(0), g(0.0f), f(0.0f), depth(0), expanded(false), open(false),
+		id(0), sameCell(0) {
+}
+
+bool SMAStarSearch::NodeCompare::operator ()(const Node *x,
+		const Node *y) const {
+	if (x->f != y->f) {
+		return x->f < y->f;
+	}
+	if (x->depth != y->depth) {
+		return x->depth > y->depth;
+	}
+	return x->id < y->id;
+}
+
+SMAStarSearch::SMAStarSearch(int nodeBudget) :
+		m_NodeBudget(nodeBudget), m_NodeCount(0), m_PeakNodeCount(0),
+		m_Forgotten(0), m_Truncated(false), m_NextId(0),
+		m_State(AStarSearch::SEARCH_STATE_NOT_INITIALISED), m_Steps(0),
+		m_Root(NULL), m_CurrentSolutionNode(0), m_SolutionCost(FLT_MAX) {
+}
+
+SMAStarSearch::~SMAStarSearch() {
+	FreeAllNodes();
+}
+
+void SMAStarSearch::SetStartAndGoalStates(MapSearchNode &Start,
+		MapSearchNode &Goal, const MapSearchNode::Rules &rules) {
+	FreeAllNodes();
+
+	m_Rules = rules;
+	m_Goal = Goal;
+	m_Steps = 0;
+	m_Forgotten = 0;
+	m_Truncated = false;
+	m_PeakNodeCount = 0;
+	m_Solution.clear();
+	m_SolutionCost = FLT_MAX;
+
+	if (m_NodeBudget < 1) {
+		m_State = AStarSearch::SEARCH_STATE_OUT_OF_MEMORY;
+		return;
+	}
+
+	m_Root = AllocateNode(Start, NULL, 0.0f);
+	m_Root->f = Start.GoalDistanceEstimate(m_Goal, m_Rules);
+	SetOpen(m_Root, true);
+
+	m_State = AStarSearch::SEARCH_STATE_SEARCHING;
+}
+
+unsigned int SMAStarSearch::SearchStep() {
+	assert(
+			(m_State > AStarSearch::SEARCH_STATE_NOT_INITIALISED)
+					&& (m_State < AStarSearch::SEARCH_STATE_INVALID));
+
+	if (m_State != AStarSearch::SEARCH_STATE_SEARCHING) {
+		return m_State;
+	}
+
+	// Nothing left that can reach the goal. That is only the budget's fault
+	// if some path was cut short for not fitting in memory
+	if (m_OpenList.empty() || (*m_OpenList.begin())->f == FLT_MAX) {
+		m_State = m_Truncated ?
+				AStarSearch::SEARCH_STATE_OUT_OF_MEMORY :
+				AStarSearch::SEARCH_STATE_FAILED;
+		FreeAllNodes();
+		return m_State;
+	}
+
+	m_Steps++;
+
+	Node *n = *m_OpenList.begin();
+
+	if (n->m_StateNode.IsGoal(m_Goal)) {
+		for (Node *p = n; p; p = p->parent) {
+			m_Solution.push_back(p->m_StateNode);
+		}
+		reverse(m_Solution.begin(), m_Solution.end());
+		m_SolutionCost = n->g;
+
+		FreeAllNodes();
+		m_State = AStarSearch::SEARCH_STATE_SUCCEEDED;
+		return m_State;
+	}
+
+	Expand(n);
+
+	return m_State;
+}
+
+void SMAStarSearch::Expand(Node *n) {
+	std::vector<int> x, y;
+	n->m_StateNode.GetSuccessors(n->parent ? &n->parent->m_StateNode : NULL,
+			x, y, m_Rules);
+
+	int parentCell = GetCell(n->m_StateNode);
+
+	for (unsigned int i = 0; i < x.size(); i++) {
+		MapSearchNode state(x[i], y[i]);
+
+		// Still in memory from an earlier expansion
+		bool present = false;
+		for (unsigned int j = 0; j < n->children.size(); j++) {
+			if (n->children[j]->m_StateNode.IsSameState(state)) {
+				present = true;
+				break;
+			}
+		}
+		if (present) {
+			continue;
+		}
+
+		float g = n->g + n->m_StateNode.GetCost(state, m_Rules);
+		int cell = GetCell(state);
+
+		// The f this child had when it was last forgotten, if it was
+		float forgottenF = 0.0f;
+		for (unsigned int j = 0; j < n->forgotten.size(); j++) {
+			if (n->forgotten[j].first == cell) {
+				forgottenF = n->forgotten[j].second;
+				n->forgotten.erase(n->forgotten.begin() + j);
+				break;
+			}
+		}
+
+		// Only the cheapest known way into a cell is worth keeping. The
+		// node that took it may be forgotten later, but then its own parent
+		// still regenerates it through the same parent cell
+		if (IsWorsePath(cell, g, parentCell)) {
+			continue;
+		}
+
+		int depth = n->depth + 1;
+		float f = std::max(n->f,
+				g + state.GoalDistanceEstimate(m_Goal, m_Rules));
+		f = std::max(f, forgottenF);
+
+		// A path that would not fit in memory can never be completed
+		if (!state.IsGoal(m_Goal) && depth >= m_NodeBudget - 1) {
+			f = FLT_MAX;
+			m_Truncated = true;
+		}
+
+		// Make room first. If everything in memory is more promising the
+		// child is forgotten straight away
+		if (m_NodeCount >= m_NodeBudget && !ForgetWorstLeaf(n, f, depth)) {
+			n->forgotten.push_back(std::make_pair(cell, f));
+			continue;
+		}
+
+		Node *child = AllocateNode(state, n, g);
+		child->f = f;
+		n->children.push_back(child);
+		SetOpen(child, true);
+	}
+
+	n->expanded = true;
+
+	// n stays open while part of it is forgotten. A dead end stays open
+	// too, backed up to infinity so it is the first to go
+	if (!n->children.empty() && n->forgotten.empty()) {
+		SetOpen(n, false);
+	}
+	Backup(n);
+}
+
+bool SMAStarSearch::ForgetWorstLeaf(Node *keep, float f, int depth) {
+	for (OpenSet::reverse_iterator it = m_OpenList.rbegin();
+			it != m_OpenList.rend(); it++) {
+		Node *w = *it;
+
+		if (!w->children.empty() || w == m_Root || w == keep) {
+			continue;
+		}
+
+		// The worst leaf is still better than what we want to make room for
+		if (w->f < f || (w->f == f && w->depth >= depth)) {
+			return false;
+		}
+
+		Node *p = w->parent;
+
+		p->forgotten.push_back(std::make_pair(GetCell(w->m_StateNode), w->f));
+		p->children.erase(find(p->children.begin(), p->children.end(), w));
+
+		SetOpen(w, false);
+		FreeNode(w);
+		m_Forgotten++;
+
+		// The parent has to regenerate w if it is ever the best again
+		SetOpen(p, true);
+		Backup(p);
+		return true;
+	}
+
+	return false;
+}
+
+void SMAStarSearch::Backup(Node *n) {
+	while (n && n->expanded) {
+		float f = FLT_MAX;
+		for (unsigned int i = 0; i < n->forgotten.size(); i++) {
+			f = std::min(f, n->forgotten[i].second);
+		}
+		for (unsigned int i = 0; i < n->children.size(); i++) {
+			f = std::min(f, n->children[i]->f);
+		}
+
+		if (f == n->f) {
+			return;
+		}
+
+		SetF(n, f);
+		n = n->parent;
+	}
+}
+
+void SMAStarSearch::SetOpen(Node *n, bool open) {
+	if (n->open == open) {
+		return;
+	}
+
+	if (open) {
+		m_OpenList.insert(n);
+	} else {
+		m_OpenList.erase(n);
+	}
+	n->open = open;
+}
+
+void SMAStarSearch::SetF(Node *n, float f) {
+	// The open set is ordered by f, so take the node out while it changes
+	bool open = n->open;
+	SetOpen(n, false);
+	n->f = f;
+	SetOpen(n, open);
+}
+
+bool SMAStarSearch::IsWorsePath(int cell, float g, int parentCell) const {
+	CellIndex::const_iterator it = m_Cells.find(cell);
+	if (it == m_Cells.end()) {
+		return false;
+	}
+
+	for (const Node *w = it->second; w; w = w->sameCell) {
+		int wParentCell = w->parent ? GetCell(w->parent->m_StateNode) : -1;
+		if (w->g < g || (w->g == g && wParentCell != parentCell)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+SMAStarSearch::Node *SMAStarSearch::AllocateNode(MapSearchNode &state,
+		Node *parent, float g) {
+	Node *node = new Node;
+	node->m_StateNode = state;
+	node->parent = parent;
+	node->g = g;
+	node->depth = parent ? parent->depth + 1 : 0;
+	node->id = m_NextId++;
+
+	Node *&first = m_Cells[GetCell(state)];
+	node->sameCell = first;
+	first = node;
+
+	m_NodeCount++;
+	m_PeakNodeCount = std::max(m_PeakNodeCount, m_NodeCount);
+	return node;
+}
+
+void SMAStarSearch::FreeNode(Node *node) {
+	CellIndex::iterator it = m_Cells.find(GetCell(node->m_StateNode));
+	Node **link = &it->second;
+	while (*link != node) {
+		link = &(*link)->sameCell;
+	}
+	*link = node->sameCell;
+	if (!it->second) {
+		m_Cells.erase(it);
+	}
+
+	m_NodeCount--;
+	delete node;
+}
+
+void SMAStarSearch::FreeAllNodes() {
+	std::vector<Node *> stack;
+	if (m_Root) {
+		stack.push_back(m_Root);
+	}
+
+	while (!stack.empty()) {
+		Node *n = stack.back();
+		stack.pop_back();
+		stack.insert(stack.end(), n->children.begin(), n->children.end());
+		delete n;
+	}
+
+	m_Root = NULL;
+	m_OpenList.clear();
+	m_Cells.clear();
+	m_NodeCount = 0;
+}
+
+int SMAStarSearch::GetCell(const MapSearchNode &state) const {
+	return state.y * Map::GetWidth() + state.x;
+}
+
+MapSearchNode *SMAStarSearch::GetSolutionStart() {
+	m_CurrentSolutionNode = 0;
+	if (m_Solution.empty()) {
+		return NULL;
+	}
+	return &m_Solution[0];
+}
+
+MapSearchNode *SMAStarSearch::GetSolutionNext() {
+	if (m_CurrentSolutionNode + 1 >= m_Solution.size()) {
+		return NULL;
+	}
+	return &m_Solution[++m_CurrentSolutionNode];
+}
+
+float SMAStarSearch::GetSolutionCost() {
+	return m_SolutionCost;
+}
+
+int SMAStarSearch::GetStepCount() {
+	return m_Steps;
+}
+
+int SMAStarSearch::GetNodeCount() {
+	return m_NodeCount;
+}
+
+int SMAStarSearch::GetPeakNodeCount() {
+	return m_PeakNodeCount;
+}
+
+int SMAStarSearch::GetForgottenCount() {
+	return m_Forgotten;
+}
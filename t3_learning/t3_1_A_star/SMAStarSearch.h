@@ -0,0 +1,139 @@
+/*
+ * SMAStarSearch.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef SMASTARSEARCH_H_
+#define SMASTARSEARCH_H_
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <utility>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+// Simplified memory-bounded A* (SMA*). It behaves like A* until the node
+// budget is used up; from then on it forgets the leaf with the highest f to
+// make room, backing that f up into the parent so the branch can be
+// regenerated if it ever becomes the most promising again. The search only
+// gives up with SEARCH_STATE_OUT_OF_MEMORY when the budget cannot even hold
+// the path to the goal.
+//
+// The nodes in memory are also found by cell, so a cell is not added again
+// by a path no cheaper than one a node there already took. That index is
+// part of the nodes and within the budget with them. What is known of a
+// cell goes once all its nodes are forgotten, so while memory is short a
+// regenerated branch may follow paths that were already found worse.
+//
+// Uses the AStarSearch::SEARCH_STATE_* values.
+
+class SMAStarSearch {
+public:
+	SMAStarSearch(int nodeBudget);
+	virtual ~SMAStarSearch();
+
+	// Set Start and goal states, and the rules to move by, the defaults as
+	// they are now unless given
+	void SetStartAndGoalStates(MapSearchNode &Start, MapSearchNode &Goal,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Advances search one step
+	unsigned int SearchStep();
+
+	// Functions for traversing the solution
+	MapSearchNode *GetSolutionStart();
+	MapSearchNode *GetSolutionNext();
+
+	// Get final cost of solution
+	// Returns FLT_MAX if there is no solution
+	float GetSolutionCost();
+
+	// Get the number of steps
+	int GetStepCount();
+
+	// Nodes in memory now, and the most there have been at once
+	int GetNodeCount();
+	int GetPeakNodeCount();
+
+	// Nodes dropped to stay within the budget
+	int GetForgottenCount();
+
+private:
+	class Node {
+	public:
+		Node();
+
+		Node *parent;
+		std::vector<Node *> children;
+
+		float g;
+		float f;
+		int depth;
+
+		// Cell and backed up f of each child forgotten since it was last
+		// generated, so regenerating it does not lose what was learnt
+		std::vector<std::pair<int, float> > forgotten;
+		bool expanded;
+		bool open;
+		unsigned int id;
+
+		// The next node in memory for the same cell
+		Node *sameCell;
+
+		MapSearchNode m_StateNode;
+	};
+
+	// Best first: lowest f, then deepest. The worst leaf is at the other end
+	class NodeCompare {
+	public:
+		bool operator()(const Node *x, const Node *y) const;
+	};
+
+	typedef std::set<Node *, NodeCompare> OpenSet;
+
+	// The nodes in memory for each cell, linked through sameCell
+	typedef std::unordered_map<int, Node *> CellIndex;
+
+	Node *AllocateNode(MapSearchNode &state, Node *parent, float g);
+	bool IsWorsePath(int cell, float g, int parentCell) const;
+	void FreeNode(Node *node);
+	void FreeAllNodes();
+
+	void Expand(Node *n);
+	bool ForgetWorstLeaf(Node *keep, float f, int depth);
+	void Backup(Node *n);
+	void SetOpen(Node *n, bool open);
+	void SetF(Node *n, float f);
+	int GetCell(const MapSearchNode &state) const;
+
+private:
+	int m_NodeBudget;
+	int m_NodeCount;
+	int m_PeakNodeCount;
+	int m_Forgotten;
+
+	// Set once a path was cut at the depth the budget allows, so running out
+	// of open nodes means the budget was too small
+	bool m_Truncated;
+	unsigned int m_NextId;
+
+	unsigned int m_State;
+	int m_Steps;
+
+	MapSearchNode::Rules m_Rules;
+	Node *m_Root;
+	MapSearchNode m_Goal;
+	OpenSet m_OpenList;
+
+	CellIndex m_Cells;
+
+	std::vector<MapSearchNode> m_Solution;
+	unsigned int m_CurrentSolutionNode;
+	float m_SolutionCost;
+};
+
+#endif /* SMASTARSEARCH_H_ */
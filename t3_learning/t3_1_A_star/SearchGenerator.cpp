@@ -0,0 +1,116 @@
+/*
+ * SearchGenerator.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "SearchGenerator.h"
+
+#include <algorithm>
+
+SearchGenerator SearchGenerator::promise_type::get_return_object() {
+	return SearchGenerator(Handle::from_promise(*this));
+}
+
+std::suspend_always SearchGenerator::promise_type::initial_suspend() {
+	return std::suspend_always();
+}
+
+std::suspend_always SearchGenerator::promise_type::final_suspend() noexcept {
+	return std::suspend_always();
+}
+
+std::suspend_always SearchGenerator::promise_type::yield_value(
+		const SearchProgress &progress) {
+	m_Progress = progress;
+	return std::suspend_always();
+}
+
+void SearchGenerator::promise_type::return_void() {
+}
+
+void SearchGenerator::promise_type::unhandled_exception() {
+	m_Exception = std::current_exception();
+}
+
+SearchGenerator::Iterator::Iterator(Handle handle) :
+		m_Handle(handle) {
+}
+
+const SearchProgress &SearchGenerator::Iterator::operator*() const {
+	return m_Handle.promise().m_Progress;
+}
+
+SearchGenerator::Iterator &SearchGenerator::Iterator::operator++() {
+	m_Handle.resume();
+	if (m_Handle.promise().m_Exception) {
+		std::rethrow_exception(m_Handle.promise().m_Exception);
+	}
+	return *this;
+}
+
+bool SearchGenerator::Iterator::operator==(std::default_sentinel_t) const {
+	return m_Handle.done();
+}
+
+SearchGenerator::SearchGenerator(Handle handle) :
+		m_Handle(handle) {
+}
+
+SearchGenerator::SearchGenerator(SearchGenerator &&other) :
+		m_Handle(other.m_Handle) {
+	other.m_Handle = Handle();
+}
+
+SearchGenerator::~SearchGenerator() {
+	if (m_Handle) {
+		m_Handle.destroy();
+	}
+}
+
+bool SearchGenerator::Next() {
+	if (m_Handle.done()) {
+		return false;
+	}
+
+	m_Handle.resume();
+	if (m_Handle.promise().m_Exception) {
+		std::rethrow_exception(m_Handle.promise().m_Exception);
+	}
+	return !m_Handle.done();
+}
+
+const SearchProgress &SearchGenerator::Get() const {
+	return m_Handle.promise().m_Progress;
+}
+
+SearchGenerator::Iterator SearchGenerator::begin() {
+	Next();
+	return Iterator(m_Handle);
+}
+
+std::default_sentinel_t SearchGenerator::end() {
+	return std::default_sentinel;
+}
+
+SearchGenerator IncrementalSearch(AStarSearch &search, int stepsPerYield) {
+	SearchProgress progress;
+	progress.state = AStarSearch::SEARCH_STATE_SEARCHING;
+	progress.steps = 0;
+	stepsPerYield = std::max(stepsPerYield, 1);
+
+	while (progress.state == AStarSearch::SEARCH_STATE_SEARCHING) {
+		for (int i = 0;
+				i < stepsPerYield
+						&& progress.state
+								== AStarSearch::SEARCH_STATE_SEARCHING; i++) {
+			progress.state = search.SearchStep();
+		}
+
+		progress.steps = search.GetStepCount();
+		search.GetBestPartialPath(progress.partialPath);
+
+		co_yield progress;
+	}
+}
@@ -0,0 +1,90 @@
+/*
+ * SearchGenerator.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef SEARCHGENERATOR_H_
+#define SEARCHGENERATOR_H_
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+#include "AStarSearch.h"
+#include "MapSearchNode.h"
+
+// Incremental search as a C++20 coroutine. IncrementalSearch steps an
+// AStarSearch and suspends every stepsPerYield expansions with the state of
+// the search and its best partial path, the path to the open node with the
+// lowest f. The last value yielded has the final state.
+//
+// Either iterate it:
+//
+//	for (const SearchProgress &progress : IncrementalSearch(search, 16)) {
+//		...
+//	}
+//
+// or keep several and call Next on each in turn, which interleaves the
+// searches on one thread with no scheduler. Needs -std=c++20.
+
+struct SearchProgress {
+	unsigned int state;
+	int steps;
+	std::vector<MapSearchNode> partialPath;
+};
+
+class SearchGenerator {
+public:
+	struct promise_type {
+		SearchProgress m_Progress;
+		std::exception_ptr m_Exception;
+
+		SearchGenerator get_return_object();
+		std::suspend_always initial_suspend();
+		std::suspend_always final_suspend() noexcept;
+		std::suspend_always yield_value(const SearchProgress &progress);
+		void return_void();
+		void unhandled_exception();
+	};
+
+	typedef std::coroutine_handle<promise_type> Handle;
+
+	class Iterator {
+	public:
+		explicit Iterator(Handle handle);
+
+		const SearchProgress &operator*() const;
+		Iterator &operator++();
+		bool operator==(std::default_sentinel_t) const;
+
+	private:
+		Handle m_Handle;
+	};
+
+	explicit SearchGenerator(Handle handle);
+	SearchGenerator(SearchGenerator &&other);
+	SearchGenerator(const SearchGenerator &) = delete;
+	SearchGenerator &operator=(const SearchGenerator &) = delete;
+	virtual ~SearchGenerator();
+
+	// Runs the search on to its next yield. Returns false once it has ended
+	bool Next();
+
+	// What was yielded last
+	const SearchProgress &Get() const;
+
+	Iterator begin();
+	std::default_sentinel_t end();
+
+private:
+	Handle m_Handle;
+};
+
+// The search must have had its start and goal set. It is stepped until it
+// ends, and its solution is left for the caller as usual. stepsPerYield is
+// taken as at least 1
+SearchGenerator IncrementalSearch(AStarSearch &search, int stepsPerYield);
+
+#endif /* SEARCHGENERATOR_H_ */
@@ -0,0 +1,255 @@
+/*
+ * SearchTrace.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "SearchTrace.h"
+
+#include <string.h>
+
+#include "Map.h"
+
+// Same order as the moves in MapSearchNode.cpp
+const int TRACE_MOVE_X[8] = { -1, 0, 1, 0, -1, 1, 1, -1 };
+const int TRACE_MOVE_Y[8] = { 0, -1, 0, 1, -1, -1, 1, 1 };
+
+const char TRACE_MAGIC[4] = { 'S', 'T', 'R', '1' };
+
+SearchTraceRecorder::SearchTraceRecorder() :
+		m_Recording(false) {
+}
+
+SearchTraceRecorder::~SearchTraceRecorder() {
+}
+
+bool SearchTraceRecorder::BeginSearch(const MapSearchNode &start,
+		const MapSearchNode &goal) {
+	// The start record has 16 bits for each dimension
+	m_Recording = Map::GetWidth() <= 0xffff && Map::GetHeight() <= 0xffff;
+	if (!m_Recording) {
+		return false;
+	}
+
+	m_Data.push_back('S');
+	Put16(Map::GetWidth());
+	Put16(Map::GetHeight());
+	Put16(start.x);
+	Put16(start.y);
+	Put16(goal.x);
+	Put16(goal.y);
+	return true;
+}
+
+void SearchTraceRecorder::RecordStep(const MapSearchNode &node, float g,
+		float h, const std::vector<int> &successorX,
+		const std::vector<int> &successorY, int openSize) {
+	if (!m_Recording) {
+		return;
+	}
+
+	unsigned int successors = 0;
+	for (unsigned int i = 0; i < successorX.size(); i++) {
+		for (int d = 0; d < 8; d++) {
+			if (successorX[i] - node.x == TRACE_MOVE_X[d]
+					&& successorY[i] - node.y == TRACE_MOVE_Y[d]) {
+				successors |= 1 << d;
+			}
+		}
+	}
+
+	m_Data.push_back('E');
+	Put16(node.x);
+	Put16(node.y);
+	PutFloat(g);
+	PutFloat(h);
+	m_Data.push_back(successors);
+
+	unsigned int size = openSize;
+	while (size >= 0x80) {
+		m_Data.push_back((size & 0x7f) | 0x80);
+		size >>= 7;
+	}
+	m_Data.push_back(size);
+}
+
+void SearchTraceRecorder::EndSearch(unsigned int state, float cost,
+		int steps) {
+	if (!m_Recording) {
+		return;
+	}
+	m_Recording = false;
+
+	m_Data.push_back('F');
+	m_Data.push_back(state);
+	PutFloat(cost);
+	Put32(steps);
+}
+
+const std::vector<unsigned char> &SearchTraceRecorder::GetData() const {
+	return m_Data;
+}
+
+void SearchTraceRecorder::Clear() {
+	m_Data.clear();
+}
+
+bool SearchTraceRecorder::Append(const char *fileName) const {
+	FILE *file = fopen(fileName, "ab");
+
+	if (!file) {
+		return false;
+	}
+
+	bool ok = fseek(file, 0, SEEK_END) == 0;
+	if (ok && ftell(file) == 0) {
+		ok = fwrite(TRACE_MAGIC, 1, 4, file) == 4;
+	}
+	ok = ok
+			&& (m_Data.empty()
+					|| fwrite(&m_Data[0], 1, m_Data.size(), file)
+							== m_Data.size());
+
+	return (fclose(file) == 0) && ok;
+}
+
+void SearchTraceRecorder::Put16(unsigned int value) {
+	m_Data.push_back(value & 0xff);
+	m_Data.push_back((value >> 8) & 0xff);
+}
+
+void SearchTraceRecorder::Put32(unsigned int value) {
+	Put16(value & 0xffff);
+	Put16(value >> 16);
+}
+
+void SearchTraceRecorder::PutFloat(float value) {
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+	Put32(bits);
+}
+
+SearchTraceReader::SearchTraceReader() :
+		m_File(NULL), m_Valid(false) {
+}
+
+SearchTraceReader::~SearchTraceReader() {
+	Close();
+}
+
+bool SearchTraceReader::Open(const char *fileName) {
+	Close();
+
+	m_File = fopen(fileName, "rb");
+	if (!m_File) {
+		return false;
+	}
+
+	unsigned char magic[4];
+	m_Valid = Get(magic, 4) && memcmp(magic, TRACE_MAGIC, 4) == 0;
+	if (!m_Valid) {
+		Close();
+	}
+	return m_Valid;
+}
+
+void SearchTraceReader::Close() {
+	if (m_File) {
+		fclose(m_File);
+		m_File = NULL;
+	}
+}
+
+bool SearchTraceReader::Next(Record &record) {
+	if (!m_File || !m_Valid) {
+		return false;
+	}
+
+	int type = fgetc(m_File);
+	if (type == EOF) {
+		return false;
+	}
+
+	int x = 0, y = 0;
+	unsigned char byte;
+
+	switch (type) {
+	case 'S':
+		record.type = RECORD_START;
+		m_Valid = Get16(record.width) && Get16(record.height)
+				&& Get16(record.start.x) && Get16(record.start.y)
+				&& Get16(record.goal.x) && Get16(record.goal.y);
+		break;
+
+	case 'E':
+		record.type = RECORD_EXPANSION;
+		m_Valid = Get16(x) && Get16(y) && GetFloat(record.g)
+				&& GetFloat(record.h) && Get(&byte, 1);
+		record.node = MapSearchNode(x, y);
+		record.successors = byte;
+
+		record.openSize = 0;
+		for (int shift = 0; m_Valid; shift += 7) {
+			m_Valid = shift < 32 && Get(&byte, 1);
+			record.openSize |= (unsigned int) (byte & 0x7f) << shift;
+			if (!(byte & 0x80)) {
+				break;
+			}
+		}
+		break;
+
+	case 'F':
+		record.type = RECORD_END;
+		m_Valid = Get(&byte, 1) && GetFloat(record.cost)
+				&& Get32(record.steps);
+		record.state = byte;
+		break;
+
+	default:
+		m_Valid = false;
+		break;
+	}
+
+	return m_Valid;
+}
+
+bool SearchTraceReader::IsValid() const {
+	return m_Valid;
+}
+
+MapSearchNode SearchTraceReader::GetSuccessor(const MapSearchNode &node,
+		int i) {
+	return MapSearchNode(node.x + TRACE_MOVE_X[i], node.y + TRACE_MOVE_Y[i]);
+}
+
+bool SearchTraceReader::Get(unsigned char *data, int size) {
+	return fread(data, 1, size, m_File) == (size_t) size;
+}
+
+bool SearchTraceReader::Get16(int &value) {
+	unsigned char data[2];
+	if (!Get(data, 2)) {
+		return false;
+	}
+	value = data[0] | (data[1] << 8);
+	return true;
+}
+
+bool SearchTraceReader::Get32(unsigned int &value) {
+	int low, high;
+	if (!Get16(low) || !Get16(high)) {
+		return false;
+	}
+	value = low | ((unsigned int) high << 16);
+	return true;
+}
+
+bool SearchTraceReader::GetFloat(float &value) {
+	unsigned int bits;
+	if (!Get32(bits)) {
+		return false;
+	}
+	memcpy(&value, &bits, sizeof(value));
+	return true;
+}
@@ -0,0 +1,118 @@
+/*
+ * SearchTrace.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef SEARCHTRACE_H_
+#define SEARCHTRACE_H_
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "MapSearchNode.h"
+
+// Binary trace of searches, step by step, for looking into a slow query
+// offline rather than reproducing it live.
+//
+// A trace file starts with "STR1" and then holds any number of searches,
+// each a run of records. Every record is a type byte followed by its fields,
+// 16 and 32 bit values with the low byte first:
+//   'S' search start: width, height, start x, y, goal x, y (16 bit each)
+//   'E' expansion: x, y (16 bit), g, h (float), a byte with bit i set for a
+//       successor in direction i, in MapSearchNode order, then the open list
+//       size after the step, 7 bits a byte, low bits first, top bit set on
+//       all but the last byte
+//   'F' search end: the AStarSearch::SEARCH_STATE_* value (byte), the cost
+//       (float) and the step count (32 bit)
+// An expansion takes 14 bytes plus a byte per 7 bits of the open list size,
+// so 15 bytes for open lists under 128 nodes and 16 under 16384. Maps wider
+// or taller than 65535 cells do not fit the start record and go untraced.
+//
+// The recorder keeps the trace in memory, so a caller can trace every query
+// and only append the ones worth keeping to a file.
+
+class SearchTraceRecorder {
+public:
+	SearchTraceRecorder();
+	virtual ~SearchTraceRecorder();
+
+	// Returns false for a map too large for the trace, in which case nothing
+	// is recorded until EndSearch()
+	bool BeginSearch(const MapSearchNode &start, const MapSearchNode &goal);
+	void RecordStep(const MapSearchNode &node, float g, float h,
+			const std::vector<int> &successorX,
+			const std::vector<int> &successorY, int openSize);
+	void EndSearch(unsigned int state, float cost, int steps);
+
+	// Records since the last Clear(), without the file magic
+	const std::vector<unsigned char> &GetData() const;
+	void Clear();
+
+	// Appends the records to the file, starting it if it is empty. The
+	// records are kept, Clear() them once written
+	bool Append(const char *fileName) const;
+
+private:
+	void Put16(unsigned int value);
+	void Put32(unsigned int value);
+	void PutFloat(float value);
+
+private:
+	std::vector<unsigned char> m_Data;
+	bool m_Recording;
+};
+
+class SearchTraceReader {
+public:
+	enum {
+		RECORD_START, RECORD_EXPANSION, RECORD_END
+	};
+
+	// Fields not used by a record type are left as they were
+	struct Record {
+		int type;
+		int width;
+		int height;
+		MapSearchNode start;
+		MapSearchNode goal;
+
+		MapSearchNode node;
+		float g;
+		float h;
+		unsigned int successors;
+		unsigned int openSize;
+
+		unsigned int state;
+		float cost;
+		unsigned int steps;
+	};
+
+	SearchTraceReader();
+	virtual ~SearchTraceReader();
+
+	bool Open(const char *fileName);
+	void Close();
+
+	// Reads the next record. Returns false at the end of the file, or if the
+	// file is malformed, in which case IsValid() turns false
+	bool Next(Record &record);
+	bool IsValid() const;
+
+	// The cell reached from (x, y) by successor bit i
+	static MapSearchNode GetSuccessor(const MapSearchNode &node, int i);
+
+private:
+	bool Get(unsigned char *data, int size);
+	bool Get16(int &value);
+	bool Get32(unsigned int &value);
+	bool GetFloat(float &value);
+
+private:
+	FILE *m_File;
+	bool m_Valid;
+};
+
+#endif /* SEARCHTRACE_H_ */
@@ -0,0 +1,534 @@
+/*
+ * SubgoalGraph.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#include "SubgoalGraph.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <functional>
+
+#include "Map.h"
+
+using namespace std;
+
+static const int SSG_FILE_VERSION = 1;
+
+static const float SQRT2 = 1.41421356237f;
+
+SubgoalGraph::SubgoalGraph() :
+		m_Width(0), m_Height(0), m_Terrain(0), m_CurrentStamp(0),
+		m_Expanded(0) {
+}
+
+SubgoalGraph::~SubgoalGraph() {
+}
+
+bool SubgoalGraph::Build(const MapSearchNode::Rules &rules) {
+	Clear();
+
+	if (!IsSupported(rules)) {
+		return false;
+	}
+	m_Rules = rules;
+	m_Rules.overlay = NULL;
+
+	m_Width = Map::GetWidth();
+	m_Height = Map::GetHeight();
+	m_Terrain = 0;
+
+	for (int y = 0; y < m_Height; y++) {
+		for (int x = 0; x < m_Width; x++) {
+			if (!IsOpen(x, y)) {
+				continue;
+			}
+			if (m_Terrain == 0) {
+				m_Terrain = Map::GetMap(x, y);
+			} else if (Map::GetMap(x, y) != m_Terrain) {
+				Clear();
+				return false;
+			}
+		}
+	}
+
+	// Subgoals: an obstacle diagonally next to the cell, with both cells
+	// between open so the corner can be turned
+	m_CellSubgoal.assign(m_Width * m_Height, -1);
+	for (int y = 0; y < m_Height; y++) {
+		for (int x = 0; x < m_Width; x++) {
+			if (!IsOpen(x, y)) {
+				continue;
+			}
+
+			bool corner = false;
+			for (int dy = -1; dy <= 1; dy += 2) {
+				for (int dx = -1; dx <= 1; dx += 2) {
+					corner = corner
+							|| (!IsOpen(x + dx, y + dy) && IsOpen(x + dx, y)
+									&& IsOpen(x, y + dy));
+				}
+			}
+
+			if (corner) {
+				m_CellSubgoal[y * m_Width + x] = m_Cells.size();
+				m_Cells.push_back(y * m_Width + x);
+			}
+		}
+	}
+
+	vector<int> reachable;
+	m_Offsets.assign(1, 0);
+	for (unsigned int s = 0; s < m_Cells.size(); s++) {
+		GetDirectHReachable(m_Cells[s], reachable);
+		for (unsigned int i = 0; i < reachable.size(); i++) {
+			m_Targets.push_back(m_CellSubgoal[reachable[i]]);
+		}
+		m_Offsets.push_back(m_Targets.size());
+	}
+
+	return true;
+}
+
+// Writes and reads an int vector without its length, which the format
+// already knows from the header
+static bool WriteInts(FILE *file, const vector<int> &v) {
+	return v.empty() || fwrite(&v[0], sizeof(int), v.size(), file) == v.size();
+}
+
+// Whether count ints are left in the file, checked before making room for
+// them so a bad count cannot ask for any amount of memory
+static bool FitsInFile(FILE *file, int count) {
+	long position = ftell(file);
+	if (position < 0 || fseek(file, 0, SEEK_END) != 0) {
+		return false;
+	}
+
+	long end = ftell(file);
+	return fseek(file, position, SEEK_SET) == 0
+			&& (unsigned long) count
+					<= (unsigned long) (end - position) / sizeof(int);
+}
+
+static bool ReadInts(FILE *file, vector<int> &v, int count) {
+	if (!FitsInFile(file, count)) {
+		return false;
+	}
+
+	v.resize(count);
+	return count == 0
+			|| fread(&v[0], sizeof(int), count, file) == (size_t) count;
+}
+
+bool SubgoalGraph::Save(const char *fileName) const {
+	FILE *file = fopen(fileName, "wb");
+
+	if (!file) {
+		return false;
+	}
+
+	int header[6] = { SSG_FILE_VERSION, m_Width, m_Height, m_Terrain,
+			(int) m_Cells.size(), (int) m_Targets.size() };
+
+	bool ok = fwrite("SSG1", 1, 4, file) == 4
+			&& fwrite(header, sizeof(int), 6, file) == 6
+			&& WriteInts(file, m_Cells)
+			&& WriteInts(file, m_Offsets)
+			&& WriteInts(file, m_Targets);
+
+	return (fclose(file) == 0) && ok;
+}
+
+bool SubgoalGraph::Load(const char *fileName,
+		const MapSearchNode::Rules &rules) {
+	if (!IsSupported(rules)) {
+		return false;
+	}
+
+	FILE *file = fopen(fileName, "rb");
+
+	if (!file) {
+		return false;
+	}
+
+	char magic[4];
+	int header[6];
+
+	// The graph only fits the map it was built for
+	bool ok = fread(magic, 1, 4, file) == 4 && memcmp(magic, "SSG1", 4) == 0
+			&& fread(header, sizeof(int), 6, file) == 6
+			&& header[0] == SSG_FILE_VERSION && header[1] == Map::GetWidth()
+			&& header[2] == Map::GetHeight() && header[3] > 0
+			&& header[3] < 9 && header[4] >= 0
+			&& header[4] <= header[1] * header[2] && header[5] >= 0;
+
+	ok = ok && ReadInts(file, m_Cells, header[4])
+			&& ReadInts(file, m_Offsets, header[4] + 1)
+			&& ReadInts(file, m_Targets, header[5]);
+
+	fclose(file);
+
+	if (ok) {
+		m_Width = header[1];
+		m_Height = header[2];
+		m_Terrain = header[3];
+		m_Rules = rules;
+		m_Rules.overlay = NULL;
+		ok = CheckGraph();
+	}
+
+	if (!ok) {
+		Clear();
+		return false;
+	}
+
+	return true;
+}
+
+float SubgoalGraph::Query(MapSearchNode &start, MapSearchNode &goal,
+		vector<MapSearchNode> *path) {
+	m_Expanded = 0;
+
+	if (path) {
+		path->clear();
+	}
+
+	if (m_CellSubgoal.empty() || !IsOpen(start.x, start.y)
+			|| !IsOpen(goal.x, goal.y)) {
+		return FLT_MAX;
+	}
+
+	int startCell = start.y * m_Width + start.x;
+	int goalCell = goal.y * m_Width + goal.x;
+	int subgoals = m_Cells.size();
+
+	if (startCell == goalCell) {
+		if (path) {
+			path->push_back(start);
+		}
+		return 0.0f;
+	}
+
+	// The start and goal stand in as subgoals while they are joined to the
+	// graph, each seeing the other too
+	int startNode = m_CellSubgoal[startCell];
+	int goalNode = m_CellSubgoal[goalCell];
+	if (startNode < 0) {
+		m_CellSubgoal[startCell] = startNode = subgoals;
+	}
+	if (goalNode < 0) {
+		m_CellSubgoal[goalCell] = goalNode = subgoals + 1;
+	}
+
+	if (m_Labels.size() < (unsigned int) subgoals + 2) {
+		Label unused = { FLT_MAX, -1, 0 };
+		m_Labels.assign(subgoals + 2, unused);
+		m_GoalLink.assign(subgoals + 2, 0);
+		m_CurrentStamp = 0;
+	}
+	m_CurrentStamp++;
+
+	vector<int> reachable;
+	m_StartTargets.clear();
+	if (startNode == subgoals) {
+		GetDirectHReachable(startCell, reachable);
+		for (unsigned int i = 0; i < reachable.size(); i++) {
+			m_StartTargets.push_back(m_CellSubgoal[reachable[i]]);
+		}
+	}
+	if (goalNode == subgoals + 1) {
+		GetDirectHReachable(goalCell, reachable);
+		for (unsigned int i = 0; i < reachable.size(); i++) {
+			m_GoalLink[m_CellSubgoal[reachable[i]]] = m_CurrentStamp;
+		}
+	}
+
+	if (startNode == subgoals) {
+		m_CellSubgoal[startCell] = -1;
+	}
+	if (goalNode == subgoals + 1) {
+		m_CellSubgoal[goalCell] = -1;
+	}
+
+	// A* over the graph with the octile distance, which is exact along each
+	// edge and so consistent
+	m_Open.clear();
+	Label &first = m_Labels[startNode];
+	first.dist = 0.0f;
+	first.parent = -1;
+	first.stamp = m_CurrentStamp;
+	m_Open.push_back(QueueEntry(GetDistance(startCell, goalCell), startNode));
+
+	float cost = FLT_MAX;
+
+	while (!m_Open.empty()) {
+		QueueEntry e = m_Open.front();
+		pop_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+		m_Open.pop_back();
+
+		int u = e.second;
+		int uCell = u == startNode ? startCell :
+				(u == goalNode ? goalCell : m_Cells[u]);
+		if (e.first > m_Labels[u].dist + GetDistance(uCell, goalCell)) {
+			continue;
+		}
+
+		m_Expanded++;
+		if (u == goalNode) {
+			cost = m_Labels[u].dist;
+			break;
+		}
+
+		const int *targets;
+		int count;
+		if (u == subgoals) {
+			targets = m_StartTargets.empty() ? NULL : &m_StartTargets[0];
+			count = m_StartTargets.size();
+		} else {
+			targets = m_Targets.empty() ? NULL : &m_Targets[0] + m_Offsets[u];
+			count = m_Offsets[u + 1] - m_Offsets[u];
+		}
+
+		// The goal link comes last, after the graph edges
+		for (int i = 0; i <= count; i++) {
+			int v;
+			if (i < count) {
+				v = targets[i];
+			} else if (goalNode == subgoals + 1
+					&& m_GoalLink[u] == m_CurrentStamp) {
+				v = subgoals + 1;
+			} else {
+				break;
+			}
+
+			int vCell = v == goalNode ? goalCell : m_Cells[v];
+			float dist = m_Labels[u].dist + GetDistance(uCell, vCell);
+			Label &label = m_Labels[v];
+
+			if (label.stamp != m_CurrentStamp || dist < label.dist) {
+				label.dist = dist;
+				label.parent = u;
+				label.stamp = m_CurrentStamp;
+				m_Open.push_back(
+						QueueEntry(dist + GetDistance(vCell, goalCell), v));
+				push_heap(m_Open.begin(), m_Open.end(), greater<QueueEntry>());
+			}
+		}
+	}
+
+	if (cost == FLT_MAX || !path) {
+		return cost;
+	}
+
+	vector<int> nodes;
+	for (int v = goalNode; v >= 0; v = m_Labels[v].parent) {
+		nodes.push_back(v);
+	}
+	reverse(nodes.begin(), nodes.end());
+
+	path->push_back(start);
+	for (unsigned int i = 0; i + 1 < nodes.size(); i++) {
+		int from = nodes[i] == startNode ? startCell : m_Cells[nodes[i]];
+		int to = nodes[i + 1] == goalNode ? goalCell : m_Cells[nodes[i + 1]];
+		Refine(from, to, *path);
+	}
+
+	return cost;
+}
+
+int SubgoalGraph::GetSubgoalCount() const {
+	return m_Cells.size();
+}
+
+int SubgoalGraph::GetEdgeCount() const {
+	return m_Targets.size();
+}
+
+int SubgoalGraph::GetExpandedCount() const {
+	return m_Expanded;
+}
+
+bool SubgoalGraph::IsSupported(const MapSearchNode::Rules &rules) {
+	return rules.connectivity == MapSearchNode::CONNECT_8
+			&& rules.cornerRule == MapSearchNode::CORNER_CUT_FORBIDDEN;
+}
+
+bool SubgoalGraph::IsOpen(int x, int y) const {
+	return x >= 0 && x < Map::GetWidth() && y >= 0 && y < Map::GetHeight()
+			&& Map::GetClearance(x, y) >= m_Rules.agentSize;
+}
+
+// Diagonal moves need both cells they pass between open
+bool SubgoalGraph::CanMove(int x, int y, int dx, int dy) const {
+	return IsOpen(x + dx, y + dy)
+			&& (dx == 0 || dy == 0 || (IsOpen(x + dx, y) && IsOpen(x, y + dy)));
+}
+
+bool SubgoalGraph::IsSubgoal(int x, int y) const {
+	return m_CellSubgoal[y * m_Width + x] >= 0;
+}
+
+// Number of moves from (x, y) in direction (dx, dy) before the next one is
+// blocked or lands on a subgoal, looking no further than limit moves. hit is
+// set when it stopped at a subgoal
+int SubgoalGraph::Clearance(int x, int y, int dx, int dy, int limit,
+		int &hit) const {
+	hit = 0;
+	for (int k = 0; k < limit; k++) {
+		if (!CanMove(x, y, dx, dy)) {
+			return k;
+		}
+		x += dx;
+		y += dy;
+		if (IsSubgoal(x, y)) {
+			hit = 1;
+			return k;
+		}
+	}
+	return limit;
+}
+
+// Subgoals directly h-reachable from the cell. Straight lines find the first
+// subgoal in each direction. Each diagonal then sweeps its quadrant with
+// straight lines from every cell along it, each allowed no further than the
+// one before so the swept area has an octile path to every cell in it
+void SubgoalGraph::GetDirectHReachable(int cell, vector<int> &cells) const {
+	const int unlimited = m_Width + m_Height;
+	int x = cell % m_Width;
+	int y = cell / m_Width;
+	int hit;
+
+	cells.clear();
+
+	for (int dy = -1; dy <= 1; dy++) {
+		for (int dx = -1; dx <= 1; dx++) {
+			if ((dx == 0) == (dy == 0)) {
+				continue;
+			}
+			int k = Clearance(x, y, dx, dy, unlimited, hit);
+			if (hit) {
+				cells.push_back((y + (k + 1) * dy) * m_Width + x + (k + 1) * dx);
+			}
+		}
+	}
+
+	for (int dy = -1; dy <= 1; dy += 2) {
+		for (int dx = -1; dx <= 1; dx += 2) {
+			int maxX = Clearance(x, y, dx, 0, unlimited, hit);
+			int maxY = Clearance(x, y, 0, dy, unlimited, hit);
+
+			int diagonal = Clearance(x, y, dx, dy, unlimited, hit);
+			if (hit) {
+				cells.push_back(
+						(y + (diagonal + 1) * dy) * m_Width + x
+								+ (diagonal + 1) * dx);
+			}
+
+			for (int i = 1; i <= diagonal; i++) {
+				int px = x + i * dx;
+				int py = y + i * dy;
+
+				int j = Clearance(px, py, dx, 0, maxX + 1, hit);
+				if (j <= maxX && hit) {
+					cells.push_back(py * m_Width + px + (j + 1) * dx);
+					j--;
+				}
+				maxX = min(maxX, j);
+
+				j = Clearance(px, py, 0, dy, maxY + 1, hit);
+				if (j <= maxY && hit) {
+					cells.push_back((py + (j + 1) * dy) * m_Width + px);
+					j--;
+				}
+				maxY = min(maxY, j);
+			}
+		}
+	}
+}
+
+float SubgoalGraph::GetDistance(int from, int to) const {
+	int dx = abs(from % m_Width - to % m_Width);
+	int dy = abs(from / m_Width - to / m_Width);
+	return (abs(dx - dy) + SQRT2 * min(dx, dy)) * m_Terrain;
+}
+
+// Appends the cells after from up to to. The edge was found either from from,
+// diagonal moves first, or from to, in which case going straight first is
+// free
+void SubgoalGraph::Refine(int from, int to, vector<MapSearchNode> &path) const {
+	int x = from % m_Width;
+	int y = from / m_Width;
+	int tx = to % m_Width;
+	int ty = to / m_Width;
+	int dx = tx > x ? 1 : (tx < x ? -1 : 0);
+	int dy = ty > y ? 1 : (ty < y ? -1 : 0);
+	int diagonal = min(abs(tx - x), abs(ty - y));
+	int straight = max(abs(tx - x), abs(ty - y)) - diagonal;
+	int sx = abs(tx - x) > abs(ty - y) ? dx : 0;
+	int sy = sx ? 0 : dy;
+
+	bool diagonalFirst = true;
+	int cx = x, cy = y;
+	for (int i = 0; diagonalFirst && i < diagonal + straight; i++) {
+		int mx = i < diagonal ? dx : sx;
+		int my = i < diagonal ? dy : sy;
+		diagonalFirst = CanMove(cx, cy, mx, my);
+		cx += mx;
+		cy += my;
+	}
+
+	for (int i = 0; i < diagonal + straight; i++) {
+		bool isDiagonal = diagonalFirst ? i < diagonal : i >= straight;
+		x += isDiagonal ? dx : sx;
+		y += isDiagonal ? dy : sy;
+		path.push_back(MapSearchNode(x, y));
+	}
+}
+
+bool SubgoalGraph::CheckGraph() {
+	int subgoals = m_Cells.size();
+
+	// Every subgoal on the map and numbered once
+	m_CellSubgoal.assign(m_Width * m_Height, -1);
+	for (int s = 0; s < subgoals; s++) {
+		int cell = m_Cells[s];
+		if (cell < 0 || cell >= m_Width * m_Height
+				|| m_CellSubgoal[cell] >= 0) {
+			return false;
+		}
+		m_CellSubgoal[cell] = s;
+	}
+
+	// Offsets from 0 to the edge count, never decreasing, and every edge to
+	// another subgoal
+	if (m_Offsets.front() != 0 || m_Offsets.back() != (int) m_Targets.size()) {
+		return false;
+	}
+	for (int s = 0; s < subgoals; s++) {
+		if (m_Offsets[s + 1] < m_Offsets[s]) {
+			return false;
+		}
+	}
+	for (unsigned int i = 0; i < m_Targets.size(); i++) {
+		if (m_Targets[i] < 0 || m_Targets[i] >= subgoals) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void SubgoalGraph::Clear() {
+	m_Width = m_Height = m_Terrain = 0;
+	m_Cells.clear();
+	m_CellSubgoal.clear();
+	m_Offsets.clear();
+	m_Targets.clear();
+	m_Labels.clear();
+	m_GoalLink.clear();
+}
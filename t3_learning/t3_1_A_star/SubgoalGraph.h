@@ -0,0 +1,111 @@
+/*
+ * SubgoalGraph.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef SUBGOALGRAPH_H_
+#define SUBGOALGRAPH_H_
+
+#include <vector>
+#include <utility>
+#include <cfloat>
+
+#include "MapSearchNode.h"
+
+// Simple subgoal graph over the world map. A subgoal is an open cell at the
+// convex corner of an obstacle, and two subgoals are joined when one is
+// directly h-reachable from the other: a move-by-move octile path links them
+// with no other subgoal on the way. A query joins the start and goal to the
+// subgoals they can directly h-reach, searches the graph, and refines each
+// edge back into cells.
+//
+// The graph is exact for 8-connected movement without corner cutting over
+// uniform terrain, the usual setting for subgoal graphs. Build() refuses any
+// other movement rule, or a map whose open cells cost different amounts.
+// The agent size of the rules it is built for is honoured.
+
+class SubgoalGraph {
+public:
+	// Distance and node, kept in a min heap by the query
+	typedef std::pair<float, int> QueueEntry;
+
+	SubgoalGraph();
+	virtual ~SubgoalGraph();
+
+	// Builds the graph for the current world map under the given rules, the
+	// defaults as they are now unless given. Returns false, leaving the
+	// graph empty, if the map or the movement rules are not supported
+	bool Build(const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Graph file format, all values in host byte order:
+	//   char[4] "SSG1", int version, int width, int height, int terrain,
+	//   int subgoals, int edges,
+	//   int cells[subgoals], int offsets[subgoals + 1], int targets[edges]
+	// Load() refuses a file for a map of another size than the world map,
+	// or one whose cells, offsets or targets do not make a graph. The graph
+	// is taken to be built for the rules given, as Build() would have them
+	bool Save(const char *fileName) const;
+	bool Load(const char *fileName,
+			const MapSearchNode::Rules &rules = MapSearchNode::Rules());
+
+	// Returns the cost of the cheapest path from start to goal, or FLT_MAX if
+	// there is none. If path is not NULL it receives every cell of the path,
+	// start and goal included
+	float Query(MapSearchNode &start, MapSearchNode &goal,
+			std::vector<MapSearchNode> *path);
+
+	int GetSubgoalCount() const;
+	int GetEdgeCount() const;
+
+	// Graph nodes expanded by the last query
+	int GetExpandedCount() const;
+
+private:
+	// Search state of one node of a query, valid only while stamp matches
+	// the current query
+	struct Label {
+		float dist;
+		int parent;
+		unsigned int stamp;
+	};
+
+	static bool IsSupported(const MapSearchNode::Rules &rules);
+	bool IsOpen(int x, int y) const;
+	bool CanMove(int x, int y, int dx, int dy) const;
+	bool IsSubgoal(int x, int y) const;
+	int Clearance(int x, int y, int dx, int dy, int limit, int &hit) const;
+	void GetDirectHReachable(int cell, std::vector<int> &cells) const;
+	float GetDistance(int from, int to) const;
+	void Refine(int from, int to, std::vector<MapSearchNode> &path) const;
+	bool CheckGraph();
+	void Clear();
+
+private:
+	int m_Width;
+	int m_Height;
+	int m_Terrain;
+	MapSearchNode::Rules m_Rules;
+
+	// Subgoal ids <-> cell index (y * width + x), -1 for cells that are not
+	// subgoals
+	std::vector<int> m_Cells;
+	std::vector<int> m_CellSubgoal;
+
+	// Edges in CSR form, both directions listed
+	std::vector<int> m_Offsets;
+	std::vector<int> m_Targets;
+
+	// Per query scratch space. The start and goal are nodes subgoals and
+	// subgoals + 1 unless they are subgoals themselves
+	std::vector<Label> m_Labels;
+	std::vector<QueueEntry> m_Open;
+	std::vector<int> m_StartTargets;
+	std::vector<int> m_GoalTargets;
+	std::vector<unsigned int> m_GoalLink;
+	unsigned int m_CurrentStamp;
+	int m_Expanded;
+};
+
+#endif /* SUBGOALGRAPH_H_ */
@@ -0,0 +1,164 @@
+/*
+ * ch_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Builds a ContractionHierarchy for a random map of walls over mixed
+// terrain, saves it and loads it back, then runs random queries through it
+// and through CompactAStarSearch, checking the costs agree and that every
+// unpacked path is a legal walk of that cost. Queries are timed without
+// unpacking the path, then again with it.
+//
+// Usage: ch_bench <map size> <queries> [<wall percent>] [<hierarchy file>]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../ContractionHierarchy.h"
+#include "../Map.h"
+#include "../MapSearchNode.h"
+
+using namespace std;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+// Sum of the move costs along the path, FLT_MAX if a move is not allowed
+static float PathCost(vector<MapSearchNode> &path) {
+	vector<int> x, y;
+	float cost = 0.0f;
+
+	for (unsigned int i = 0; i + 1 < path.size(); i++) {
+		path[i].GetSuccessors(NULL, x, y);
+
+		bool legal = false;
+		for (unsigned int j = 0; j < x.size(); j++) {
+			legal = legal || (x[j] == path[i + 1].x && y[j] == path[i + 1].y);
+		}
+		if (!legal) {
+			return FLT_MAX;
+		}
+		cost += path[i].GetCost(path[i + 1]);
+	}
+	return cost;
+}
+
+static bool Same(float a, float b) {
+	return a == b || (a != FLT_MAX && b != FLT_MAX && fabs(a - b) <= 1e-4f * a);
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <queries> [<wall percent>] "
+				"[<hierarchy file>]\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int queries = atoi(argv[2]);
+	int walls = argc > 3 ? atoi(argv[3]) : 20;
+	const char *fileName = argc > 4 ? argv[4] : "ch_bench.chg";
+
+	MapSearchNode::SetMovement(MapSearchNode::CONNECT_8,
+			MapSearchNode::CORNER_CUT_FORBIDDEN);
+
+	srand(1);
+	vector<int> data(size * size);
+	for (unsigned int i = 0; i < data.size(); i++) {
+		data[i] = (rand() % 100 < walls) ? 9 : 1 + rand() % 4;
+	}
+	Map::SetWorldMap(size, size, data);
+
+	ContractionHierarchy built;
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	built.Build();
+	printf("Built in %.3fs: %d nodes, %d shortcuts\n", Seconds(t0),
+			built.GetNodeCount(), built.GetShortcutCount());
+
+	if (!built.Save(fileName)) {
+		printf("Cannot save %s\n", fileName);
+		return 1;
+	}
+
+	ContractionHierarchy ch;
+	t0 = chrono::steady_clock::now();
+	if (!ch.Load(fileName)) {
+		printf("Cannot load %s\n", fileName);
+		return 1;
+	}
+	printf("Loaded in %.4fs\n", Seconds(t0));
+
+	vector<MapSearchNode> starts, goals;
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(rand() % size, rand() % size);
+		if (Map::GetMap(start.x, start.y) < 9
+				&& Map::GetMap(goal.x, goal.y) < 9) {
+			starts.push_back(start);
+			goals.push_back(goal);
+		}
+	}
+
+	CompactAStarSearch search;
+	vector<float> costs(queries);
+	long expansions = 0;
+
+	t0 = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		search.SetStartAndGoalStates(starts[i], goals[i]);
+		unsigned int state;
+		do {
+			state = search.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+		costs[i] = search.GetSolutionCost();
+		expansions += search.GetStepCount();
+	}
+	double searchTime = Seconds(t0);
+
+	int mismatches = 0;
+	long settled = 0;
+
+	t0 = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		float cost = ch.Query(starts[i], goals[i], NULL);
+		settled += ch.GetSettledCount();
+		if (!Same(cost, costs[i])) {
+			mismatches++;
+		}
+	}
+	double chTime = Seconds(t0);
+
+	vector<MapSearchNode> path;
+	t0 = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		ch.Query(starts[i], goals[i], &path);
+		if (costs[i] != FLT_MAX && !Same(PathCost(path), costs[i])) {
+			mismatches++;
+		}
+	}
+	double pathTime = Seconds(t0);
+
+	printf("A*          %10.4fs %8.1f us/query expansions %ld\n", searchTime,
+			searchTime * 1e6 / queries, expansions);
+	printf("CH          %10.4fs %8.1f us/query settled %ld speedup %.0f\n",
+			chTime, chTime * 1e6 / queries, settled, searchTime / chTime);
+	printf("CH and path %10.4fs %8.1f us/query (path checks included)\n",
+			pathTime, pathTime * 1e6 / queries);
+
+	if (mismatches) {
+		printf("%d queries did not match\n", mismatches);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * edge_cost_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Runs the same random queries with CompactAStarSearch working moves and
+// costs out from the map, and reading them from an EdgeCostTable, on an
+// 8-connected map of walls over terrain costs 1 to 4. The costs and
+// expansions must be the same. Then adds transition penalties, a cost for
+// every change of terrain and more for climbing onto cost 4 ground, and
+// checks the costs against a Dijkstra search that adds them itself. Last,
+// checks that searches moving by other rules than the table was built for
+// pass it over.
+//
+// Usage: edge_cost_bench <map size> <queries>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../EdgeCostTable.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+
+using namespace std;
+
+const float CHANGE_PENALTY = 0.5f;
+const float CLIMB_PENALTY = 2.0f;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+static float Penalty(int from, int to) {
+	return (from != to ? CHANGE_PENALTY : 0.0f)
+			+ (to == 4 && from < 4 ? CLIMB_PENALTY : 0.0f);
+}
+
+// Dijkstra over the map's own moves and costs plus the penalties, to be run
+// with no table installed
+static float Dijkstra(const MapSearchNode &start, const MapSearchNode &goal) {
+	typedef pair<float, int> QueueEntry;
+
+	int width = Map::GetWidth();
+	vector<float> distance(width * Map::GetHeight(), FLT_MAX);
+	vector<QueueEntry> open;
+	vector<int> x, y;
+
+	distance[start.y * width + start.x] = 0.0f;
+	open.push_back(QueueEntry(0.0f, start.y * width + start.x));
+
+	while (!open.empty()) {
+		QueueEntry e = open.front();
+		pop_heap(open.begin(), open.end(), greater<QueueEntry>());
+		open.pop_back();
+
+		if (e.first > distance[e.second]) {
+			continue;
+		}
+		if (e.second == goal.y * width + goal.x) {
+			return e.first;
+		}
+
+		MapSearchNode state(e.second % width, e.second / width);
+		state.GetSuccessors(NULL, x, y);
+		for (unsigned int i = 0; i < x.size(); i++) {
+			MapSearchNode successor(x[i], y[i]);
+			int next = y[i] * width + x[i];
+			float d = e.first + state.GetCost(successor)
+					+ Penalty(Map::GetMap(state.x, state.y),
+							Map::GetMap(x[i], y[i]));
+
+			if (d < distance[next]) {
+				distance[next] = d;
+				open.push_back(QueueEntry(d, next));
+				push_heap(open.begin(), open.end(), greater<QueueEntry>());
+			}
+		}
+	}
+	return FLT_MAX;
+}
+
+static float Search(CompactAStarSearch &search, MapSearchNode &start,
+		MapSearchNode &goal, const MapSearchNode::Rules &rules) {
+	search.SetStartAndGoalStates(start, goal, rules);
+	unsigned int state;
+	do {
+		state = search.SearchStep();
+	} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+	return search.GetSolutionCost();
+}
+
+// A 10x10 open map cut by a wall at x = 5 with a gap of one cell, and a
+// table built for agents of size 1 moving 8-connected. An agent of size 2
+// does not fit through the gap, and a 4-connected agent has no diagonals,
+// with the table or without. Returns the searches that differ
+static int CheckOtherMovement() {
+	const int size = 10;
+	vector<int> data(size * size, 1);
+	for (int y = 0; y < size; y++) {
+		data[y * size + 5] = (y == 4) ? 1 : 9;
+	}
+	Map::SetWorldMap(size, size, data);
+
+	MapSearchNode::Rules built;
+	built.connectivity = MapSearchNode::CONNECT_8;
+	built.agentSize = 1;
+	built.edgeCosts = NULL;
+	built.overlay = NULL;
+
+	EdgeCostTable table;
+	table.Build(built);
+
+	MapSearchNode::Rules other[2] = { built, built };
+	other[0].agentSize = 2;
+	other[1].connectivity = MapSearchNode::CONNECT_4;
+
+	CompactAStarSearch search;
+	MapSearchNode start(1, 1);
+	MapSearchNode goal(8, 1);
+	int differ = 0;
+
+	for (int i = 0; i < 2; i++) {
+		float reference = Search(search, start, goal, other[i]);
+		other[i].edgeCosts = &table;
+		float cost = Search(search, start, goal, other[i]);
+		if (cost != reference) {
+			printf("%s: %g with the table, %g without\n",
+					i ? "4-connected" : "Size 2", cost, reference);
+			differ++;
+		}
+	}
+	return differ;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <queries>\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int queries = atoi(argv[2]);
+
+	MapSearchNode::SetMovement(MapSearchNode::CONNECT_8,
+			MapSearchNode::CORNER_CUT_FORBIDDEN);
+
+	srand(1);
+	vector<int> data;
+	MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+	Map::SetWorldMap(size, size, data);
+
+	vector<MapSearchNode> starts, goals;
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(rand() % size, rand() % size);
+		if (Map::GetMap(start.x, start.y) < 9
+				&& Map::GetMap(goal.x, goal.y) < 9) {
+			starts.push_back(start);
+			goals.push_back(goal);
+		}
+	}
+
+	EdgeCostTable table;
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	table.Build();
+	printf("Table built in %.3fs, %ld bytes\n", Seconds(t0),
+			table.GetTableSize());
+
+	CompactAStarSearch search;
+	vector<float> costs(queries);
+	vector<int> steps(queries);
+	int mismatches = 0;
+
+	for (int pass = 0; pass < 2; pass++) {
+		MapSearchNode::SetEdgeCosts(pass ? &table : NULL);
+		long expansions = 0;
+
+		t0 = chrono::steady_clock::now();
+		for (int i = 0; i < queries; i++) {
+			search.SetStartAndGoalStates(starts[i], goals[i]);
+			unsigned int state;
+			do {
+				state = search.SearchStep();
+			} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+			expansions += search.GetStepCount();
+			if (pass == 0) {
+				costs[i] = search.GetSolutionCost();
+				steps[i] = search.GetStepCount();
+			} else if (search.GetSolutionCost() != costs[i]
+					|| search.GetStepCount() != steps[i]) {
+				mismatches++;
+			}
+		}
+		printf("%-12s %.4fs, %ld expansions\n", pass ? "Table:" : "From map:",
+				Seconds(t0), expansions);
+	}
+
+	// Penalties, checked against the reference without the table
+	for (int from = 0; from < EdgeCostTable::TERRAIN_TYPES; from++) {
+		for (int to = 0; to < EdgeCostTable::TERRAIN_TYPES; to++) {
+			table.SetTransitionPenalty(from, to, Penalty(from, to));
+		}
+	}
+	table.Build();
+
+	int penaltyMismatches = 0;
+	double penaltyTime = 0.0;
+	for (int i = 0; i < queries; i++) {
+		MapSearchNode::SetEdgeCosts(&table);
+		t0 = chrono::steady_clock::now();
+		search.SetStartAndGoalStates(starts[i], goals[i]);
+		unsigned int state;
+		do {
+			state = search.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+		penaltyTime += Seconds(t0);
+		float cost = search.GetSolutionCost();
+
+		MapSearchNode::SetEdgeCosts(NULL);
+		float reference = Dijkstra(starts[i], goals[i]);
+		if (cost != reference
+				&& !(cost != FLT_MAX && reference != FLT_MAX
+						&& fabs(cost - reference) <= 1e-4f * reference)) {
+			penaltyMismatches++;
+		}
+	}
+	printf("%-12s %.4fs\n", "Penalties:", penaltyTime);
+
+	if (CheckOtherMovement()) {
+		return 1;
+	}
+
+	if (mismatches || penaltyMismatches) {
+		printf("%d searches differ with the table, %d penalty costs differ\n",
+				mismatches, penaltyMismatches);
+		return 1;
+	}
+	return 0;
+}
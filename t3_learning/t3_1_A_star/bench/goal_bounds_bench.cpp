@@ -0,0 +1,154 @@
+/*
+ * goal_bounds_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Builds goal bounding tables for a random map, saves them and maps them
+// back in, then runs the same random queries with CompactAStarSearch with and
+// without the bounds, checking the costs agree. The bounds are first asked
+// to load the file for another agent size, which must fail and leave the
+// table mapped in use.
+//
+// Usage: goal_bounds_bench <map size> <queries> [<threads>] [-8]
+//        [<table file>]
+// Building runs a Dijkstra search from every cell, so keep the map small.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../GoalBounds.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+
+using namespace std;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+static float Run(CompactAStarSearch &search, MapSearchNode start,
+		MapSearchNode goal, long &expansions) {
+	search.SetStartAndGoalStates(start, goal);
+	unsigned int state;
+	do {
+		state = search.SearchStep();
+	} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+	expansions += search.GetStepCount();
+	return search.GetSolutionCost();
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <queries> [<threads>] [-8] "
+				"[<table file>]\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int queries = atoi(argv[2]);
+	int threads = argc > 3 ? atoi(argv[3]) : 1;
+	const char *fileName = "goal_bounds_bench.gbt";
+
+	for (int i = 4; i < argc; i++) {
+		if (strcmp(argv[i], "-8") == 0) {
+			MapSearchNode::SetMovement(MapSearchNode::CONNECT_8,
+					MapSearchNode::CORNER_CUT_FORBIDDEN);
+		} else {
+			fileName = argv[i];
+		}
+	}
+
+	// 20% walls over terrain costs 1 to 4
+	srand(1);
+	vector<int> data;
+	MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+	Map::SetWorldMap(size, size, data);
+
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	{
+		GoalBounds built;
+		built.Build(threads);
+		printf("Built in %.3fs with %d threads, %ld bytes\n", Seconds(t0),
+				threads, built.GetTableSize());
+
+		if (!built.Save(fileName)) {
+			printf("Cannot save %s\n", fileName);
+			return 1;
+		}
+	}
+
+	GoalBounds bounds;
+	t0 = chrono::steady_clock::now();
+	if (!bounds.Load(fileName)) {
+		printf("Cannot load %s\n", fileName);
+		return 1;
+	}
+	printf("Mapped in %.4fs\n", Seconds(t0));
+
+	MapSearchNode::Rules other;
+	other.agentSize++;
+	if (bounds.Load(fileName, other)) {
+		printf("%s loaded for another agent size\n", fileName);
+		return 1;
+	}
+
+	vector<MapSearchNode> starts, goals;
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(rand() % size, rand() % size);
+		if (Map::GetMap(start.x, start.y) < 9
+				&& Map::GetMap(goal.x, goal.y) < 9) {
+			starts.push_back(start);
+			goals.push_back(goal);
+		}
+	}
+
+	CompactAStarSearch plain;
+	CompactAStarSearch bounded;
+	bounded.SetGoalBounds(&bounds);
+
+	long plainExpansions = 0, boundedExpansions = 0;
+	vector<float> costs(queries);
+
+	t0 = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		costs[i] = Run(plain, starts[i], goals[i], plainExpansions);
+	}
+	double plainTime = Seconds(t0);
+
+	int mismatches = 0;
+	t0 = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		float cost = Run(bounded, starts[i], goals[i], boundedExpansions);
+		if (cost != costs[i]
+				&& !(cost != FLT_MAX && costs[i] != FLT_MAX
+						&& fabs(cost - costs[i]) <= 1e-4f * costs[i])) {
+			mismatches++;
+		}
+	}
+	double boundedTime = Seconds(t0);
+
+	printf("unbounded %10.4fs expansions %ld\n", plainTime, plainExpansions);
+	printf("bounded   %10.4fs expansions %ld (%.1f%% fewer) speedup %.2f\n",
+			boundedTime, boundedExpansions,
+			100.0 * (plainExpansions - boundedExpansions) / plainExpansions,
+			plainTime / boundedTime);
+
+	if (mismatches) {
+		printf("%d queries found a different cost\n", mismatches);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * hda_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Times one corner to corner query on a random map with AStarSearch and with
+// ParallelAStarSearch at each requested thread count.
+//
+// Usage: hda_bench <map size> <threads>... [-noserial]
+// AStarSearch keeps its open and closed lists in plain vectors, so leave it
+// out with -noserial on big maps; the speedup is then relative to the first
+// thread count given.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+#include "../ParallelAStarSearch.h"
+
+using namespace std;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <threads>... [-noserial]\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	bool serial = true;
+	vector<int> threadCounts;
+
+	for (int i = 2; i < argc; i++) {
+		if (strcmp(argv[i], "-noserial") == 0) {
+			serial = false;
+		} else {
+			threadCounts.push_back(atoi(argv[i]));
+		}
+	}
+
+	// 20% walls over terrain costs 1 to 4, with the corners kept open
+	srand(1);
+	vector<int> data;
+	MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+	data[0] = 1;
+	data[size * size - 1] = 1;
+	Map::SetWorldMap(size, size, data);
+
+	MapSearchNode start(0, 0);
+	MapSearchNode goal(size - 1, size - 1);
+
+	double baseline = 0.0;
+
+	if (serial) {
+		AStarSearch astarsearch;
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+		astarsearch.SetStartAndGoalStates(start, goal);
+		unsigned int state;
+		do {
+			state = astarsearch.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+		baseline = Seconds(t0);
+		printf("AStarSearch      %10.4fs cost %8.1f expansions %d\n", baseline,
+				astarsearch.GetSolutionCost(), astarsearch.GetStepCount());
+
+		if (state == AStarSearch::SEARCH_STATE_SUCCEEDED) {
+			astarsearch.FreeSolutionNodes();
+		}
+	}
+
+	for (unsigned int i = 0; i < threadCounts.size(); i++) {
+		ParallelAStarSearch search(threadCounts[i]);
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+		search.Search(start, goal);
+
+		double elapsed = Seconds(t0);
+		if (baseline == 0.0) {
+			baseline = elapsed;
+		}
+
+		printf("HDA* %3d threads %10.4fs cost %8.1f expansions %d "
+				"speedup %.2f\n", threadCounts[i], elapsed, search.GetSolutionCost(),
+				search.GetStepCount(), baseline / elapsed);
+	}
+
+	return 0;
+}
@@ -0,0 +1,281 @@
+/*
+ * heuristic_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Throughput on one core of the heuristics one cell at a time against the
+// batches of BatchHeuristic and LandmarkTable, checking they give the same
+// floats. Then random queries with CompactAStarSearch on an 8-connected map
+// of walls over terrain costs 1 to 4, with and without the landmark bound,
+// checking the costs agree. Last, the same on a map of rooms, where some
+// rooms are shut, checking the landmarks save expansions there too.
+//
+// Build with -mavx2 for the eight wide batches, SSE2 is used otherwise.
+//
+// Usage: heuristic_bench <map size> <queries> [<landmarks>]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../BatchHeuristic.h"
+#include "../CompactAStarSearch.h"
+#include "../LandmarkTable.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+
+using namespace std;
+
+const int CELLS = 1 << 16;
+const int ROUNDS = 200;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+static void Report(const char *name, double seconds, long estimates) {
+	printf("  %-26s %8.1f M/s\n", name, estimates / seconds * 1e-6);
+}
+
+// Estimates per second of GoalDistanceEstimate and the batches over the
+// same cells, for one goal and for a goal per cell
+static int BenchDistances(int size, int connectivity) {
+	MapSearchNode::SetMovement(connectivity,
+			MapSearchNode::CORNER_CUT_FORBIDDEN);
+
+	vector<int> x(CELLS), y(CELLS), goalX(CELLS), goalY(CELLS);
+	for (int i = 0; i < CELLS; i++) {
+		x[i] = rand() % size;
+		y[i] = rand() % size;
+		goalX[i] = rand() % size;
+		goalY[i] = rand() % size;
+	}
+	MapSearchNode goal(goalX[0], goalY[0]);
+
+	vector<float> scalar(CELLS), scalarPerCell(CELLS), batch(CELLS);
+	long estimates = (long) CELLS * ROUNDS;
+
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i < CELLS; i++) {
+			MapSearchNode state(x[i], y[i]);
+			scalar[i] = state.GoalDistanceEstimate(goal);
+		}
+	}
+	Report("one at a time", Seconds(t0), estimates);
+
+	t0 = chrono::steady_clock::now();
+	for (int r = 0; r < ROUNDS; r++) {
+		BatchHeuristic::Estimate(&x[0], &y[0], CELLS, goal.x, goal.y,
+				&batch[0]);
+	}
+	Report("batch", Seconds(t0), estimates);
+	int mismatches = !equal(scalar.begin(), scalar.end(), batch.begin());
+
+	// Successors come eight at a time in a search
+	t0 = chrono::steady_clock::now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i + 8 <= CELLS; i += 8) {
+			BatchHeuristic::Estimate(&x[i], &y[i], 8, goal.x, goal.y,
+					&batch[i]);
+		}
+	}
+	Report("batches of 8", Seconds(t0), estimates);
+	mismatches += !equal(scalar.begin(), scalar.end(), batch.begin());
+
+	t0 = chrono::steady_clock::now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i < CELLS; i++) {
+			MapSearchNode state(x[i], y[i]);
+			MapSearchNode cellGoal(goalX[i], goalY[i]);
+			scalarPerCell[i] = state.GoalDistanceEstimate(cellGoal);
+		}
+	}
+	Report("goal per cell, one at a time", Seconds(t0), estimates);
+
+	t0 = chrono::steady_clock::now();
+	for (int r = 0; r < ROUNDS; r++) {
+		BatchHeuristic::Estimate(&x[0], &y[0], &goalX[0], &goalY[0], CELLS,
+				&batch[0]);
+	}
+	Report("goal per cell, batch", Seconds(t0), estimates);
+	mismatches += !equal(scalarPerCell.begin(), scalarPerCell.end(),
+			batch.begin());
+
+	return mismatches;
+}
+
+// Expansions of the queries with CompactAStarSearch, and whether their
+// costs agree with the given ones, which are filled in if empty
+static long RunQueries(CompactAStarSearch &search,
+		vector<MapSearchNode> &starts, vector<MapSearchNode> &goals,
+		vector<float> &costs, int &costMismatches) {
+	long expansions = 0;
+	bool fill = costs.empty();
+
+	for (unsigned int i = 0; i < starts.size(); i++) {
+		search.SetStartAndGoalStates(starts[i], goals[i]);
+		unsigned int state;
+		do {
+			state = search.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+		expansions += search.GetStepCount();
+		float cost = search.GetSolutionCost();
+		if (fill) {
+			costs.push_back(cost);
+		} else if (cost != costs[i]
+				&& !(cost != FLT_MAX && costs[i] != FLT_MAX
+						&& fabs(cost - costs[i]) <= 1e-4f * cost)) {
+			costMismatches++;
+		}
+	}
+	return expansions;
+}
+
+static void MakeQueries(int size, int queries, vector<MapSearchNode> &starts,
+		vector<MapSearchNode> &goals) {
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode end(rand() % size, rand() % size);
+		if (Map::GetMap(start.x, start.y) < 9
+				&& Map::GetMap(end.x, end.y) < 9) {
+			starts.push_back(start);
+			goals.push_back(end);
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <queries> [<landmarks>]\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int queries = atoi(argv[2]);
+	int landmarkCount = argc > 3 ? atoi(argv[3]) : 8;
+
+	srand(1);
+	vector<int> data;
+	MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+	Map::SetWorldMap(size, size, data);
+
+	printf("Batches built for %s, estimates per second on one core\n",
+			BatchHeuristic::GetInstructionSet());
+	printf("Manhattan:\n");
+	int mismatches = BenchDistances(size, MapSearchNode::CONNECT_4);
+	printf("Octile:\n");
+	mismatches += BenchDistances(size, MapSearchNode::CONNECT_8);
+
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	LandmarkTable landmarks;
+	landmarks.Build(landmarkCount);
+	printf("Landmarks: %d built in %.3fs, %ld bytes\n",
+			landmarks.GetLandmarkCount(), Seconds(t0),
+			landmarks.GetTableSize());
+
+	// The bound one landmark at a time from a copy of the costs, against
+	// Raise()
+	vector<vector<float> > rows(landmarks.GetLandmarkCount());
+	for (unsigned int l = 0; l < rows.size(); l++) {
+		rows[l].resize(size * size);
+		for (int c = 0; c < size * size; c++) {
+			rows[l][c] = landmarks.GetDistance(l, c % size, c / size);
+		}
+	}
+
+	vector<int> x(CELLS), y(CELLS);
+	for (int i = 0; i < CELLS; i++) {
+		do {
+			x[i] = rand() % size;
+			y[i] = rand() % size;
+		} while (Map::GetMap(x[i], y[i]) >= 9);
+	}
+	MapSearchNode goal = MapSearchNode(x[0], y[0]);
+
+	vector<float> scalar(CELLS), batch(CELLS);
+	long estimates = (long) CELLS * ROUNDS;
+
+	t0 = chrono::steady_clock::now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i < CELLS; i++) {
+			MapSearchNode state(x[i], y[i]);
+			float h = state.GoalDistanceEstimate(goal);
+			for (unsigned int l = 0; l < rows.size(); l++) {
+				float toGoal = rows[l][goal.y * size + goal.x];
+				if (toGoal != FLT_MAX) {
+					h = max(h, toGoal - rows[l][y[i] * size + x[i]]);
+				}
+			}
+			scalar[i] = h;
+		}
+	}
+	Report("landmarks, one at a time", Seconds(t0), estimates);
+
+	t0 = chrono::steady_clock::now();
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i + 8 <= CELLS; i += 8) {
+			BatchHeuristic::Estimate(&x[i], &y[i], 8, goal.x, goal.y,
+					&batch[i]);
+			landmarks.Raise(&x[i], &y[i], 8, goal, &batch[i]);
+		}
+	}
+	Report("landmarks, batches of 8", Seconds(t0), estimates);
+	mismatches += !equal(scalar.begin(), scalar.end(), batch.begin());
+
+	// Searches with the octile distance alone and with the landmarks, on
+	// this map and then on rooms
+	vector<MapSearchNode> starts, goals;
+	MakeQueries(size, queries, starts, goals);
+
+	CompactAStarSearch search;
+	vector<float> costs;
+	int costMismatches = 0;
+	long expansions[2];
+
+	for (int map = 0; map < 2; map++) {
+		if (map == 1) {
+			MapGenerator::Generate(MapGenerator::MAP_ROOMS, size, 1, data);
+			Map::SetWorldMap(size, size, data);
+			landmarks.Build(landmarkCount);
+
+			starts.clear();
+			goals.clear();
+			costs.clear();
+			MakeQueries(size, queries, starts, goals);
+		}
+
+		for (int pass = 0; pass < 2; pass++) {
+			search.SetLandmarks(pass ? &landmarks : NULL);
+
+			t0 = chrono::steady_clock::now();
+			expansions[pass] = RunQueries(search, starts, goals, costs,
+					costMismatches);
+			printf("A* %-6s %-15s %.4fs, %ld expansions\n",
+					map ? "rooms," : "walls,",
+					pass ? "with landmarks:" : "octile:", Seconds(t0),
+					expansions[pass]);
+		}
+	}
+
+	if (mismatches || costMismatches) {
+		printf("%d batches differ from one at a time, %d costs differ\n",
+				mismatches, costMismatches);
+		return 1;
+	}
+	if (expansions[1] >= expansions[0]) {
+		printf("The landmarks save no expansions on rooms\n");
+		return 1;
+	}
+	return 0;
+}
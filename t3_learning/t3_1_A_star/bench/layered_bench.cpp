@@ -0,0 +1,177 @@
+/*
+ * layered_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Runs random queries over a LayeredMap with LayeredAStarSearch and checks
+// every cost against a plain Dijkstra search.
+//
+// floors: every layer is a floor with 20% walls over terrain costs 1 to 4,
+// joined to the next by stairs both ways, and searched 8-connected.
+// voxel: a cave of open cells that thin out towards the top layers,
+// searched 26-connected (or 6-connected with -6).
+//
+// Usage: layered_bench <floors | voxel> <size> <layers> <queries> [-6]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../LayeredAStarSearch.h"
+#include "../LayeredMap.h"
+
+using namespace std;
+
+const int STAIRS_PER_FLOOR = 4;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+static float Dijkstra(const LayeredMap &map, const LayeredMap::Cell &start,
+		const LayeredMap::Cell &goal) {
+	typedef pair<float, unsigned int> QueueEntry;
+
+	vector<float> distance(
+			map.GetWidth() * map.GetHeight() * map.GetLayerCount(), FLT_MAX);
+	vector<QueueEntry> open;
+	vector<LayeredMap::Cell> successors;
+	vector<float> costs;
+
+	distance[map.GetIndex(start)] = 0.0f;
+	open.push_back(QueueEntry(0.0f, map.GetIndex(start)));
+
+	while (!open.empty()) {
+		QueueEntry e = open.front();
+		pop_heap(open.begin(), open.end(), greater<QueueEntry>());
+		open.pop_back();
+
+		if (e.first > distance[e.second]) {
+			continue;
+		}
+		if (e.second == map.GetIndex(goal)) {
+			return e.first;
+		}
+
+		map.GetSuccessors(map.GetCell(e.second), successors, costs);
+		for (unsigned int i = 0; i < successors.size(); i++) {
+			unsigned int next = map.GetIndex(successors[i]);
+			if (e.first + costs[i] < distance[next]) {
+				distance[next] = e.first + costs[i];
+				open.push_back(QueueEntry(distance[next], next));
+				push_heap(open.begin(), open.end(), greater<QueueEntry>());
+			}
+		}
+	}
+	return FLT_MAX;
+}
+
+static LayeredMap::Cell RandomOpenCell(const LayeredMap &map) {
+	LayeredMap::Cell cell;
+	do {
+		cell = LayeredMap::Cell(rand() % map.GetWidth(),
+				rand() % map.GetHeight(), rand() % map.GetLayerCount());
+	} while (!map.IsOpen(cell.x, cell.y, cell.z));
+	return cell;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 5) {
+		printf("Usage: %s <floors | voxel> <size> <layers> <queries> [-6]\n",
+				argv[0]);
+		return 1;
+	}
+
+	bool floors = strcmp(argv[1], "floors") == 0;
+	int size = atoi(argv[2]);
+	int layers = atoi(argv[3]);
+	int queries = atoi(argv[4]);
+
+	LayeredMap map(size, size, layers);
+	srand(1);
+
+	vector<int> data(size * size);
+	for (int z = 0; z < layers; z++) {
+		// Voxel layers are open less and less often going up
+		int open = floors ? 80 : 70 - 65 * z / max(1, layers - 1);
+		for (unsigned int i = 0; i < data.size(); i++) {
+			data[i] = (rand() % 100 < open) ? 1 + rand() % 4 : 9;
+		}
+		map.SetLayer(z, data);
+	}
+
+	int portals = 0;
+	if (floors) {
+		map.SetConnectivity(LayeredMap::CONNECT_8);
+		for (int z = 0; z + 1 < layers; z++) {
+			for (int i = 0; i < STAIRS_PER_FLOOR; i++) {
+				LayeredMap::Cell bottom, top;
+				do {
+					bottom = LayeredMap::Cell(rand() % size, rand() % size, z);
+					top = LayeredMap::Cell(bottom.x, bottom.y, z + 1);
+				} while (!map.IsOpen(bottom.x, bottom.y, z)
+						|| !map.IsOpen(top.x, top.y, z + 1));
+
+				portals += map.AddPortal(bottom, top, 2.0f);
+				portals += map.AddPortal(top, bottom, 2.0f);
+			}
+		}
+	} else {
+		bool six = argc > 5 && strcmp(argv[5], "-6") == 0;
+		map.SetConnectivity(six ? LayeredMap::CONNECT_6 : LayeredMap::CONNECT_26);
+	}
+
+	printf("%dx%dx%d map, %d portals: %ld bytes, %ld as one byte a cell\n",
+			size, size, layers, portals, map.GetMemoryUsage(),
+			(long) size * size * layers);
+
+	LayeredAStarSearch search(map);
+	long expansions = 0;
+	int found = 0;
+	int mismatches = 0;
+	double searchTime = 0.0;
+
+	for (int q = 0; q < queries; q++) {
+		LayeredMap::Cell start = RandomOpenCell(map);
+		LayeredMap::Cell goal = RandomOpenCell(map);
+
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		search.SetStartAndGoalStates(start, goal);
+		unsigned int state;
+		do {
+			state = search.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+		searchTime += Seconds(t0);
+
+		expansions += search.GetStepCount();
+		found += state == AStarSearch::SEARCH_STATE_SUCCEEDED;
+
+		float cost = search.GetSolutionCost();
+		float reference = Dijkstra(map, start, goal);
+		if (cost != reference
+				&& !(cost != FLT_MAX && reference != FLT_MAX
+						&& fabs(cost - reference) <= 1e-4f * reference)) {
+			mismatches++;
+		}
+	}
+
+	printf("%d queries, %d found, %.4fs, %ld expansions\n", queries, found,
+			searchTime, expansions);
+
+	if (mismatches) {
+		printf("%d queries found a different cost\n", mismatches);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * node_layout_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Compares AStarSearch with CompactAStarSearch on random maps: node size,
+// nodes allocated and time per query.
+//
+// Usage: node_layout_bench <map size> <queries>
+// AStarSearch scans its lists linearly, so keep the map small enough for it
+// to finish; the timings include that difference as well as the layout.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+
+using namespace std;
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <queries>\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int queries = atoi(argv[2]);
+
+	srand(1);
+	vector<int> data;
+	MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+	Map::SetWorldMap(size, size, data);
+
+	vector<MapSearchNode> starts, goals;
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(rand() % size, rand() % size);
+		if (Map::GetMap(start.x, start.y) < 9
+				&& Map::GetMap(goal.x, goal.y) < 9) {
+			starts.push_back(start);
+			goals.push_back(goal);
+		}
+	}
+
+	printf("sizeof(AStarSearch::Node) %d, "
+			"sizeof(CompactAStarSearch::Node) %d\n",
+			(int) sizeof(AStarSearch::Node),
+			(int) sizeof(CompactAStarSearch::Node));
+
+	double wideTime = 0.0, compactTime = 0.0;
+	long wideSteps = 0, compactSteps = 0, compactNodes = 0;
+
+	for (int i = 0; i < queries; i++) {
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+		AStarSearch astarsearch;
+		astarsearch.SetStartAndGoalStates(starts[i], goals[i]);
+		unsigned int state;
+		do {
+			state = astarsearch.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+		float wideCost = astarsearch.GetSolutionCost();
+		wideSteps += astarsearch.GetStepCount();
+		if (state == AStarSearch::SEARCH_STATE_SUCCEEDED) {
+			astarsearch.FreeSolutionNodes();
+		}
+
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+		CompactAStarSearch compact;
+		compact.SetStartAndGoalStates(starts[i], goals[i]);
+		do {
+			state = compact.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+		compactSteps += compact.GetStepCount();
+		compactNodes += compact.GetNodeCount();
+
+		chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+		wideTime += chrono::duration<double>(t1 - t0).count();
+		compactTime += chrono::duration<double>(t2 - t1).count();
+
+		if (wideCost != compact.GetSolutionCost()) {
+			printf("query %d: costs differ, %f vs %f\n", i, wideCost,
+					compact.GetSolutionCost());
+		}
+	}
+
+	printf("AStarSearch        %10.1f us/query %8ld steps\n",
+			wideTime / queries * 1e6, wideSteps);
+	printf("CompactAStarSearch %10.1f us/query %8ld steps, %ld node bytes\n",
+			compactTime / queries * 1e6, compactSteps,
+			compactNodes * (long) sizeof(CompactAStarSearch::Node));
+
+	return 0;
+}
@@ -0,0 +1,278 @@
+/*
+ * overlay_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Scatters units over a map of walls over terrain costs 1 to 4 and checks
+// that CompactAStarSearch with an ObstacleOverlay holding them finds the
+// same costs as without one on a copy of the map with the units written in
+// as walls, working moves out from the map and reading them from an
+// EdgeCostTable. Corners may be cut, since units do not block corners.
+// Then times the queries with no overlay, with a still one and with
+// another thread moving every unit a cell and advancing the epoch as fast
+// as it can. Last, puts a wall of units across a small open map and checks
+// that Lazy Theta* does not see through it, and that the agent's own cell
+// being held does not stop the searches that walk moves backwards.
+//
+// Usage: overlay_bench <map size> <units> <queries>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../EdgeCostTable.h"
+#include "../LazyThetaStarSearch.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+#include "../MultiGoalSearch.h"
+#include "../ObstacleOverlay.h"
+#include "../RealTimeSearch.h"
+
+using namespace std;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+static float Search(CompactAStarSearch &search, MapSearchNode &start,
+		MapSearchNode &goal) {
+	search.SetStartAndGoalStates(start, goal);
+	unsigned int state;
+	do {
+		state = search.SearchStep();
+	} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+	return search.GetSolutionCost();
+}
+
+static bool SameCost(float cost, float reference) {
+	return cost == reference
+			|| (cost != FLT_MAX && reference != FLT_MAX
+					&& fabs(cost - reference) <= 1e-4f * reference);
+}
+
+static float Search(LazyThetaStarSearch &search, MapSearchNode &start,
+		MapSearchNode &goal, const MapSearchNode::Rules &rules) {
+	search.SetStartAndGoalStates(start, goal, rules);
+	unsigned int state;
+	do {
+		state = search.SearchStep();
+	} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+	return search.GetSolutionCost();
+}
+
+// A 10x10 open map with units on x = 5 for y = 0 to 8, so the way from one
+// side to the other is round the bottom. Returns the checks that failed
+static int CheckUnitWall() {
+	const int size = 10;
+	int failures = 0;
+
+	ObstacleOverlay overlay(size, size);
+	vector<int> walled(size * size, 1);
+	for (int y = 0; y < size - 1; y++) {
+		overlay.Block(5, y, 1);
+		walled[y * size + 5] = 9;
+	}
+
+	MapSearchNode start(1, 1);
+	MapSearchNode goal(8, 1);
+	MapSearchNode::Rules rules;
+	rules.overlay = NULL;
+	LazyThetaStarSearch theta;
+
+	Map::SetWorldMap(size, size, walled);
+	float reference = Search(theta, start, goal, rules);
+
+	Map::SetWorldMap(size, size, vector<int>(size * size, 1));
+	rules.overlay = &overlay;
+	if (!SameCost(Search(theta, start, goal, rules), reference)) {
+		printf("Lazy Theta* saw through the units\n");
+		failures++;
+	}
+
+	// The agent's own cell is held too, by the agent itself
+	overlay.Block(start.x, start.y, 1);
+
+	vector<MapSearchNode> targets;
+	targets.push_back(goal);
+	targets.push_back(MapSearchNode(9, 0));
+
+	MultiGoalSearch multi;
+	float costs[2];
+	for (int mode = 0; mode < 2; mode++) {
+		multi.SetMode(mode ? MultiGoalSearch::MODE_REVERSE_DIJKSTRA :
+				MultiGoalSearch::MODE_MIN_HEURISTIC);
+		multi.Search(start, targets, rules);
+		costs[mode] = multi.GetSolutionCost();
+	}
+	if (costs[0] == FLT_MAX || !SameCost(costs[1], costs[0])) {
+		printf("Multi-goal modes differ: %.2f forwards, %.2f backwards\n",
+				costs[0], costs[1]);
+		failures++;
+	}
+
+	// Enough trips for the learning to settle on the best path
+	RealTimeSearch agent;
+	agent.SetLookahead(4);
+	float travelled = FLT_MAX;
+	for (int trip = 0; trip < 20; trip++) {
+		agent.SetStartAndGoalStates(start, goal, rules);
+		unsigned int state;
+		do {
+			state = agent.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+		travelled = state == AStarSearch::SEARCH_STATE_SUCCEEDED ?
+				agent.GetTravelledCost() : FLT_MAX;
+	}
+	if (!SameCost(travelled, costs[0])) {
+		printf("Real-time search travelled %.2f, best %.2f\n", travelled,
+				costs[0]);
+		failures++;
+	}
+	return failures;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 4) {
+		printf("Usage: %s <map size> <units> <queries>\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int units = atoi(argv[2]);
+	int queries = atoi(argv[3]);
+
+	MapSearchNode::SetMovement(MapSearchNode::CONNECT_8,
+			MapSearchNode::CORNER_CUT_ALLOWED);
+
+	srand(1);
+	vector<int> data;
+	MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+
+	vector<MapSearchNode> starts, goals;
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(rand() % size, rand() % size);
+		if (data[start.y * size + start.x] < 9
+				&& data[goal.y * size + goal.x] < 9) {
+			starts.push_back(start);
+			goals.push_back(goal);
+		}
+	}
+
+	// Units stand on open cells, but never on a start or goal
+	vector<bool> endpoint(size * size, false);
+	for (int i = 0; i < queries; i++) {
+		endpoint[starts[i].y * size + starts[i].x] = true;
+		endpoint[goals[i].y * size + goals[i].x] = true;
+	}
+	vector<int> unitX, unitY;
+	while ((int) unitX.size() < units) {
+		int x = rand() % size;
+		int y = rand() % size;
+		if (data[y * size + x] < 9 && !endpoint[y * size + x]) {
+			unitX.push_back(x);
+			unitY.push_back(y);
+		}
+	}
+
+	ObstacleOverlay overlay(size, size);
+	vector<int> walled(data);
+	for (int u = 0; u < units; u++) {
+		overlay.Block(unitX[u], unitY[u], 1);
+		walled[unitY[u] * size + unitX[u]] = 9;
+	}
+
+	CompactAStarSearch search;
+	EdgeCostTable table;
+	vector<float> reference(queries);
+	int mismatches = 0;
+
+	Map::SetWorldMap(size, size, walled);
+	for (int i = 0; i < queries; i++) {
+		reference[i] = Search(search, starts[i], goals[i]);
+	}
+
+	Map::SetWorldMap(size, size, data);
+	table.Build();
+	MapSearchNode::SetObstacleOverlay(&overlay);
+	for (int pass = 0; pass < 2; pass++) {
+		MapSearchNode::SetEdgeCosts(pass ? &table : NULL);
+		for (int i = 0; i < queries; i++) {
+			if (!SameCost(Search(search, starts[i], goals[i]), reference[i])) {
+				mismatches++;
+			}
+		}
+	}
+	MapSearchNode::SetEdgeCosts(NULL);
+
+	// Timings: none, still, and moving on another thread
+	for (int pass = 0; pass < 3; pass++) {
+		MapSearchNode::SetObstacleOverlay(pass ? &overlay : NULL);
+
+		atomic<bool> done(false);
+		long moves = 0;
+		thread mover;
+		if (pass == 2) {
+			mover = thread([&]() {
+				vector<int> x(unitX), y(unitY);
+				while (!done.load()) {
+					for (int u = 0; u < units; u++) {
+						int nx = x[u] + rand() % 3 - 1;
+						int ny = y[u] + rand() % 3 - 1;
+						if (nx >= 0 && nx < size && ny >= 0 && ny < size
+								&& data[ny * size + nx] < 9) {
+							x[u] = nx;
+							y[u] = ny;
+						}
+						overlay.Block(x[u], y[u], 2);
+					}
+					overlay.Advance();
+					moves++;
+				}
+			});
+		}
+
+		long expansions = 0;
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (int i = 0; i < queries; i++) {
+			Search(search, starts[i], goals[i]);
+			expansions += search.GetStepCount();
+		}
+		double time = Seconds(t0);
+
+		done.store(true);
+		if (pass == 2) {
+			mover.join();
+		}
+		printf("%-9s %.4fs, %.1f us/query, %ld expansions", pass == 0 ?
+				"None:" : pass == 1 ? "Still:" : "Moving:", time,
+				time * 1e6 / queries, expansions);
+		if (pass == 2) {
+			printf(", %ld epochs", moves);
+		}
+		printf("\n");
+	}
+	MapSearchNode::SetObstacleOverlay(NULL);
+
+	if (CheckUnitWall()) {
+		return 1;
+	}
+
+	if (mismatches) {
+		printf("%d searches differ from the walled map\n", mismatches);
+		return 1;
+	}
+	printf("All %d costs match the walled map\n", 2 * queries);
+	return 0;
+}
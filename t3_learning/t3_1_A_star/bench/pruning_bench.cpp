@@ -0,0 +1,153 @@
+/*
+ * pruning_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Runs the same random queries with CompactAStarSearch with and without
+// RegionPruning, checks the costs agree and reports the expansions and time
+// saved. The rooms map is a grid of rooms joined by one cell doors, some of
+// them dead ends; the random map is the one the other benchmarks use.
+//
+// Usage: pruning_bench <rooms | random> <map size> <queries> [-8]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+#include "../RegionPruning.h"
+
+using namespace std;
+
+const int ROOM_SIZE = 8;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+// Walls every ROOM_SIZE cells. Each room opens a door to its right and one
+// below, but a quarter of the doors are left shut
+static void MakeRooms(int size, vector<int> &data) {
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			bool wall = x % ROOM_SIZE == 0 || y % ROOM_SIZE == 0;
+			data[y * size + x] = wall ? 9 : 1 + rand() % 4;
+		}
+	}
+
+	for (int y = 0; y < size; y += ROOM_SIZE) {
+		for (int x = 0; x < size; x += ROOM_SIZE) {
+			int door = 1 + rand() % (ROOM_SIZE - 1);
+			if (x + door < size && y > 0 && rand() % 4) {
+				data[y * size + x + door] = 1;
+			}
+			door = 1 + rand() % (ROOM_SIZE - 1);
+			if (y + door < size && x > 0 && rand() % 4) {
+				data[(y + door) * size + x] = 1;
+			}
+		}
+	}
+}
+
+static float Run(CompactAStarSearch &search, MapSearchNode start,
+		MapSearchNode goal, long &expansions) {
+	search.SetStartAndGoalStates(start, goal);
+	unsigned int state;
+	do {
+		state = search.SearchStep();
+	} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+	expansions += search.GetStepCount();
+	return search.GetSolutionCost();
+}
+
+int main(int argc, char **argv) {
+	if (argc < 4) {
+		printf("Usage: %s <rooms | random> <map size> <queries> [-8]\n",
+				argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[2]);
+	int queries = atoi(argv[3]);
+	if (argc > 4 && strcmp(argv[4], "-8") == 0) {
+		MapSearchNode::SetMovement(MapSearchNode::CONNECT_8,
+				MapSearchNode::CORNER_CUT_FORBIDDEN);
+	}
+
+	srand(1);
+	vector<int> data(size * size);
+	if (strcmp(argv[1], "rooms") == 0) {
+		MakeRooms(size, data);
+	} else {
+		MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+	}
+	Map::SetWorldMap(size, size, data);
+
+	RegionPruning pruning;
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	pruning.Build();
+	printf("Built in %.3fs: %d blocks, %d swamps covering %d cells\n",
+			Seconds(t0), pruning.GetBlockCount(), pruning.GetSwampCount(),
+			pruning.GetSwampCellCount());
+
+	// Queries between open cells only
+	vector<MapSearchNode> starts, goals;
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(rand() % size, rand() % size);
+		if (Map::GetMap(start.x, start.y) < 9
+				&& Map::GetMap(goal.x, goal.y) < 9) {
+			starts.push_back(start);
+			goals.push_back(goal);
+		}
+	}
+
+	CompactAStarSearch plain;
+	CompactAStarSearch pruned;
+	pruned.SetPruning(&pruning);
+
+	long plainExpansions = 0, prunedExpansions = 0;
+	vector<float> costs(queries);
+
+	t0 = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		costs[i] = Run(plain, starts[i], goals[i], plainExpansions);
+	}
+	double plainTime = Seconds(t0);
+
+	int mismatches = 0;
+	t0 = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		float cost = Run(pruned, starts[i], goals[i], prunedExpansions);
+		if (cost != costs[i]
+				&& !(cost != FLT_MAX && costs[i] != FLT_MAX
+						&& fabs(cost - costs[i]) <= 1e-4f * costs[i])) {
+			mismatches++;
+		}
+	}
+	double prunedTime = Seconds(t0);
+
+	printf("unpruned %10.4fs expansions %ld\n", plainTime, plainExpansions);
+	printf("pruned   %10.4fs expansions %ld (%.1f%% fewer) speedup %.2f\n",
+			prunedTime, prunedExpansions,
+			100.0 * (plainExpansions - prunedExpansions) / plainExpansions,
+			plainTime / prunedTime);
+
+	if (mismatches) {
+		printf("%d queries found a different cost\n", mismatches);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * quadtree_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Builds a QuadtreeMap for a map of mostly open terrain: cost 1 ground with
+// rectangles of rough ground (cost 3) and walls. Runs random queries through
+// the leaves, refines each into cells and checks the cell path is a legal
+// walk of the cost reported, then compares both with CompactAStarSearch.
+//
+// Usage: quadtree_bench <map size> <queries> [<rectangles>] [-4]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../Map.h"
+#include "../MapSearchNode.h"
+#include "../QuadtreeMap.h"
+
+using namespace std;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+// Sum of the move costs along the path, FLT_MAX if a move is not allowed
+static float PathCost(vector<MapSearchNode> &path) {
+	vector<int> x, y;
+	float cost = 0.0f;
+
+	for (unsigned int i = 0; i + 1 < path.size(); i++) {
+		path[i].GetSuccessors(NULL, x, y);
+
+		bool legal = false;
+		for (unsigned int j = 0; j < x.size(); j++) {
+			legal = legal || (x[j] == path[i + 1].x && y[j] == path[i + 1].y);
+		}
+		if (!legal) {
+			return FLT_MAX;
+		}
+		cost += path[i].GetCost(path[i + 1]);
+	}
+	return cost;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <queries> [<rectangles>] [-4]\n",
+				argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int queries = atoi(argv[2]);
+	int rectangles = argc > 3 ? atoi(argv[3]) : size / 8;
+	bool four = argc > 4 && strcmp(argv[4], "-4") == 0;
+
+	MapSearchNode::SetMovement(
+			four ? MapSearchNode::CONNECT_4 : MapSearchNode::CONNECT_8,
+			MapSearchNode::CORNER_CUT_FORBIDDEN);
+
+	// Walls are thin and long, rough ground comes in blocks
+	srand(1);
+	vector<int> data(size * size, 1);
+	for (int i = 0; i < rectangles; i++) {
+		bool wall = rand() % 2;
+		int w = wall ? 1 + rand() % (size / 4) : 4 + rand() % (size / 8);
+		int h = wall ? 1 : 4 + rand() % (size / 8);
+		if (wall && rand() % 2) {
+			swap(w, h);
+		}
+
+		int x0 = rand() % size;
+		int y0 = rand() % size;
+		for (int y = y0; y < min(size, y0 + h); y++) {
+			for (int x = x0; x < min(size, x0 + w); x++) {
+				data[y * size + x] = wall ? 9 : 3;
+			}
+		}
+	}
+	Map::SetWorldMap(size, size, data);
+
+	QuadtreeMap tree;
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	tree.Build();
+	printf("Built in %.3fs: %d cells, %d leaves (%d open), %d adjacencies\n",
+			Seconds(t0), size * size, tree.GetLeafCount(),
+			tree.GetOpenLeafCount(), tree.GetAdjacencyCount());
+
+	vector<MapSearchNode> starts, goals;
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(rand() % size, rand() % size);
+		if (Map::GetMap(start.x, start.y) < 9
+				&& Map::GetMap(goal.x, goal.y) < 9) {
+			starts.push_back(start);
+			goals.push_back(goal);
+		}
+	}
+
+	CompactAStarSearch search;
+	vector<float> costs(queries);
+	long expansions = 0;
+
+	t0 = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		search.SetStartAndGoalStates(starts[i], goals[i]);
+		unsigned int state;
+		do {
+			state = search.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+		costs[i] = search.GetSolutionCost();
+		expansions += search.GetStepCount();
+	}
+	double searchTime = Seconds(t0);
+
+	vector<int> leaves;
+	vector<MapSearchNode> path;
+	long leafExpansions = 0;
+	long refinedExpansions = 0;
+	double queryTime = 0.0;
+	double refineTime = 0.0;
+	double ratio = 0.0;
+	double worst = 1.0;
+	int found = 0;
+	int illegal = 0;
+	int missed = 0;
+
+	for (int i = 0; i < queries; i++) {
+		t0 = chrono::steady_clock::now();
+		float estimate = tree.Query(starts[i], goals[i], &leaves);
+		queryTime += Seconds(t0);
+		leafExpansions += tree.GetExpandedCount();
+
+		t0 = chrono::steady_clock::now();
+		float cost = tree.Refine(starts[i], goals[i], leaves, path);
+		refineTime += Seconds(t0);
+		refinedExpansions += tree.GetRefinedCount();
+
+		if (costs[i] == FLT_MAX) {
+			missed += estimate != FLT_MAX;
+			continue;
+		}
+		if (estimate == FLT_MAX || cost == FLT_MAX) {
+			missed++;
+			continue;
+		}
+
+		float walked = PathCost(path);
+		if (walked == FLT_MAX || fabs(walked - cost) > 1e-4f * cost
+				|| cost < costs[i] * (1.0f - 1e-4f)) {
+			illegal++;
+			continue;
+		}
+
+		found++;
+		double r = costs[i] > 0.0f ? cost / costs[i] : 1.0;
+		ratio += r;
+		worst = max(worst, r);
+	}
+
+	printf("A*:       %.4fs, %ld expansions\n", searchTime, expansions);
+	printf("Quadtree: %.4fs + %.4fs refining, %ld leaf + %ld cell "
+			"expansions\n", queryTime, refineTime, leafExpansions,
+			refinedExpansions);
+	printf("%d refined paths, cost %.4f of optimal on average, %.4f at "
+			"worst\n", found, found ? ratio / found : 1.0, worst);
+
+	if (illegal || missed) {
+		printf("%d illegal paths, %d reachability mismatches\n", illegal,
+				missed);
+		return 1;
+	}
+	return 0;
+}
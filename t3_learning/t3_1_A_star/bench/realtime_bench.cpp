@@ -0,0 +1,161 @@
+/*
+ * realtime_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Walks an agent with RealTimeSearch between random pairs of cells of an
+// 8-connected random map, repeating each trip so the learned heuristic
+// converges. Checks every move is legal, and reports the worst expansions
+// and the times of a single step with the cost of the first and last trips
+// against the optimal cost from CompactAStarSearch.
+//
+// Usage: realtime_bench <map size> <queries> [<lookahead>] [<trips>]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+#include "../RealTimeSearch.h"
+
+using namespace std;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+static bool IsMove(MapSearchNode &from, MapSearchNode &to) {
+	vector<int> x, y;
+	from.GetSuccessors(NULL, x, y);
+
+	for (unsigned int i = 0; i < x.size(); i++) {
+		if (x[i] == to.x && y[i] == to.y) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <queries> [<lookahead>] [<trips>]\n",
+				argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int queries = atoi(argv[2]);
+	int lookahead = argc > 3 ? atoi(argv[3]) : 64;
+	int trips = argc > 4 ? atoi(argv[4]) : 10;
+
+	MapSearchNode::SetMovement(MapSearchNode::CONNECT_8,
+			MapSearchNode::CORNER_CUT_FORBIDDEN);
+
+	srand(1);
+	vector<int> data;
+	MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+	Map::SetWorldMap(size, size, data);
+
+	CompactAStarSearch search;
+	RealTimeSearch agent;
+	agent.SetLookahead(lookahead);
+
+	int walked = 0;
+	int illegal = 0;
+	int failed = 0;
+	int maxExpanded = 0;
+	vector<double> stepTimes;
+	double firstRatio = 0.0;
+	double lastRatio = 0.0;
+
+	while (walked < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(rand() % size, rand() % size);
+		if (Map::GetMap(start.x, start.y) >= 9
+				|| Map::GetMap(goal.x, goal.y) >= 9
+				|| start.IsSameState(goal)) {
+			continue;
+		}
+
+		// The agent cannot tell an unreachable goal until it has seen its
+		// whole region, so only reachable pairs are walked
+		search.SetStartAndGoalStates(start, goal);
+		unsigned int state;
+		do {
+			state = search.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+		if (state != AStarSearch::SEARCH_STATE_SUCCEEDED) {
+			continue;
+		}
+		float optimal = search.GetSolutionCost();
+		walked++;
+
+		for (int trip = 0; trip < trips; trip++) {
+			agent.SetStartAndGoalStates(start, goal);
+
+			do {
+				MapSearchNode from = agent.GetPosition();
+
+				chrono::steady_clock::time_point t0 =
+						chrono::steady_clock::now();
+				state = agent.SearchStep();
+				double t = Seconds(t0);
+
+				stepTimes.push_back(t);
+				maxExpanded = max(maxExpanded, agent.GetExpandedCount());
+
+				MapSearchNode to = agent.GetPosition();
+				if (state != AStarSearch::SEARCH_STATE_FAILED
+						&& !IsMove(from, to)) {
+					illegal++;
+				}
+			} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+			if (state != AStarSearch::SEARCH_STATE_SUCCEEDED) {
+				failed++;
+				break;
+			}
+
+			double ratio = agent.GetTravelledCost() / optimal;
+			if (trip == 0) {
+				firstRatio += ratio;
+			}
+			if (trip == trips - 1) {
+				lastRatio += ratio;
+			}
+		}
+	}
+
+	// The worst single step is mostly down to the scheduler, so the 99.9th
+	// percentile is given too
+	double stepTime = 0.0;
+	for (unsigned int i = 0; i < stepTimes.size(); i++) {
+		stepTime += stepTimes[i];
+	}
+	sort(stepTimes.begin(), stepTimes.end());
+
+	printf("Lookahead %d, %d queries of %d trips, %d steps\n", lookahead,
+			walked, trips, (int) stepTimes.size());
+	printf("Step: %.2fus on average, %.2fus at 99.9%%, %.2fus and %d "
+			"expansions at worst\n", stepTime / stepTimes.size() * 1e6,
+			stepTimes[stepTimes.size() * 999 / 1000] * 1e6,
+			stepTimes.back() * 1e6, maxExpanded);
+	printf("Cost against optimal: %.3f first trip, %.3f trip %d\n",
+			firstRatio / walked, lastRatio / walked, trips);
+
+	if (illegal || failed) {
+		printf("%d illegal moves, %d failed trips\n", illegal, failed);
+		return 1;
+	}
+	return 0;
+}
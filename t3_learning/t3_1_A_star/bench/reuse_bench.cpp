@@ -0,0 +1,166 @@
+/*
+ * reuse_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Time per query of short paths, which are most queries, with a new search
+// object for every query against one kept for all of them: AStarSearch
+// freeing each solution or Reset() between queries, and CompactAStarSearch.
+// Only goals the start can reach are used. Checks the costs agree and that
+// no AStarSearch node is left alive.
+//
+// Usage: reuse_bench <map size> <queries> [<radius>]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+
+using namespace std;
+
+enum {
+	WIDE_NEW, WIDE_REUSED, WIDE_RESET, COMPACT_NEW, COMPACT_REUSED, MODES
+};
+
+static const char *MODE_NAMES[MODES] = { "AStarSearch, new per query",
+		"AStarSearch, reused", "AStarSearch, reused with Reset()",
+		"CompactAStarSearch, new per query", "CompactAStarSearch, reused" };
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+static unsigned int Run(AStarSearch &search, MapSearchNode &start,
+		MapSearchNode &goal) {
+	search.SetStartAndGoalStates(start, goal);
+	unsigned int state;
+	do {
+		state = search.SearchStep();
+	} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+	return state;
+}
+
+static unsigned int Run(CompactAStarSearch &search, MapSearchNode &start,
+		MapSearchNode &goal) {
+	search.SetStartAndGoalStates(start, goal);
+	unsigned int state;
+	do {
+		state = search.SearchStep();
+	} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+	return state;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <queries> [<radius>]\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int queries = atoi(argv[2]);
+	int radius = argc > 3 ? atoi(argv[3]) : 8;
+
+	MapSearchNode::SetMovement(MapSearchNode::CONNECT_8,
+			MapSearchNode::CORNER_CUT_FORBIDDEN);
+
+	srand(1);
+	vector<int> data;
+	MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+	Map::SetWorldMap(size, size, data);
+
+	// Goals within radius of the start, either way on each axis. Only
+	// reachable ones, AStarSearch would take a very long time to find out
+	// the rest are not
+	vector<MapSearchNode> starts, goals;
+	CompactAStarSearch check;
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(start.x + rand() % (2 * radius + 1) - radius,
+				start.y + rand() % (2 * radius + 1) - radius);
+		if (goal.x >= 0 && goal.x < size && goal.y >= 0 && goal.y < size
+				&& Map::GetMap(start.x, start.y) < 9
+				&& Map::GetMap(goal.x, goal.y) < 9
+				&& Run(check, start, goal)
+						== AStarSearch::SEARCH_STATE_SUCCEEDED) {
+			starts.push_back(start);
+			goals.push_back(goal);
+		}
+	}
+
+	vector<float> costs(queries);
+	AStarSearch reused;
+	CompactAStarSearch compactReused;
+	int mismatches = 0;
+	int leaks = 0;
+
+	for (int mode = 0; mode < MODES; mode++) {
+		long steps = 0;
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+		for (int i = 0; i < queries; i++) {
+			float cost;
+
+			if (mode == WIDE_NEW) {
+				AStarSearch search;
+				unsigned int state = Run(search, starts[i], goals[i]);
+				cost = search.GetSolutionCost();
+				steps += search.GetStepCount();
+
+				if (state == AStarSearch::SEARCH_STATE_SUCCEEDED) {
+					search.FreeSolutionNodes();
+				}
+				leaks += search.GetNodeCount() != 0;
+			} else if (mode == WIDE_REUSED || mode == WIDE_RESET) {
+				unsigned int state = Run(reused, starts[i], goals[i]);
+				cost = reused.GetSolutionCost();
+				steps += reused.GetStepCount();
+
+				if (mode == WIDE_RESET) {
+					reused.Reset();
+				} else if (state == AStarSearch::SEARCH_STATE_SUCCEEDED) {
+					reused.FreeSolutionNodes();
+				}
+				leaks += reused.GetNodeCount() != 0;
+			} else if (mode == COMPACT_NEW) {
+				CompactAStarSearch search;
+				Run(search, starts[i], goals[i]);
+				cost = search.GetSolutionCost();
+				steps += search.GetStepCount();
+			} else {
+				Run(compactReused, starts[i], goals[i]);
+				cost = compactReused.GetSolutionCost();
+				steps += compactReused.GetStepCount();
+			}
+
+			if (mode == 0) {
+				costs[i] = cost;
+			} else if (cost != costs[i]
+					&& !(cost != FLT_MAX && costs[i] != FLT_MAX
+							&& fabs(cost - costs[i]) <= 1e-4f * cost)) {
+				mismatches++;
+			}
+		}
+
+		double t = Seconds(t0);
+		printf("%-36s %8.2fus a query, %.1f expansions a query\n",
+				MODE_NAMES[mode], t / queries * 1e6, (double) steps / queries);
+	}
+
+	if (mismatches || leaks) {
+		printf("%d costs differ, %d searches left nodes alive\n", mismatches,
+				leaks);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,422 @@
+/*
+ * search_suite.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Runs a set of queries over one map with every search mode and reports,
+// as JSON on stdout, each mode's build time, expansions per second, peak
+// memory and query latency percentiles. Expansions are counted the way each
+// mode counts them: cells, subgoals, hierarchy nodes settled or quadtree
+// leaves plus the cells refined. Peak memory is the resident set high water
+// mark from the start of the mode, taking in the map, reset between modes
+// through /proc/self/clear_refs where the kernel allows it.
+//
+// Usage: search_suite <maze | rooms | random | open> <size> <queries>
+//        [<options>]
+//        search_suite <map file> <query file> [<options>]
+// Options: -modes <mode,mode,...> runs only these, -4 searches 4-connected,
+// -limit <seconds> stops a mode's queries after this long, 60 by default,
+// -threads <count> for parallel, all the cores by default.
+//
+// Subgoal graph and hierarchy queries unpack their paths into cells, as
+// the searches have theirs.
+//
+// Modes: astar, compact, landmarks, pruning, lazytheta, smastar, parallel,
+// subgoal, ch, quadtree. astar scans its lists linearly and is only worth
+// running on small maps. lazytheta finds any-angle paths and quadtree
+// near-optimal ones, so their costs differ from the rest. subgoal only
+// runs on uniform terrain, 8-connected. Goal bounds, which run a Dijkstra
+// search from every cell to build, and the agent-centred RealTimeSearch are
+// left out.
+//
+// Maps and queries are made or read by MapGenerator, see map_generator.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../ContractionHierarchy.h"
+#include "../LandmarkTable.h"
+#include "../LazyThetaStarSearch.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+#include "../ParallelAStarSearch.h"
+#include "../QuadtreeMap.h"
+#include "../RegionPruning.h"
+#include "../SMAStarSearch.h"
+#include "../SubgoalGraph.h"
+
+using namespace std;
+
+const char *ALL_MODES =
+		"astar,compact,landmarks,pruning,lazytheta,smastar,parallel,subgoal,"
+				"ch,quadtree";
+
+const int LANDMARKS = 8;
+const int SMA_NODE_BUDGET = 1 << 20;
+
+// Runs one query, adding the expansions to the count, and returns its cost,
+// FLT_MAX if it found no path
+typedef function<float(MapSearchNode &, MapSearchNode &, long &)>
+		QueryFunction;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+// Steps a search made by the mode to the end, CompactAStarSearch or one of
+// the searches with the same interface
+template<class Search>
+static float RunSearch(Search &search, MapSearchNode &start,
+		MapSearchNode &goal, long &expansions) {
+	search.SetStartAndGoalStates(start, goal);
+	unsigned int state;
+	do {
+		state = search.SearchStep();
+	} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+	expansions += search.GetStepCount();
+	return state == AStarSearch::SEARCH_STATE_SUCCEEDED ?
+			search.GetSolutionCost() : FLT_MAX;
+}
+
+// Starts a new peak memory measurement, false if only the peak of the
+// whole run can be had
+static bool ResetPeakMemory() {
+#ifdef __GLIBC__
+	// Hand back what the last mode freed, or it still counts
+	malloc_trim(0);
+#endif
+
+	FILE *file = fopen("/proc/self/clear_refs", "w");
+	if (!file) {
+		return false;
+	}
+	bool ok = fputs("5", file) >= 0;
+	return fclose(file) == 0 && ok;
+}
+
+static long GetPeakMemory() {
+	FILE *file = fopen("/proc/self/status", "r");
+	if (!file) {
+		return -1;
+	}
+
+	char line[256];
+	long kilobytes = -1;
+	while (fgets(line, sizeof(line), file)) {
+		if (sscanf(line, "VmHWM: %ld kB", &kilobytes) == 1) {
+			break;
+		}
+	}
+	fclose(file);
+	return kilobytes < 0 ? -1 : kilobytes * 1024;
+}
+
+// Builds what the mode needs and returns its query function, or an empty
+// one with the reason when the mode cannot run on this map
+static QueryFunction Prepare(const string &mode, int threads,
+		string &reason) {
+	if (mode == "astar") {
+		shared_ptr<AStarSearch> search(new AStarSearch);
+		return [search](MapSearchNode &start, MapSearchNode &goal,
+				long &expansions) {
+			float cost = RunSearch(*search, start, goal, expansions);
+			if (cost != FLT_MAX) {
+				search->FreeSolutionNodes();
+			}
+			return cost;
+		};
+	}
+
+	if (mode == "compact" || mode == "landmarks" || mode == "pruning") {
+		shared_ptr<CompactAStarSearch> search(new CompactAStarSearch);
+		shared_ptr<LandmarkTable> landmarks;
+		shared_ptr<RegionPruning> pruning;
+
+		if (mode == "landmarks") {
+			landmarks.reset(new LandmarkTable);
+			landmarks->Build(LANDMARKS);
+			search->SetLandmarks(landmarks.get());
+		} else if (mode == "pruning") {
+			pruning.reset(new RegionPruning);
+			pruning->Build();
+			search->SetPruning(pruning.get());
+		}
+		return [search, landmarks, pruning](MapSearchNode &start,
+				MapSearchNode &goal, long &expansions) {
+			return RunSearch(*search, start, goal, expansions);
+		};
+	}
+
+	if (mode == "lazytheta") {
+		shared_ptr<LazyThetaStarSearch> search(new LazyThetaStarSearch);
+		return [search](MapSearchNode &start, MapSearchNode &goal,
+				long &expansions) {
+			return RunSearch(*search, start, goal, expansions);
+		};
+	}
+
+	if (mode == "smastar") {
+		shared_ptr<SMAStarSearch> search(new SMAStarSearch(SMA_NODE_BUDGET));
+		return [search](MapSearchNode &start, MapSearchNode &goal,
+				long &expansions) {
+			return RunSearch(*search, start, goal, expansions);
+		};
+	}
+
+	if (mode == "parallel") {
+		shared_ptr<ParallelAStarSearch> search(
+				new ParallelAStarSearch(threads));
+		return [search](MapSearchNode &start, MapSearchNode &goal,
+				long &expansions) {
+			unsigned int state = search->Search(start, goal);
+			expansions += search->GetStepCount();
+			return state == AStarSearch::SEARCH_STATE_SUCCEEDED ?
+					search->GetSolutionCost() : FLT_MAX;
+		};
+	}
+
+	if (mode == "subgoal") {
+		shared_ptr<SubgoalGraph> graph(new SubgoalGraph);
+		if (!graph->Build()) {
+			reason = "needs uniform terrain, 8-connected";
+			return QueryFunction();
+		}
+		return [graph](MapSearchNode &start, MapSearchNode &goal,
+				long &expansions) {
+			vector<MapSearchNode> path;
+			float cost = graph->Query(start, goal, &path);
+			expansions += graph->GetExpandedCount();
+			return cost;
+		};
+	}
+
+	if (mode == "ch") {
+		shared_ptr<ContractionHierarchy> hierarchy(new ContractionHierarchy);
+		hierarchy->Build();
+		return [hierarchy](MapSearchNode &start, MapSearchNode &goal,
+				long &expansions) {
+			vector<MapSearchNode> path;
+			float cost = hierarchy->Query(start, goal, &path);
+			expansions += hierarchy->GetSettledCount();
+			return cost;
+		};
+	}
+
+	if (mode == "quadtree") {
+		shared_ptr<QuadtreeMap> tree(new QuadtreeMap);
+		tree->Build();
+		return [tree](MapSearchNode &start, MapSearchNode &goal,
+				long &expansions) {
+			vector<int> leaves;
+			vector<MapSearchNode> path;
+			float cost = FLT_MAX;
+			if (tree->Query(start, goal, &leaves) != FLT_MAX) {
+				cost = tree->Refine(start, goal, leaves, path);
+			}
+			expansions += tree->GetExpandedCount() + tree->GetRefinedCount();
+			return cost;
+		};
+	}
+
+	reason = "unknown mode";
+	return QueryFunction();
+}
+
+// Latency of the query at fraction of the way through the sorted times,
+// nearest rank
+static double Percentile(const vector<double> &sorted, double fraction) {
+	int rank = (int) (fraction * sorted.size() + 0.999999);
+	return sorted[max(0, min((int) sorted.size() - 1, rank - 1))];
+}
+
+static void RunMode(const string &mode, int threads, double limit,
+		vector<MapSearchNode> &starts, vector<MapSearchNode> &goals,
+		bool first) {
+	bool resetPeak = ResetPeakMemory();
+
+	string reason;
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	QueryFunction query = Prepare(mode, threads, reason);
+	double buildTime = Seconds(t0);
+
+	printf("%s\n    {\"mode\": \"%s\", ", first ? "" : ",", mode.c_str());
+	if (!query) {
+		printf("\"skipped\": \"%s\"}", reason.c_str());
+		return;
+	}
+
+	vector<double> latencies;
+	long expansions = 0;
+	int solved = 0;
+	double costSum = 0.0;
+	double searchTime = 0.0;
+
+	for (unsigned int i = 0; i < starts.size() && searchTime < limit; i++) {
+		t0 = chrono::steady_clock::now();
+		float cost = query(starts[i], goals[i], expansions);
+		double latency = Seconds(t0);
+
+		searchTime += latency;
+		latencies.push_back(latency * 1e6);
+		if (cost != FLT_MAX) {
+			solved++;
+			costSum += cost;
+		}
+	}
+	long peakMemory = GetPeakMemory();
+	sort(latencies.begin(), latencies.end());
+
+	printf("\"build_seconds\": %.3f, \"queries\": %d, \"solved\": %d, "
+			"\"mean_cost\": %.3f, \"expansions\": %ld, "
+			"\"expansions_per_second\": %.0f, ", buildTime,
+			(int) latencies.size(), solved, solved ? costSum / solved : 0.0,
+			expansions, searchTime > 0.0 ? expansions / searchTime : 0.0);
+	printf("\"peak_memory_bytes\": %ld, \"peak_memory_scope\": \"%s\", ",
+			peakMemory, resetPeak ? "mode" : "process");
+	if (latencies.empty()) {
+		printf("\"latency_us\": null}");
+		return;
+	}
+	printf("\"latency_us\": {\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, "
+			"\"p999\": %.1f, \"max\": %.1f}}", Percentile(latencies, 0.5),
+			Percentile(latencies, 0.9), Percentile(latencies, 0.99),
+			Percentile(latencies, 0.999), latencies.back());
+}
+
+// A JSON string, quotes, backslashes and control characters escaped
+static void PrintJsonString(const char *text) {
+	putchar('"');
+	for (const char *c = text; *c; c++) {
+		if (*c == '"' || *c == '\\') {
+			printf("\\%c", *c);
+		} else if ((unsigned char) *c < 0x20) {
+			printf("\\u%04x", (unsigned char) *c);
+		} else {
+			putchar(*c);
+		}
+	}
+	putchar('"');
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <maze | rooms | random | open> <size> <queries> "
+				"[<options>]\n", argv[0]);
+		printf("       %s <map file> <query file> [<options>]\n", argv[0]);
+		printf("Options: -modes <%s> -4 -limit <seconds> -threads <count>\n",
+				ALL_MODES);
+		return 1;
+	}
+
+	int width, height;
+	vector<int> data;
+	vector<MapSearchNode> starts, goals;
+	int kind = MapGenerator::GetKind(argv[1]);
+	int next;
+
+	if (kind >= 0) {
+		if (argc < 4 || atoi(argv[2]) <= 0) {
+			printf("Give a map size and a number of queries\n");
+			return 1;
+		}
+		width = height = atoi(argv[2]);
+		MapGenerator::Generate(kind, width, 1, data);
+		MapGenerator::GenerateQueries(width, data, atoi(argv[3]), 2, starts,
+				goals);
+		next = 4;
+	} else {
+		if (!MapGenerator::Load(argv[1], width, height, data)) {
+			printf("Cannot load map %s\n", argv[1]);
+			return 1;
+		}
+		if (!MapGenerator::LoadQueries(argv[2], starts, goals)) {
+			printf("Cannot load queries %s\n", argv[2]);
+			return 1;
+		}
+
+		// Not every mode checks its cells are on the map
+		for (unsigned int i = 0; i < starts.size(); i++) {
+			if (starts[i].x < 0 || starts[i].x >= width || starts[i].y < 0
+					|| starts[i].y >= height || goals[i].x < 0
+					|| goals[i].x >= width || goals[i].y < 0
+					|| goals[i].y >= height) {
+				printf("Query %u in %s is off the map\n", i + 1, argv[2]);
+				return 1;
+			}
+		}
+		next = 3;
+	}
+
+	string modes = ALL_MODES;
+	bool four = false;
+	double limit = 60.0;
+	int threads = max(1, (int) thread::hardware_concurrency());
+
+	for (int i = next; i < argc; i++) {
+		if (strcmp(argv[i], "-4") == 0) {
+			four = true;
+		} else if (strcmp(argv[i], "-modes") == 0 && i + 1 < argc) {
+			modes = argv[++i];
+		} else if (strcmp(argv[i], "-limit") == 0 && i + 1 < argc) {
+			limit = atof(argv[++i]);
+		} else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+			threads = max(1, atoi(argv[++i]));
+		} else {
+			printf("Unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	MapSearchNode::SetMovement(
+			four ? MapSearchNode::CONNECT_4 : MapSearchNode::CONNECT_8,
+			MapSearchNode::CORNER_CUT_FORBIDDEN);
+	Map::SetWorldMap(width, height, data);
+
+	long openCells = count_if(data.begin(), data.end(),
+			[](int terrain) {return terrain < 9;});
+	data.clear();
+	data.shrink_to_fit();
+
+	printf("{\n  \"map\": {\"source\": ");
+	PrintJsonString(argv[1]);
+	printf(", \"width\": %d, \"height\": %d, \"open_cells\": %ld, "
+			"\"connectivity\": %d},\n", width, height, openCells,
+			four ? 4 : 8);
+	printf("  \"queries\": %d, \"limit_seconds\": %.1f, \"threads\": %d,\n",
+			(int) starts.size(), limit, threads);
+	printf("  \"modes\": [");
+
+	bool first = true;
+	for (size_t begin = 0; begin <= modes.size();) {
+		size_t end = modes.find(',', begin);
+		if (end == string::npos) {
+			end = modes.size();
+		}
+		RunMode(modes.substr(begin, end - begin), threads, limit, starts,
+				goals, first);
+		fflush(stdout);
+		first = false;
+		begin = end + 1;
+	}
+	printf("\n  ]\n}\n");
+	return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * snapshot_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Serves several worlds from one process. Makes a number of random maps of
+// walls over terrain costs 1 to 4 as MapSnapshots and finds reference costs
+// for random queries on each, one world at a time. Then runs all the
+// queries again, every world's interleaved with the others', from several
+// threads that each bind the snapshot of the query in hand, through a
+// PathQueryPool given each query's snapshot, and a few with
+// ParallelAStarSearch, whose threads must follow the snapshot of the
+// thread that starts it. All the while another thread keeps replacing the
+// world map. Every cost must match its reference.
+//
+// Usage: snapshot_bench <map size> <worlds> <queries per world> [<threads>]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+#include "../MapSnapshot.h"
+#include "../ParallelAStarSearch.h"
+#include "../PathQueryPool.h"
+
+using namespace std;
+
+const int PARALLEL_QUERIES = 8;
+
+struct World {
+	shared_ptr<const MapSnapshot> map;
+	vector<MapSearchNode> starts;
+	vector<MapSearchNode> goals;
+	vector<float> costs;
+};
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+static float Search(CompactAStarSearch &search, MapSearchNode &start,
+		MapSearchNode &goal) {
+	search.SetStartAndGoalStates(start, goal);
+	unsigned int state;
+	do {
+		state = search.SearchStep();
+	} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+	return search.GetSolutionCost();
+}
+
+static bool SameCost(float cost, float reference) {
+	return cost == reference
+			|| (cost != FLT_MAX && reference != FLT_MAX
+					&& fabs(cost - reference) <= 1e-4f * reference);
+}
+
+int main(int argc, char **argv) {
+	if (argc < 4) {
+		printf("Usage: %s <map size> <worlds> <queries per world> "
+				"[<threads>]\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int worldCount = atoi(argv[2]);
+	int queries = atoi(argv[3]);
+	int threads = argc > 4 ? atoi(argv[4]) : 4;
+
+	MapSearchNode::SetMovement(MapSearchNode::CONNECT_8,
+			MapSearchNode::CORNER_CUT_FORBIDDEN);
+
+	srand(1);
+	vector<World> worlds(worldCount);
+	vector<int> data;
+	for (int w = 0; w < worldCount; w++) {
+		MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, w + 1, data);
+		worlds[w].map = make_shared<const MapSnapshot>(size, size, data);
+
+		while ((int) worlds[w].starts.size() < queries) {
+			MapSearchNode start(rand() % size, rand() % size);
+			MapSearchNode goal(rand() % size, rand() % size);
+			if (worlds[w].map->GetMap(start.x, start.y) < 9
+					&& worlds[w].map->GetMap(goal.x, goal.y) < 9) {
+				worlds[w].starts.push_back(start);
+				worlds[w].goals.push_back(goal);
+			}
+		}
+	}
+
+	// References, one world at a time
+	CompactAStarSearch search;
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	for (int w = 0; w < worldCount; w++) {
+		Map::SnapshotScope scope(worlds[w].map);
+		for (int i = 0; i < queries; i++) {
+			worlds[w].costs.push_back(
+					Search(search, worlds[w].starts[i], worlds[w].goals[i]));
+		}
+	}
+	printf("%-12s %.4fs\n", "Serial:", Seconds(t0));
+
+	// Keep replacing the world map with maps of another size
+	atomic<bool> done(false);
+	atomic<int> replacements(0);
+	thread replacer([&]() {
+		vector<int> other;
+		for (int n = 0; !done.load(); n++) {
+			MapGenerator::Generate(MapGenerator::MAP_RANDOM, size / 2 + n % 2,
+					n, other);
+			Map::SetWorldMap(size / 2 + n % 2, size / 2 + n % 2, other);
+			replacements++;
+		}
+	});
+
+	// Query i of world w is the (i * worldCount + w)th handed out
+	int total = worldCount * queries;
+	atomic<int> next(0);
+	atomic<int> threadMismatches(0);
+	vector<thread> searchers;
+	t0 = chrono::steady_clock::now();
+	for (int t = 0; t < threads; t++) {
+		searchers.push_back(thread([&]() {
+			CompactAStarSearch own;
+			for (int n = next++; n < total; n = next++) {
+				World &world = worlds[n % worldCount];
+				int i = n / worldCount;
+
+				Map::SnapshotScope scope(world.map);
+				float cost = Search(own, world.starts[i], world.goals[i]);
+				if (!SameCost(cost, world.costs[i])) {
+					threadMismatches++;
+				}
+			}
+		}));
+	}
+	for (int t = 0; t < threads; t++) {
+		searchers[t].join();
+	}
+	printf("%-12s %.4fs, %d threads\n", "Threads:", Seconds(t0), threads);
+
+	int poolMismatches = 0;
+	{
+		PathQueryPool pool(threads);
+		vector<future<PathQueryPool::Result> > results;
+		t0 = chrono::steady_clock::now();
+		for (int n = 0; n < total; n++) {
+			World &world = worlds[n % worldCount];
+			results.push_back(
+					pool.Submit(world.map, world.starts[n / worldCount],
+							world.goals[n / worldCount]));
+		}
+		for (int n = 0; n < total; n++) {
+			if (!SameCost(results[n].get().cost,
+					worlds[n % worldCount].costs[n / worldCount])) {
+				poolMismatches++;
+			}
+		}
+		printf("%-12s %.4fs, %d threads\n", "Pool:", Seconds(t0), threads);
+	}
+
+	int parallelMismatches = 0;
+	ParallelAStarSearch parallel(threads);
+	t0 = chrono::steady_clock::now();
+	for (int n = 0; n < min(total, PARALLEL_QUERIES); n++) {
+		World &world = worlds[n % worldCount];
+		int i = n / worldCount;
+
+		Map::SnapshotScope scope(world.map);
+		parallel.Search(world.starts[i], world.goals[i]);
+		if (!SameCost(parallel.GetSolutionCost(), world.costs[i])) {
+			parallelMismatches++;
+		}
+	}
+	printf("%-12s %.4fs, %d queries\n", "HDA*:", Seconds(t0),
+			min(total, PARALLEL_QUERIES));
+
+	done.store(true);
+	replacer.join();
+	printf("World map replaced %d times meanwhile\n", replacements.load());
+
+	if (threadMismatches.load() || poolMismatches || parallelMismatches) {
+		printf("%d thread, %d pool and %d HDA* costs differ\n",
+				threadMismatches.load(), poolMismatches, parallelMismatches);
+		return 1;
+	}
+	printf("All costs match\n");
+	return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * subgoal_bench.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Builds a SubgoalGraph for an 8-connected random map of walls over uniform
+// terrain, saves it and loads it back, then runs random queries through it
+// and through CompactAStarSearch, checking the costs agree and that every
+// refined path is a legal walk of that cost.
+//
+// Usage: subgoal_bench <map size> <queries> [<wall percent>] [<graph file>]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../CompactAStarSearch.h"
+#include "../Map.h"
+#include "../MapSearchNode.h"
+#include "../SubgoalGraph.h"
+
+using namespace std;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+// Sum of the move costs along the path, FLT_MAX if a move is not allowed
+static float PathCost(vector<MapSearchNode> &path) {
+	vector<int> x, y;
+	float cost = 0.0f;
+
+	for (unsigned int i = 0; i + 1 < path.size(); i++) {
+		path[i].GetSuccessors(NULL, x, y);
+
+		bool legal = false;
+		for (unsigned int j = 0; j < x.size(); j++) {
+			legal = legal || (x[j] == path[i + 1].x && y[j] == path[i + 1].y);
+		}
+		if (!legal) {
+			return FLT_MAX;
+		}
+		cost += path[i].GetCost(path[i + 1]);
+	}
+	return cost;
+}
+
+static bool Same(float a, float b) {
+	return a == b || (a != FLT_MAX && b != FLT_MAX && fabs(a - b) <= 1e-4f * a);
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <map size> <queries> [<wall percent>] "
+				"[<graph file>]\n", argv[0]);
+		return 1;
+	}
+
+	int size = atoi(argv[1]);
+	int queries = atoi(argv[2]);
+	int walls = argc > 3 ? atoi(argv[3]) : 20;
+	const char *fileName = argc > 4 ? argv[4] : "subgoal_bench.ssg";
+
+	MapSearchNode::SetMovement(MapSearchNode::CONNECT_8,
+			MapSearchNode::CORNER_CUT_FORBIDDEN);
+
+	srand(1);
+	vector<int> data(size * size);
+	for (unsigned int i = 0; i < data.size(); i++) {
+		data[i] = (rand() % 100 < walls) ? 9 : 1;
+	}
+	Map::SetWorldMap(size, size, data);
+
+	SubgoalGraph built;
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+	if (!built.Build()) {
+		printf("Map not supported\n");
+		return 1;
+	}
+	printf("Built in %.3fs: %d subgoals, %d edges\n", Seconds(t0),
+			built.GetSubgoalCount(), built.GetEdgeCount());
+
+	if (!built.Save(fileName)) {
+		printf("Cannot save %s\n", fileName);
+		return 1;
+	}
+
+	SubgoalGraph graph;
+	t0 = chrono::steady_clock::now();
+	if (!graph.Load(fileName)) {
+		printf("Cannot load %s\n", fileName);
+		return 1;
+	}
+	printf("Loaded in %.4fs\n", Seconds(t0));
+
+	vector<MapSearchNode> starts, goals;
+	while ((int) starts.size() < queries) {
+		MapSearchNode start(rand() % size, rand() % size);
+		MapSearchNode goal(rand() % size, rand() % size);
+		if (Map::GetMap(start.x, start.y) < 9
+				&& Map::GetMap(goal.x, goal.y) < 9) {
+			starts.push_back(start);
+			goals.push_back(goal);
+		}
+	}
+
+	CompactAStarSearch search;
+	vector<float> costs(queries);
+	long expansions = 0;
+
+	t0 = chrono::steady_clock::now();
+	for (int i = 0; i < queries; i++) {
+		search.SetStartAndGoalStates(starts[i], goals[i]);
+		unsigned int state;
+		do {
+			state = search.SearchStep();
+		} while (state == AStarSearch::SEARCH_STATE_SEARCHING);
+
+		costs[i] = search.GetSolutionCost();
+		expansions += search.GetStepCount();
+	}
+	double searchTime = Seconds(t0);
+
+	vector<MapSearchNode> path;
+	long graphExpansions = 0;
+	int mismatches = 0;
+	double graphTime = 0.0;
+
+	for (int i = 0; i < queries; i++) {
+		t0 = chrono::steady_clock::now();
+		float cost = graph.Query(starts[i], goals[i], &path);
+		graphTime += Seconds(t0);
+		graphExpansions += graph.GetExpandedCount();
+
+		if (!Same(cost, costs[i])
+				|| (cost != FLT_MAX && !Same(PathCost(path), cost))) {
+			mismatches++;
+		}
+	}
+
+	printf("A*            %10.4fs expansions %ld\n", searchTime, expansions);
+	printf("subgoal graph %10.4fs expansions %ld speedup %.2f\n", graphTime,
+			graphExpansions, searchTime / graphTime);
+
+	if (mismatches) {
+		printf("%d queries did not match\n", mismatches);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * PathProtocol.h
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+#ifndef PATHPROTOCOL_H_
+#define PATHPROTOCOL_H_
+
+#include <stdint.h>
+
+// Wire format between path_daemon and its clients over a Unix domain socket.
+// Both ends are on the same machine, so everything is in host byte order.
+//
+// On connect the daemon sends a HelloMessage. After that the client sends
+// request batches whenever it likes, without waiting for replies, and the
+// daemon answers every batch with a response batch, in the order the
+// requests came in. Once PATH_MAX_PENDING queries of a connection are
+// waiting to be answered, the daemon reads no more from it until answers
+// have gone out, so a client that keeps sending must keep reading too.
+//
+// A request batch is a BatchHeader followed by count QueryRequests. A
+// response batch is a BatchHeader followed by count results, each a
+// QueryResponse followed by pathBytes bytes of path in the PathEncoder
+// format.
+
+const uint32_t PATH_HELLO_MAGIC = 0x4f4c4850; // "PHLO"
+const uint32_t PATH_REQUEST_MAGIC = 0x51525150; // "PQRQ"
+const uint32_t PATH_RESPONSE_MAGIC = 0x53525150; // "PQRS"
+
+// Larger batches are refused and the connection closed
+const uint32_t PATH_MAX_BATCH = 65536;
+
+// Queries of one connection the daemon holds unanswered at most. A batch
+// is taken whole, so the limit is exceeded by at most one batch
+const uint32_t PATH_MAX_PENDING = 2 * PATH_MAX_BATCH;
+
+struct HelloMessage {
+	uint32_t magic;
+	uint32_t width;
+	uint32_t height;
+};
+
+struct BatchHeader {
+	uint32_t magic;
+	uint32_t id; // chosen by the client, echoed in the response
+	uint32_t count;
+};
+
+struct QueryRequest {
+	uint16_t startX;
+	uint16_t startY;
+	uint16_t goalX;
+	uint16_t goalY;
+};
+
+struct QueryResponse {
+	uint32_t status; // a PathQueryPool::QUERY_* value
+	float cost;
+	uint32_t pathBytes;
+};
+
+#endif /* PATHPROTOCOL_H_ */
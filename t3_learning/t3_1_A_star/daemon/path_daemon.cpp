@@ -0,0 +1,330 @@
+/*
+ * path_daemon.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Serves path queries over a Unix domain socket, see PathProtocol.h. The map
+// is loaded once at start up. Every connection gets a reader thread, which
+// hands each query of a batch to a shared PathQueryPool as soon as it
+// arrives, and a writer thread, which sends the answers back batch by batch
+// as they complete. A client can so keep many batches in flight, and they are
+// worked on by all the pool's threads at once. Past PATH_MAX_PENDING
+// unanswered queries the reader stops reading until the writer catches up.
+//
+// Usage: path_daemon <socket path> <threads> [<map file> | <map size>]
+// A map file holds the width and height and then every terrain value, as
+// whitespace separated text, row by row. A map size makes a random map of
+// that size like the benchmarks do. Without either the built-in map is
+// served.
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../Map.h"
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+#include "../PathEncoder.h"
+#include "../PathQueryPool.h"
+#include "PathProtocol.h"
+
+using namespace std;
+
+struct PendingBatch {
+	uint32_t id;
+	vector<future<PathQueryPool::Result> > results;
+};
+
+// Batches read but not yet answered, in arrival order. An empty slot means
+// the client has gone. Push waits while PATH_MAX_PENDING queries are queued,
+// which keeps the reader off the socket until the writer catches up
+class PendingQueue {
+public:
+	PendingQueue() :
+			m_Queries(0) {
+	}
+
+	void Push(PendingBatch *batch) {
+		unsigned int queries = batch ? batch->results.size() : 0;
+		{
+			unique_lock<mutex> lock(m_Mutex);
+			while (!m_Batches.empty()
+					&& m_Queries + queries > PATH_MAX_PENDING) {
+				m_Space.wait(lock);
+			}
+			m_Batches.push_back(batch);
+			m_Queries += queries;
+		}
+		m_Ready.notify_one();
+	}
+
+	PendingBatch *Pop() {
+		PendingBatch *batch;
+		{
+			unique_lock<mutex> lock(m_Mutex);
+			while (m_Batches.empty()) {
+				m_Ready.wait(lock);
+			}
+			batch = m_Batches.front();
+			m_Batches.pop_front();
+			m_Queries -= batch ? batch->results.size() : 0;
+		}
+		m_Space.notify_one();
+		return batch;
+	}
+
+private:
+	mutex m_Mutex;
+	condition_variable m_Ready;
+	condition_variable m_Space;
+	deque<PendingBatch *> m_Batches;
+	unsigned int m_Queries;
+};
+
+static bool ReadFully(int fd, void *data, size_t size) {
+	char *p = (char *) data;
+	while (size > 0) {
+		ssize_t n = read(fd, p, size);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		p += n;
+		size -= n;
+	}
+	return true;
+}
+
+static bool WriteFully(int fd, const void *data, size_t size) {
+	const char *p = (const char *) data;
+	while (size > 0) {
+		ssize_t n = send(fd, p, size, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		p += n;
+		size -= n;
+	}
+	return true;
+}
+
+static bool IsOpen(int x, int y, const MapSearchNode::Rules &rules) {
+	return x < Map::GetWidth() && y < Map::GetHeight()
+			&& Map::GetClearance(x, y) >= rules.agentSize;
+}
+
+// Queries that cannot succeed are answered without troubling the pool
+static future<PathQueryPool::Result> Submit(PathQueryPool &pool,
+		const QueryRequest &request) {
+	// Checked against the same map the pool searches
+	shared_ptr<const MapSnapshot> map = Map::GetSnapshot();
+	Map::SnapshotScope scope(map);
+
+	MapSearchNode::Rules rules;
+	if (!IsOpen(request.startX, request.startY, rules)
+			|| !IsOpen(request.goalX, request.goalY, rules)) {
+		promise<PathQueryPool::Result> failed;
+		failed.set_value(PathQueryPool::Result());
+		return failed.get_future();
+	}
+
+	return pool.Submit(map, rules,
+			MapSearchNode(request.startX, request.startY),
+			MapSearchNode(request.goalX, request.goalY));
+}
+
+static void WriteResponses(int fd, PendingQueue *pending) {
+	vector<unsigned char> out;
+	bool connected = true;
+
+	for (;;) {
+		PendingBatch *batch = pending->Pop();
+		if (!batch) {
+			return;
+		}
+
+		BatchHeader header;
+		header.magic = PATH_RESPONSE_MAGIC;
+		header.id = batch->id;
+		header.count = batch->results.size();
+
+		out.assign((unsigned char *) &header,
+				(unsigned char *) &header + sizeof(header));
+
+		// Collect every answer even once the client has gone, so the batch
+		// can be freed
+		for (unsigned int i = 0; i < batch->results.size(); i++) {
+			PathQueryPool::Result result = batch->results[i].get();
+
+			// Every move in a run of its own is the most it can take
+			unsigned int offset = out.size() + sizeof(QueryResponse);
+			out.resize(
+					offset + PathEncoder::HEADER_SIZE
+							+ result.path.size());
+
+			PathEncoder encoder(&out[offset], out.size() - offset);
+			for (unsigned int j = 0; j < result.path.size(); j++) {
+				encoder.Add(result.path[j]);
+			}
+			int pathBytes = encoder.Finish();
+			out.resize(offset + pathBytes);
+
+			QueryResponse response;
+			response.status = result.status;
+			response.cost = result.cost;
+			response.pathBytes = pathBytes;
+			memcpy(&out[offset - sizeof(response)], &response,
+					sizeof(response));
+		}
+		delete batch;
+
+		if (connected) {
+			connected = WriteFully(fd, &out[0], out.size());
+		}
+	}
+}
+
+static void Serve(int fd, PathQueryPool *pool) {
+	HelloMessage hello;
+	hello.magic = PATH_HELLO_MAGIC;
+	hello.width = Map::GetWidth();
+	hello.height = Map::GetHeight();
+
+	PendingQueue pending;
+	thread writer(WriteResponses, fd, &pending);
+
+	vector<QueryRequest> requests;
+	BatchHeader header;
+
+	if (WriteFully(fd, &hello, sizeof(hello))) {
+		while (ReadFully(fd, &header, sizeof(header))
+				&& header.magic == PATH_REQUEST_MAGIC
+				&& header.count <= PATH_MAX_BATCH) {
+			requests.resize(header.count);
+			if (header.count > 0
+					&& !ReadFully(fd, &requests[0],
+							header.count * sizeof(QueryRequest))) {
+				break;
+			}
+
+			PendingBatch *batch = new PendingBatch;
+			batch->id = header.id;
+			for (unsigned int i = 0; i < requests.size(); i++) {
+				batch->results.push_back(Submit(*pool, requests[i]));
+			}
+			pending.Push(batch);
+		}
+	}
+
+	pending.Push(NULL);
+	writer.join();
+	close(fd);
+}
+
+static bool LoadMap(const char *path) {
+	FILE *file = fopen(path, "r");
+	if (!file) {
+		return false;
+	}
+
+	int width, height;
+	bool ok = fscanf(file, "%d %d", &width, &height) == 2 && width > 0
+			&& height > 0 && width <= 0x10000 && height <= 0x10000;
+
+	vector<int> data;
+	for (int i = 0; ok && i < width * height; i++) {
+		int value;
+		ok = fscanf(file, "%d", &value) == 1;
+		data.push_back(value);
+	}
+	fclose(file);
+
+	if (ok) {
+		Map::SetWorldMap(width, height, data);
+	}
+	return ok;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <socket path> <threads> [<map file> | <map size>]\n",
+				argv[0]);
+		return 1;
+	}
+
+	Map map;
+
+	if (argc > 3) {
+		int size = atoi(argv[3]);
+
+		if (size > 0) {
+			// Same random map as the benchmarks
+			vector<int> data;
+			MapGenerator::Generate(MapGenerator::MAP_RANDOM, size, 1, data);
+			Map::SetWorldMap(size, size, data);
+		} else if (!LoadMap(argv[3])) {
+			printf("Cannot load map %s\n", argv[3]);
+			return 1;
+		}
+	}
+
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (strlen(argv[1]) >= sizeof(address.sun_path)) {
+		printf("Socket path too long\n");
+		return 1;
+	}
+	strcpy(address.sun_path, argv[1]);
+
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(argv[1]);
+	if (listener < 0
+			|| bind(listener, (sockaddr *) &address, sizeof(address)) < 0
+			|| listen(listener, 64) < 0) {
+		perror("path_daemon");
+		return 1;
+	}
+
+	PathQueryPool pool(atoi(argv[2]));
+	printf("Serving a %dx%d map on %s with %d threads\n", Map::GetWidth(),
+			Map::GetHeight(), argv[1], pool.GetThreadCount());
+	fflush(stdout);
+
+	for (;;) {
+		int fd = accept(listener, NULL, NULL);
+		if (fd < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			perror("path_daemon");
+			break;
+		}
+
+		thread(Serve, fd, &pool).detach();
+	}
+
+	// Connections may still be using the pool, so leave without unwinding
+	close(listener);
+	unlink(argv[1]);
+	exit(1);
+}
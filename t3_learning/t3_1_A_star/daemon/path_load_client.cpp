@@ -0,0 +1,325 @@
+/*
+ * path_load_client.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Load generator for path_daemon. Each connection keeps up to <in flight>
+// batches of random queries outstanding, pipelined on one socket, and times
+// every batch from send to the end of its response. Prints the throughput
+// and the batch latency percentiles, and checks every returned path decodes
+// to a walk from the start to the goal.
+//
+// Usage: path_load_client <socket path> <connections> <batches>
+//        <batch size> [<in flight>]
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../MapSearchNode.h"
+#include "../PathEncoder.h"
+#include "../PathQueryPool.h"
+#include "PathProtocol.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static bool ReadFully(int fd, void *data, size_t size) {
+	char *p = (char *) data;
+	while (size > 0) {
+		ssize_t n = read(fd, p, size);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		p += n;
+		size -= n;
+	}
+	return true;
+}
+
+static bool WriteFully(int fd, const void *data, size_t size) {
+	const char *p = (const char *) data;
+	while (size > 0) {
+		ssize_t n = send(fd, p, size, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		p += n;
+		size -= n;
+	}
+	return true;
+}
+
+struct Connection {
+	int fd;
+	int batches;
+	int batchSize;
+	int inFlight;
+	unsigned int seed;
+	HelloMessage hello;
+
+	// Send time and queries of every batch, by id, and the batches sent but
+	// not answered, all under the lock
+	mutex lock;
+	condition_variable slot;
+	vector<Clock::time_point> sent;
+	vector<vector<QueryRequest> > queries;
+	int outstanding;
+
+	vector<double> latencies;
+
+	int succeeded;
+	int failed;
+	int bad;
+	long pathBytes;
+	bool error;
+};
+
+static void Send(Connection *c) {
+	vector<char> out;
+
+	vector<QueryRequest> queries(c->batchSize);
+
+	for (int id = 0; id < c->batches; id++) {
+		BatchHeader header;
+		header.magic = PATH_REQUEST_MAGIC;
+		header.id = id;
+		header.count = c->batchSize;
+
+		for (int i = 0; i < c->batchSize; i++) {
+			queries[i].startX = rand_r(&c->seed) % c->hello.width;
+			queries[i].startY = rand_r(&c->seed) % c->hello.height;
+			queries[i].goalX = rand_r(&c->seed) % c->hello.width;
+			queries[i].goalY = rand_r(&c->seed) % c->hello.height;
+		}
+
+		out.assign((char *) &header, (char *) &header + sizeof(header));
+		out.insert(out.end(), (char *) &queries[0],
+				(char *) &queries[0] + queries.size() * sizeof(QueryRequest));
+
+		{
+			unique_lock<mutex> lock(c->lock);
+			while (c->outstanding >= c->inFlight && !c->error) {
+				c->slot.wait(lock);
+			}
+			if (c->error) {
+				return;
+			}
+			c->outstanding++;
+			c->queries[id] = queries;
+			c->sent[id] = Clock::now();
+		}
+
+		if (!WriteFully(c->fd, &out[0], out.size())) {
+			return;
+		}
+	}
+}
+
+static bool CheckPath(const QueryRequest &query, const unsigned char *data,
+		int size) {
+	vector<MapSearchNode> path;
+	if (!PathEncoder::Decode(data, size, path) || path.empty()) {
+		return false;
+	}
+	return path.front().x == query.startX && path.front().y == query.startY
+			&& path.back().x == query.goalX && path.back().y == query.goalY;
+}
+
+static void Receive(Connection *c) {
+	vector<QueryRequest> queries;
+	vector<unsigned char> path;
+	bool error = false;
+
+	for (int received = 0; !error && received < c->batches; received++) {
+		BatchHeader header;
+		if (!ReadFully(c->fd, &header, sizeof(header))
+				|| header.magic != PATH_RESPONSE_MAGIC
+				|| header.id >= (uint32_t) c->batches) {
+			error = true;
+			break;
+		}
+
+		Clock::time_point sent;
+		{
+			lock_guard<mutex> lock(c->lock);
+			queries.swap(c->queries[header.id]);
+			sent = c->sent[header.id];
+		}
+		error = header.count != queries.size();
+
+		for (uint32_t i = 0; !error && i < header.count; i++) {
+			QueryResponse response;
+			if (!ReadFully(c->fd, &response, sizeof(response))) {
+				error = true;
+				break;
+			}
+
+			path.resize(response.pathBytes);
+			if (response.pathBytes > 0
+					&& !ReadFully(c->fd, &path[0], response.pathBytes)) {
+				error = true;
+				break;
+			}
+
+			if (response.status == PathQueryPool::QUERY_SUCCEEDED) {
+				c->succeeded++;
+				c->pathBytes += response.pathBytes;
+				if (!CheckPath(queries[i], &path[0], response.pathBytes)) {
+					c->bad++;
+				}
+			} else {
+				c->failed++;
+			}
+		}
+
+		c->latencies.push_back(
+				chrono::duration<double>(Clock::now() - sent).count());
+
+		{
+			lock_guard<mutex> lock(c->lock);
+			c->outstanding--;
+		}
+		c->slot.notify_one();
+	}
+
+	// Release the sender if it is waiting on a connection that failed
+	{
+		lock_guard<mutex> lock(c->lock);
+		c->error = error;
+	}
+	c->slot.notify_one();
+}
+
+static int Connect(const char *path) {
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0 || connect(fd, (sockaddr *) &address, sizeof(address)) < 0) {
+		perror("path_load_client");
+		return -1;
+	}
+	return fd;
+}
+
+static double Percentile(const vector<double> &sorted, double p) {
+	if (sorted.empty()) {
+		return 0.0;
+	}
+	unsigned int i = (unsigned int) (p * (sorted.size() - 1) + 0.5);
+	return sorted[i];
+}
+
+int main(int argc, char **argv) {
+	if (argc < 5) {
+		printf("Usage: %s <socket path> <connections> <batches> "
+				"<batch size> [<in flight>]\n", argv[0]);
+		return 1;
+	}
+
+	int connections = max(1, atoi(argv[2]));
+	int batches = max(1, atoi(argv[3]));
+	int batchSize = max(1, atoi(argv[4]));
+	int inFlight = argc > 5 ? max(1, atoi(argv[5])) : 4;
+
+	vector<Connection *> clients;
+	for (int i = 0; i < connections; i++) {
+		Connection *c = new Connection;
+		c->fd = Connect(argv[1]);
+		if (c->fd < 0 || !ReadFully(c->fd, &c->hello, sizeof(c->hello))
+				|| c->hello.magic != PATH_HELLO_MAGIC) {
+			printf("Cannot talk to the daemon\n");
+			return 1;
+		}
+
+		c->batches = batches;
+		c->batchSize = batchSize;
+		c->inFlight = inFlight;
+		c->seed = i + 1;
+		c->sent.resize(batches);
+		c->queries.resize(batches);
+		c->outstanding = 0;
+		c->succeeded = c->failed = c->bad = 0;
+		c->pathBytes = 0;
+		c->error = false;
+		clients.push_back(c);
+	}
+
+	Clock::time_point start = Clock::now();
+
+	vector<thread> threads;
+	for (int i = 0; i < connections; i++) {
+		threads.push_back(thread(Send, clients[i]));
+		threads.push_back(thread(Receive, clients[i]));
+	}
+	for (unsigned int i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+
+	double elapsed = chrono::duration<double>(Clock::now() - start).count();
+
+	vector<double> latencies;
+	int succeeded = 0, failed = 0, bad = 0;
+	long pathBytes = 0;
+	bool error = false;
+
+	for (int i = 0; i < connections; i++) {
+		Connection *c = clients[i];
+		latencies.insert(latencies.end(), c->latencies.begin(),
+				c->latencies.end());
+		succeeded += c->succeeded;
+		failed += c->failed;
+		bad += c->bad;
+		pathBytes += c->pathBytes;
+		error = error || c->error;
+
+		close(c->fd);
+		delete c;
+	}
+	sort(latencies.begin(), latencies.end());
+
+	int queries = succeeded + failed;
+	printf("%d queries in %.3fs: %.0f queries/s, %d found, %d no path, "
+			"%.1f bytes a path\n", queries, elapsed, queries / elapsed,
+			succeeded, failed,
+			succeeded ? (double) pathBytes / succeeded : 0.0);
+	printf("batch latency ms: p50 %.3f p90 %.3f p99 %.3f p99.9 %.3f "
+			"max %.3f\n", Percentile(latencies, 0.5) * 1e3,
+			Percentile(latencies, 0.9) * 1e3, Percentile(latencies, 0.99) * 1e3,
+			Percentile(latencies, 0.999) * 1e3,
+			latencies.empty() ? 0.0 : latencies.back() * 1e3);
+
+	if (error) {
+		printf("Connection failed\n");
+	}
+	if (bad) {
+		printf("%d paths did not join their start and goal\n", bad);
+	}
+	if (error || bad) {
+		return 1;
+	}
+	return 0;
+}
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "AStarSearch.h"
+#include "SearchGenerator.h"
 #include "MapSearchNode.h"
 #include "Map.h"
 
@@ -96,15 +97,11 @@ int main() {
 
 	astarsearch.SetStartAndGoalStates(nodeStart, nodeEnd);
 
-	unsigned int SearchState;
-	unsigned int SearchSteps = 0;
+	unsigned int SearchState = AStarSearch::SEARCH_STATE_SEARCHING;
 
-	do {
-		SearchState = astarsearch.SearchStep();
-
-		SearchSteps++;
-
-	} while (SearchState == AStarSearch::SEARCH_STATE_SEARCHING);
+	for (const SearchProgress &progress : IncrementalSearch(astarsearch, 16)) {
+		SearchState = progress.state;
+	}
 
 	if (SearchState != AStarSearch::SEARCH_STATE_SUCCEEDED) {
 		cout << "Search terminated. Did not find goal state\n";
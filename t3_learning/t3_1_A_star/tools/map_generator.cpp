@@ -0,0 +1,100 @@
+/*
+ * map_generator.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Writes a synthetic map made by MapGenerator and a set of random queries
+// over it, for search_suite or path_daemon to load.
+//
+// Usage: map_generator <maze | rooms | random | open> <size> <queries>
+//        <map file> <query file> [<seed>]
+//        map_generator all <queries> <directory> [<seed>]
+//
+// all writes every kind at every power of two size from 256 to 16384, as
+// <kind>_<size>.map and <kind>_<size>.queries in the directory. The largest
+// maps take a gigabyte of memory to make and half that on disk each.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../MapGenerator.h"
+#include "../MapSearchNode.h"
+
+using namespace std;
+
+const int MIN_SIZE = 256;
+const int MAX_SIZE = 16384;
+
+static double Seconds(chrono::steady_clock::time_point start) {
+	return chrono::duration<double>(chrono::steady_clock::now() - start)
+			.count();
+}
+
+static bool Write(int kind, int size, int queries, const char *mapFile,
+		const char *queryFile, unsigned int seed) {
+	chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+	vector<int> data;
+	vector<MapSearchNode> starts, goals;
+	MapGenerator::Generate(kind, size, seed, data);
+	MapGenerator::GenerateQueries(size, data, queries, seed + 1, starts,
+			goals);
+
+	if (!MapGenerator::Save(mapFile, size, size, data)) {
+		printf("Cannot write %s\n", mapFile);
+		return false;
+	}
+	if (!MapGenerator::SaveQueries(queryFile, starts, goals)) {
+		printf("Cannot write %s\n", queryFile);
+		return false;
+	}
+
+	printf("%-6s %5d x %-5d %d queries, %.2fs: %s %s\n",
+			MapGenerator::GetKindName(kind), size, size, (int) starts.size(),
+			Seconds(t0), mapFile, queryFile);
+	return true;
+}
+
+int main(int argc, char **argv) {
+	if (argc >= 4 && strcmp(argv[1], "all") == 0) {
+		int queries = atoi(argv[2]);
+		unsigned int seed = argc > 4 ? atoi(argv[4]) : 1;
+
+		for (int size = MIN_SIZE; size <= MAX_SIZE; size *= 2) {
+			for (int kind = 0; kind < MapGenerator::MAP_KINDS; kind++) {
+				string name = string(argv[3]) + "/"
+						+ MapGenerator::GetKindName(kind) + "_"
+						+ to_string(size);
+				if (!Write(kind, size, queries, (name + ".map").c_str(),
+						(name + ".queries").c_str(), seed)) {
+					return 1;
+				}
+			}
+		}
+		return 0;
+	}
+
+	if (argc < 6) {
+		printf("Usage: %s <maze | rooms | random | open> <size> <queries> "
+				"<map file> <query file> [<seed>]\n", argv[0]);
+		printf("       %s all <queries> <directory> [<seed>]\n", argv[0]);
+		return 1;
+	}
+
+	int kind = MapGenerator::GetKind(argv[1]);
+	int size = atoi(argv[2]);
+	if (kind < 0 || size <= 0) {
+		printf("Unknown map kind %s or bad size %s\n", argv[1], argv[2]);
+		return 1;
+	}
+
+	unsigned int seed = argc > 6 ? atoi(argv[6]) : 1;
+	return Write(kind, size, atoi(argv[3]), argv[4], argv[5], seed) ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+/*
+ * trace_replay.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *      Author: gdp24
+ */
+
+// Reads a search trace written by SearchTraceRecorder.
+//
+// Usage: trace_replay <trace file>
+//        trace_replay <trace file> dump <search>
+//        trace_replay <trace file> render <search> <image file>
+//
+// Without a command it prints one line of statistics per search and totals.
+// dump prints every step of one search, counted from 0. render writes the
+// expansion order of one search as a binary PGM image, a pixel per cell:
+// black cells were never expanded, the first expansion is white and later
+// ones darker, the start and goal are marked in mid grey.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "../AStarSearch.h"
+#include "../SearchTrace.h"
+
+using namespace std;
+
+static const char *StateName(unsigned int state) {
+	switch (state) {
+	case AStarSearch::SEARCH_STATE_SUCCEEDED:
+		return "succeeded";
+	case AStarSearch::SEARCH_STATE_FAILED:
+		return "failed";
+	case AStarSearch::SEARCH_STATE_OUT_OF_MEMORY:
+		return "out of memory";
+	default:
+		return "unfinished";
+	}
+}
+
+// Statistics of one search, gathered as its records go by
+struct SearchStats {
+	SearchTraceReader::Record start;
+	long expansions;
+	long successors;
+	long reexpansions;
+	unsigned int maxOpen;
+	bool ended;
+	unsigned int state;
+	float cost;
+	vector<unsigned char> expanded;
+};
+
+static void StartStats(SearchStats &stats,
+		const SearchTraceReader::Record &record) {
+	stats.start = record;
+	stats.expansions = stats.successors = stats.reexpansions = 0;
+	stats.maxOpen = 0;
+	stats.ended = false;
+	stats.state = AStarSearch::SEARCH_STATE_SEARCHING;
+	stats.cost = FLT_MAX;
+	stats.expanded.assign(record.width * record.height, 0);
+}
+
+static void AddStep(SearchStats &stats,
+		const SearchTraceReader::Record &record) {
+	stats.expansions++;
+	for (unsigned int bits = record.successors; bits; bits &= bits - 1) {
+		stats.successors++;
+	}
+	stats.maxOpen = max(stats.maxOpen, record.openSize);
+
+	unsigned int cell = record.node.y * stats.start.width + record.node.x;
+	if (cell < stats.expanded.size()) {
+		stats.reexpansions += stats.expanded[cell];
+		stats.expanded[cell] = 1;
+	}
+}
+
+static void PrintStats(int index, const SearchStats &stats) {
+	printf("%6d (%d,%d)->(%d,%d) %-13s cost %10.2f expansions %8ld "
+			"reexpanded %6ld branching %.2f max open %u\n", index,
+			stats.start.start.x, stats.start.start.y, stats.start.goal.x,
+			stats.start.goal.y, StateName(stats.state),
+			stats.cost == FLT_MAX ? -1.0f : stats.cost, stats.expansions,
+			stats.reexpansions,
+			stats.expansions ?
+					(double) stats.successors / stats.expansions : 0.0,
+			stats.maxOpen);
+}
+
+static int Statistics(SearchTraceReader &reader) {
+	SearchTraceReader::Record record;
+	SearchStats stats;
+	int searches = 0;
+	long expansions = 0;
+	long longest = 0;
+	int longestIndex = -1;
+	bool open = false;
+
+	while (reader.Next(record)) {
+		if (record.type == SearchTraceReader::RECORD_START) {
+			if (open) {
+				PrintStats(searches - 1, stats);
+			}
+			StartStats(stats, record);
+			searches++;
+			open = true;
+		} else if (!open) {
+			printf("Record outside a search\n");
+			return 1;
+		} else if (record.type == SearchTraceReader::RECORD_EXPANSION) {
+			AddStep(stats, record);
+			expansions++;
+			if (stats.expansions > longest) {
+				longest = stats.expansions;
+				longestIndex = searches - 1;
+			}
+		} else {
+			stats.ended = true;
+			stats.state = record.state;
+			stats.cost = record.cost;
+		}
+	}
+	if (open) {
+		PrintStats(searches - 1, stats);
+	}
+
+	printf("%d searches, %ld expansions, %.1f a search, longest %ld "
+			"(search %d)\n", searches, expansions,
+			searches ? (double) expansions / searches : 0.0, longest,
+			longestIndex);
+
+	if (!reader.IsValid()) {
+		printf("Trace is truncated or malformed\n");
+		return 1;
+	}
+	return 0;
+}
+
+// Skips to the start record of the given search. Returns false if there are
+// fewer searches
+static bool FindSearch(SearchTraceReader &reader, int search,
+		SearchTraceReader::Record &start) {
+	int index = -1;
+	while (reader.Next(start)) {
+		if (start.type == SearchTraceReader::RECORD_START && ++index == search) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static int Dump(SearchTraceReader &reader, int search) {
+	SearchTraceReader::Record record;
+	if (!FindSearch(reader, search, record)) {
+		printf("No search %d in the trace\n", search);
+		return 1;
+	}
+
+	printf("%dx%d map, (%d,%d) to (%d,%d)\n", record.width, record.height,
+			record.start.x, record.start.y, record.goal.x, record.goal.y);
+
+	long step = 0;
+	while (reader.Next(record)
+			&& record.type != SearchTraceReader::RECORD_START) {
+		if (record.type == SearchTraceReader::RECORD_END) {
+			printf("%s, cost %.2f after %u steps\n", StateName(record.state),
+					record.cost == FLT_MAX ? -1.0f : record.cost, record.steps);
+			break;
+		}
+
+		printf("%8ld (%d,%d) g %.2f h %.2f f %.2f open %u successors",
+				step++, record.node.x, record.node.y, record.g, record.h,
+				record.g + record.h, record.openSize);
+		for (int i = 0; i < 8; i++) {
+			if (record.successors & (1 << i)) {
+				MapSearchNode successor = SearchTraceReader::GetSuccessor(
+						record.node, i);
+				printf(" (%d,%d)", successor.x, successor.y);
+			}
+		}
+		printf("\n");
+	}
+	return 0;
+}
+
+static int Render(SearchTraceReader &reader, int search,
+		const char *fileName) {
+	SearchTraceReader::Record record;
+	if (!FindSearch(reader, search, record)) {
+		printf("No search %d in the trace\n", search);
+		return 1;
+	}
+
+	int width = record.width;
+	int height = record.height;
+	MapSearchNode start = record.start;
+	MapSearchNode goal = record.goal;
+
+	// Expansion number of each cell's first expansion, 0 for none
+	vector<long> order(width * height, 0);
+	long steps = 0;
+	while (reader.Next(record)
+			&& record.type == SearchTraceReader::RECORD_EXPANSION) {
+		steps++;
+		if (record.node.x < width && record.node.y < height) {
+			long &cell = order[record.node.y * width + record.node.x];
+			if (cell == 0) {
+				cell = steps;
+			}
+		}
+	}
+
+	vector<unsigned char> pixels(width * height, 0);
+	for (unsigned int i = 0; i < pixels.size(); i++) {
+		if (order[i]) {
+			pixels[i] = 255 - (191 * (order[i] - 1)) / max(1L, steps);
+		}
+	}
+	if (start.x < width && start.y < height) {
+		pixels[start.y * width + start.x] = 128;
+	}
+	if (goal.x < width && goal.y < height) {
+		pixels[goal.y * width + goal.x] = 128;
+	}
+
+	FILE *file = fopen(fileName, "wb");
+	if (!file) {
+		printf("Cannot write %s\n", fileName);
+		return 1;
+	}
+	fprintf(file, "P5\n%d %d\n255\n", width, height);
+	bool ok = pixels.empty()
+			|| fwrite(&pixels[0], 1, pixels.size(), file) == pixels.size();
+	ok = (fclose(file) == 0) && ok;
+
+	printf("%ld expansions of a %dx%d map written to %s\n", steps, width,
+			height, fileName);
+	return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 2 || (argc > 2 && strcmp(argv[2], "dump") == 0 && argc < 4)
+			|| (argc > 2 && strcmp(argv[2], "render") == 0 && argc < 5)) {
+		printf("Usage: %s <trace file> [dump <search> | render <search> "
+				"<image file>]\n", argv[0]);
+		return 1;
+	}
+
+	SearchTraceReader reader;
+	if (!reader.Open(argv[1])) {
+		printf("Cannot read trace %s\n", argv[1]);
+		return 1;
+	}
+
+	if (argc == 2) {
+		return Statistics(reader);
+	}
+	if (strcmp(argv[2], "dump") == 0) {
+		return Dump(reader, atoi(argv[3]));
+	}
+	if (strcmp(argv[2], "render") == 0) {
+		return Render(reader, atoi(argv[3]), argv[4]);
+	}
+
+	printf("Unknown command %s\n", argv[2]);
+	return 1;
+}